@@ -259,3 +259,14 @@ def config_mem(options, system):
             mem_ctrls[i].port = xbar.mem_side_ports
 
     subsystem.mem_ctrls = mem_ctrls
+
+    # Optionally add a CXL memory expander as a separate range after the
+    # highest system memory address
+    opt_cxl_mem_size = getattr(options, "cxl_mem_size", None)
+    if opt_cxl_mem_size:
+        cxl_base = max(int(r.end) for r in system.mem_ranges)
+        cxl_range = m5.objects.AddrRange(cxl_base, size=opt_cxl_mem_size)
+        cxl_intf = ObjectList.mem_list.get(options.cxl_mem_type)
+        system.cxl_mem = m5.objects.CXLMemDevice(cxl_range, dram=cxl_intf)
+        system.cxl_mem.link.cpu_side_port = system.membus.mem_side_ports
+        system.mem_ranges.append(cxl_range)
@@ -131,6 +131,12 @@ def addNoISAOptions(parser):
                         help="Enable low-power states in DRAMInterface")
     parser.add_argument("--mem-channels-intlv", type=int, default=0,
                         help="Memory channels interleave")
+    parser.add_argument("--cxl-mem-size", type=str, default=None,
+                        help="Size of a CXL Type-3 memory expander placed "
+                        "after the system memory")
+    parser.add_argument("--cxl-mem-type", default="DDR4_2400_16x4",
+                        choices=ObjectList.mem_list.get_names(),
+                        help="type of memory behind the CXL link")
 
     parser.add_argument("--memchecker", action="store_true")
 
@@ -0,0 +1,226 @@
+# Copyright (c) 2025
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script calibrates the AnalyticMemory model against a detailed
+# MemCtrl and DRAMInterface run of the same traffic. Run it first with
+# --model=detailed, which stores the measured read latency, row hit rate
+# and bus utilization in a calibration file, and then with
+# --model=analytic, which derives the analytic model from the timing of
+# the same memory type, reports its error and host speedup relative to
+# the detailed run, and refines the queueing scale stored in the file
+# for the next analytic run.
+
+import argparse
+import json
+import os
+import time
+
+import m5
+from m5.objects import *
+from m5.ticks import fromSeconds
+from m5.util import addToPath, fatal
+from m5.util.convert import anyToLatency
+
+addToPath('../')
+
+from common import ObjectList
+from common import MemConfig
+
+parser = argparse.ArgumentParser()
+
+parser.add_argument("--model", default="detailed",
+                    choices=["detailed", "analytic"],
+                    help = "Memory model to simulate")
+
+parser.add_argument("--calibration-file", default="analytic_calibration.json",
+                    help = "File the detailed run stores its results in, "
+                    "relative to the output directory of the detailed run")
+
+parser.add_argument("--reference", default=None,
+                    help = "Calibration file of a detailed run, used by "
+                    "the analytic model")
+
+parser.add_argument("--mem-type", default="DDR4_2400_16x4",
+                    choices=ObjectList.mem_list.get_names(),
+                    help = "type of memory to use")
+
+parser.add_argument("--rd_perc", type=int, default=70,
+                    help = "Percentage of read commands")
+
+parser.add_argument("--mode", default="RANDOM",
+                    choices=["RANDOM", "LINEAR"],
+                    help = "RANDOM: Uniform random addresses; \
+                          LINEAR: Sequential addresses")
+
+parser.add_argument("--itt", type=int, default=10000,
+                    help = "Inter-transaction time in ticks")
+
+parser.add_argument("--sim-time", type=str, default="1ms",
+                    help = "Simulated time to run for")
+
+args = parser.parse_args()
+
+if args.model == "analytic" and not args.reference:
+    fatal("The analytic model needs the --reference of a detailed run")
+
+system = System(membus = IOXBar(width = 32))
+system.clk_domain = SrcClockDomain(clock = '2.0GHz',
+                                   voltage_domain =
+                                   VoltageDomain(voltage = '1V'))
+
+mem_range = AddrRange('1GB')
+system.mem_ranges = [mem_range]
+
+system.mmap_using_noreserve = True
+
+intf = ObjectList.mem_list.get(args.mem_type)()
+burst_size = int((intf.devices_per_rank.value *
+                  intf.device_bus_width.value *
+                  intf.burst_length.value) / 8)
+
+def ns(latency):
+    return latency.value * 1e9
+
+if args.model == "detailed":
+    args.mem_channels = 1
+    args.mem_ranks = None
+    args.external_memory_system = 0
+    args.tlm_memory = 0
+    args.elastic_trace_en = 0
+    MemConfig.config_mem(args, system)
+    system.mem_ctrls[0].dram.null = True
+else:
+    with open(args.reference) as f:
+        reference = json.load(f)
+
+    # everything but the queueing scale follows from the timing of the
+    # memory type and the default controller latencies
+    system.mem_ctrls = AnalyticMemory(range = mem_range, null = True)
+    mem = system.mem_ctrls
+    mem.row_hit_latency = '%.3fns' % (ns(intf.tCL) + ns(intf.tBURST))
+    mem.row_miss_latency = '%.3fns' % (ns(intf.tRP) + ns(intf.tRCD))
+    mem.burst_size = burst_size
+    mem.burst_time = '%.3fns' % ns(intf.tBURST)
+    mem.row_buffer_size = (intf.device_rowbuffer_size.value *
+                           intf.devices_per_rank.value)
+    mem.num_banks = (intf.banks_per_rank.value *
+                     intf.ranks_per_channel.value)
+
+    if "queue_scale" in reference:
+        mem.queue_scale = reference["queue_scale"]
+    else:
+        # first guess: all of the latency the unloaded model does not
+        # explain is queueing at the measured utilization
+        hit_rate = reference["row_hit_rate"]
+        unloaded = (ns(mem.frontend_latency) + ns(mem.backend_latency) +
+                    ns(intf.tCL) + ns(intf.tBURST) +
+                    (1 - hit_rate) * (ns(intf.tRP) + ns(intf.tRCD)))
+        util = min(reference["utilization"], 0.95)
+        queueing = util * ns(intf.tBURST) / (2 * (1 - util))
+        mem.queue_scale = max(reference["latency"] - unloaded, 0) / \
+            queueing if queueing > 0 else 1.0
+
+    system.mem_ctrls.port = system.membus.mem_side_ports
+
+# measure the latency as the requestor sees it, whatever the model
+system.tgen = PyTrafficGen()
+system.monitor = CommMonitor()
+system.tgen.port = system.monitor.cpu_side_port
+system.monitor.mem_side_port = system.membus.cpu_side_ports
+system.system_port = system.membus.cpu_side_ports
+
+root = Root(full_system = False, system = system)
+root.system.mem_mode = 'timing'
+
+m5.instantiate()
+
+duration = fromSeconds(anyToLatency(args.sim_time))
+
+def trace():
+    generator = system.tgen.createRandom if args.mode == "RANDOM" else \
+        system.tgen.createLinear
+    yield generator(duration, 0, mem_range.end, burst_size, args.itt,
+                    args.itt, args.rd_perc, 0)
+    yield system.tgen.createExit(0)
+
+system.tgen.start(trace())
+
+start = time.time()
+exit_event = m5.simulate()
+host_seconds = time.time() - start
+
+print("Exited @ tick %d because %s" % (m5.curTick(), exit_event.getCause()))
+
+m5.stats.dump()
+
+def read_stats(names):
+    values = {}
+    with open(os.path.join(m5.options.outdir, "stats.txt")) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) > 1 and fields[0] in names:
+                values[fields[0]] = float(fields[1])
+    return values
+
+latency_stat = "system.monitor.readLatencyHist::mean"
+
+if args.model == "detailed":
+    hit_stat = "system.mem_ctrls.dram.readRowHitRate"
+    util_stat = "system.mem_ctrls.dram.busUtil"
+    stats = read_stats([latency_stat, hit_stat, util_stat])
+    result = {
+        "latency": stats[latency_stat] / 1000,
+        "row_hit_rate": stats[hit_stat] / 100,
+        "utilization": stats[util_stat] / 100,
+        "host_seconds": host_seconds,
+    }
+    path = os.path.join(m5.options.outdir, args.calibration_file)
+    with open(path, "w") as f:
+        json.dump(result, f, indent=4)
+    print("Detailed read latency %.2f ns in %.2f host seconds, calibration "
+          "stored in %s" % (result["latency"], host_seconds, path))
+else:
+    queue_lat_stat = "system.mem_ctrls.avgQueueLat"
+    stats = read_stats([latency_stat, queue_lat_stat])
+    latency = stats[latency_stat] / 1000
+    error = (latency - reference["latency"]) / reference["latency"]
+    print("Analytic read latency %.2f ns, detailed %.2f ns, calibration "
+          "error %.2f%%" % (latency, reference["latency"], error * 100))
+    print("Host speedup %.2fx (%.2f vs %.2f host seconds)" %
+          (reference["host_seconds"] / host_seconds,
+           host_seconds, reference["host_seconds"]))
+
+    # attribute the remaining error to the queueing estimate and store
+    # the refined scale for the next run
+    queue_lat = stats.get(queue_lat_stat, 0) / 1000
+    if queue_lat > 0:
+        wanted = max(queue_lat + reference["latency"] - latency, 0)
+        reference["queue_scale"] = float(mem.queue_scale) * wanted / \
+            queue_lat
+        with open(args.reference, "w") as f:
+            json.dump(reference, f, indent=4)
+        print("Refined queue_scale %.3f stored in %s" %
+              (reference["queue_scale"], args.reference))
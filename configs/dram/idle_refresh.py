@@ -0,0 +1,152 @@
+# Copyright (c) 2025
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script checks that skipping the refresh events of idle DRAM
+# ranks (bulk_idle_refresh) leaves the power and energy stats of the
+# ranks unchanged. Two identical channels, one skipping the refresh
+# events and one running them, are driven by identical traffic made of
+# short bursts separated by long idle periods. The power state times
+# and energies of every rank are compared at the end.
+
+import argparse
+
+import m5
+from m5.objects import *
+from m5.util import addToPath, fatal
+
+addToPath('../')
+
+from common import ObjectList
+
+parser = argparse.ArgumentParser()
+
+parser.add_argument("--mem-type", default="DDR4_2400_16x4",
+                    choices=ObjectList.mem_list.get_names(),
+                    help = "type of memory to use")
+
+parser.add_argument("--mem-ranks", "-r", type=int, default=2,
+                    help = "Number of ranks of each channel")
+
+parser.add_argument("--phases", type=int, default=20,
+                    help = "Number of busy and idle phases")
+
+parser.add_argument("--busy-time", type=str, default="2us",
+                    help = "Duration of a burst of traffic")
+
+parser.add_argument("--idle-time", type=str, default="200us",
+                    help = "Duration of an idle period")
+
+args = parser.parse_args()
+
+system = System(membus = IOXBar(width = 32))
+system.clk_domain = SrcClockDomain(clock = '2.0GHz',
+                                   voltage_domain =
+                                   VoltageDomain(voltage = '1V'))
+
+# One channel per setting, each with its own range
+range_size = 256 * 1024 * 1024
+system.mem_ranges = [AddrRange(i * range_size, size = range_size)
+                     for i in range(2)]
+system.mmap_using_noreserve = True
+
+mem_cls = ObjectList.mem_list.get(args.mem_type)
+ctrls = []
+for mem_range, bulk in zip(system.mem_ranges, (True, False)):
+    ctrl = MemCtrl(dram = mem_cls(range = mem_range,
+                                  ranks_per_channel = args.mem_ranks,
+                                  bulk_idle_refresh = bulk,
+                                  null = True))
+    ctrl.port = system.membus.mem_side_ports
+    ctrls.append(ctrl)
+system.mem_ctrls = ctrls
+
+if not isinstance(ctrls[0].dram, m5.objects.DRAMInterface):
+    fatal("This script assumes the memory is a DRAMInterface subclass")
+
+system.tgens = [PyTrafficGen() for _ in ctrls]
+for tgen in system.tgens:
+    tgen.port = system.membus.cpu_side_ports
+
+system.system_port = system.membus.cpu_side_ports
+
+root = Root(full_system = False, system = system)
+root.system.mem_mode = 'timing'
+
+m5.instantiate()
+
+busy_time = int(m5.ticks.fromSeconds(
+    m5.util.convert.anyToLatency(args.busy_time)))
+idle_time = int(m5.ticks.fromSeconds(
+    m5.util.convert.anyToLatency(args.idle_time)))
+period = int(m5.ticks.fromSeconds(
+    ctrls[0].dram.tBURST.value)) * 4
+
+def traffic(tgen, mem_range, last):
+    # Linear traffic with a fixed period and only reads or only writes
+    # is deterministic, so both channels see the same requests
+    for phase in range(args.phases):
+        yield tgen.createLinear(busy_time, int(mem_range.start),
+                                int(mem_range.end), 64, period, period,
+                                100 if phase % 2 else 0, 0)
+        yield tgen.createIdle(idle_time)
+    yield last(tgen)
+
+system.tgens[0].start(traffic(system.tgens[0], system.mem_ranges[0],
+                              lambda t: t.createExit(0)))
+system.tgens[1].start(traffic(system.tgens[1], system.mem_ranges[1],
+                              lambda t: t.createIdle(idle_time)))
+
+# Reset the stats half way, in the middle of an idle period, to also
+# cover the replay on a stats reset
+m5.simulate(args.phases // 2 * (busy_time + idle_time) + idle_time // 2)
+m5.stats.reset()
+m5.simulate()
+m5.stats.dump()
+
+def rank_stats(ctrl):
+    values = {}
+    for name, group in ctrl.dram.getStatGroups().items():
+        if not name.startswith("rank"):
+            continue
+        for stat in group.getStats():
+            if stat.name == "pwrStateTime":
+                for i, v in enumerate(stat.value):
+                    values["%s.%s::%d" % (name, stat.name, i)] = v
+            elif stat.name.endswith("Energy"):
+                values["%s.%s" % (name, stat.name)] = stat.value
+    return values
+
+bulk, events = [rank_stats(c) for c in ctrls]
+mismatches = [name for name in events
+              if abs(bulk[name] - events[name]) >
+                 1e-9 * max(abs(events[name]), 1)]
+for name in mismatches:
+    print("%s: %s with bulk idle refresh, %s without" %
+          (name, bulk[name], events[name]))
+if mismatches:
+    fatal("Rank stats differ with bulk idle refresh")
+
+print("Rank power and energy stats match with bulk idle refresh")
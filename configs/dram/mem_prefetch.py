@@ -0,0 +1,141 @@
+# Copyright (c) 2025
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script exercises the memory-side prefetcher of the controller.
+# A single channel with a next-line prefetcher is driven by sparse
+# linear reads, some of them split over two bursts, which should be
+# served by the prefetch buffer, by linear mixed reads and writes,
+# where the writes invalidate buffered bursts, and by random reads,
+# where the prefetched bursts are replaced unused after opening a row.
+# The prefetch stats of the controller are checked at the end.
+
+import argparse
+
+import m5
+from m5.objects import *
+from m5.util import addToPath, fatal
+
+addToPath('../')
+
+from common import ObjectList
+
+parser = argparse.ArgumentParser()
+
+parser.add_argument("--mem-type", default="DDR4_2400_16x4",
+                    choices=ObjectList.mem_list.get_names(),
+                    help = "type of memory to use")
+
+parser.add_argument("--phase-time", type=str, default="20us",
+                    help = "Duration of each traffic pattern")
+
+args = parser.parse_args()
+
+system = System(membus = IOXBar(width = 32))
+system.clk_domain = SrcClockDomain(clock = '2.0GHz',
+                                   voltage_domain =
+                                   VoltageDomain(voltage = '1V'))
+
+system.mem_ranges = [AddrRange('256MB')]
+system.mmap_using_noreserve = True
+
+# Close the row after every access so that each prefetch opens a row,
+# the activations of the prefetches never used are then wasted
+mem_cls = ObjectList.mem_list.get(args.mem_type)
+system.mem_ctrl = MemCtrl(dram = mem_cls(range = system.mem_ranges[0],
+                                         page_policy = 'close',
+                                         null = True),
+                          mem_prefetch_policy = 'next_line')
+system.mem_ctrl.port = system.membus.mem_side_ports
+
+if not isinstance(system.mem_ctrl.dram, m5.objects.DRAMInterface):
+    fatal("This script assumes the memory is a DRAMInterface subclass")
+
+system.tgen = PyTrafficGen()
+system.tgen.port = system.membus.cpu_side_ports
+
+system.system_port = system.membus.cpu_side_ports
+
+root = Root(full_system = False, system = system)
+root.system.mem_mode = 'timing'
+
+m5.instantiate()
+
+phase_time = int(m5.ticks.fromSeconds(
+    m5.util.convert.anyToLatency(args.phase_time)))
+burst_size = system.mem_ctrl.dram.burst_length.value * \
+             system.mem_ctrl.dram.device_bus_width.value * \
+             system.mem_ctrl.dram.devices_per_rank.value // 8
+# Leave the controller idle between requests so that the prefetcher
+# gets the read slots it needs
+period = int(m5.ticks.fromSeconds(
+    system.mem_ctrl.dram.tBURST.value)) * 16
+start = int(system.mem_ranges[0].start)
+end = int(system.mem_ranges[0].end)
+
+def traffic(tgen):
+    # sparse linear reads of one and two bursts
+    yield tgen.createLinear(phase_time, start, end, burst_size,
+                            period, period, 100, 0)
+    yield tgen.createLinear(phase_time, start, end, 2 * burst_size,
+                            period, period, 100, 0)
+    # a mix of reads and writes over the same lines
+    yield tgen.createLinear(phase_time, start, end, burst_size,
+                            period, period, 50, 0)
+    # reads that never use the next line
+    yield tgen.createRandom(phase_time, start, end, burst_size,
+                            period, period, 100, 0)
+    yield tgen.createExit(0)
+
+system.tgen.start(traffic(system.tgen))
+
+m5.simulate()
+m5.stats.dump()
+
+def stat(name):
+    return system.mem_ctrl.resolveStat(name).value
+
+issued = stat("pfIssued")
+hits = stat("servicedByPfBuf")
+unused = stat("pfUnused")
+invalidated = stat("pfInvalidated")
+activations = stat("pfActivations")
+wasted = stat("pfWastedActivations")
+
+print("Prefetches issued %d, used %d, unused %d, invalidated %d, "
+      "activations %d, wasted activations %d" %
+      (issued, hits, unused, invalidated, activations, wasted))
+
+if hits == 0:
+    fatal("No read was served by the prefetch buffer")
+if invalidated == 0:
+    fatal("No prefetched burst was invalidated by a write")
+if wasted == 0:
+    fatal("No prefetch activation was accounted as wasted")
+if hits + unused > issued or invalidated > unused or \
+   wasted > min(unused, activations):
+    fatal("Inconsistent prefetch stats")
+
+print("Memory-side prefetch stats are consistent")
@@ -0,0 +1,139 @@
+# Copyright (c) 2025
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script drives a single memory channel with saturating random
+# traffic, so that the controller queues stay full and the host time is
+# dominated by the request scheduler. It reports how long the host took
+# to simulate the requested time, which makes it a simple benchmark for
+# changes to the scheduling code in MemCtrl and the memory interfaces.
+
+import argparse
+import time
+
+import m5
+from m5.objects import *
+from m5.ticks import fromSeconds
+from m5.util import addToPath, fatal
+from m5.util.convert import anyToLatency
+
+addToPath('../')
+
+from common import ObjectList
+from common import MemConfig
+
+parser = argparse.ArgumentParser()
+
+parser.add_argument("--mem-type", default="DDR4_2400_16x4",
+                    choices=ObjectList.mem_list.get_names(),
+                    help = "type of memory to use")
+
+parser.add_argument("--mem-ranks", "-r", type=int, default=2,
+                    help = "Number of ranks of the channel")
+
+parser.add_argument("--mem-sched", default="frfcfs",
+                    choices=["fcfs", "frfcfs"],
+                    help = "Memory controller scheduling policy")
+
+parser.add_argument("--read-buffer-size", type=int, default=64,
+                    help = "Number of read queue entries")
+
+parser.add_argument("--write-buffer-size", type=int, default=128,
+                    help = "Number of write queue entries")
+
+parser.add_argument("--rd_perc", type=int, default=70,
+                    help = "Percentage of read commands")
+
+parser.add_argument("--mode", default="RANDOM",
+                    choices=["RANDOM", "LINEAR"],
+                    help = "RANDOM: Uniform random addresses; \
+                          LINEAR: Sequential addresses")
+
+parser.add_argument("--sim-time", type=str, default="10ms",
+                    help = "Simulated time to run for")
+
+args = parser.parse_args()
+
+system = System(membus = IOXBar(width = 32))
+system.clk_domain = SrcClockDomain(clock = '2.0GHz',
+                                   voltage_domain =
+                                   VoltageDomain(voltage = '1V'))
+
+mem_range = AddrRange('1GB')
+system.mem_ranges = [mem_range]
+
+system.mmap_using_noreserve = True
+
+# a single channel, so that one controller sees all the traffic
+args.mem_channels = 1
+args.external_memory_system = 0
+args.tlm_memory = 0
+args.elastic_trace_en = 0
+MemConfig.config_mem(args, system)
+
+ctrl = system.mem_ctrls[0]
+if not isinstance(ctrl, m5.objects.MemCtrl):
+    fatal("This script assumes the controller is a MemCtrl subclass")
+
+# there is no point slowing things down by saving any data
+ctrl.dram.null = True
+ctrl.mem_sched_policy = args.mem_sched
+ctrl.dram.read_buffer_size = args.read_buffer_size
+ctrl.dram.write_buffer_size = args.write_buffer_size
+
+burst_size = int((ctrl.dram.devices_per_rank.value *
+                  ctrl.dram.device_bus_width.value *
+                  ctrl.dram.burst_length.value) / 8)
+
+system.tgen = PyTrafficGen()
+system.tgen.port = system.membus.cpu_side_ports
+system.system_port = system.membus.cpu_side_ports
+
+root = Root(full_system = False, system = system)
+root.system.mem_mode = 'timing'
+
+m5.instantiate()
+
+duration = fromSeconds(anyToLatency(args.sim_time))
+
+def trace():
+    generator = system.tgen.createRandom if args.mode == "RANDOM" else \
+        system.tgen.createLinear
+    # issue as fast as the port accepts requests to keep the queues full
+    yield generator(duration, 0, mem_range.end, burst_size, 0, 0,
+                    args.rd_perc, 0)
+    yield system.tgen.createExit(0)
+
+system.tgen.start(trace())
+
+start = time.time()
+exit_event = m5.simulate()
+host_seconds = time.time() - start
+
+print("Exited @ tick %d because %s" % (m5.curTick(), exit_event.getCause()))
+print("Simulated %s of %s traffic with %s scheduling in %.2f host seconds "
+      "(%.2f host seconds per simulated ms)" %
+      (args.sim_time, args.mode, args.mem_sched, host_seconds,
+       host_seconds / (m5.curTick() / 1e9)))
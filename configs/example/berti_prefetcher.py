@@ -0,0 +1,123 @@
+# Copyright (c) 2025
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+""" Single core SE-mode system with a Berti prefetcher in the L1D.
+
+The L1 data cache uses the Berti local-delta prefetcher, and the L2 an
+optional stride prefetcher. The Berti statistics, e.g.,
+system.cpu.dcache.prefetcher.deltaCoverage and
+system.cpu.dcache.prefetcher.demandFillLatency, report how much of the
+misses the selected deltas cover and how long the fills take.
+
+Berti can also be attached to the caches of se.py and fs.py with
+--l1d-hwp-type=BertiPrefetcher.
+"""
+
+import argparse
+import os
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser(description=__doc__)
+parser.add_argument("binary", nargs='?',
+    default=os.path.join(os.path.dirname(os.path.realpath(__file__)),
+        '../../tests/test-progs/hello/bin/',
+        str(m5.defines.buildEnv['TARGET_ISA']).lower(), 'linux/hello'),
+    help="Binary to execute")
+parser.add_argument("--cpu-type", default="TimingSimpleCPU",
+    choices=["TimingSimpleCPU", "DerivO3CPU"], help="CPU model to use")
+parser.add_argument("--high-coverage", type=int, default=65,
+    help="Coverage (percent) of the deltas prefetched with high confidence")
+parser.add_argument("--low-coverage", type=int, default=35,
+    help="Coverage (percent) of the deltas prefetched with low confidence")
+parser.add_argument("--l2-stride", action="store_true",
+    help="Add a stride prefetcher to the L2")
+parser.add_argument("--throttle", action="store_true",
+    help="Enable feedback-directed throttling of the prefetchers")
+
+args = parser.parse_args()
+
+system = System()
+system.clk_domain = SrcClockDomain(clock='3GHz',
+                                   voltage_domain=VoltageDomain())
+system.mem_mode = 'timing'
+system.mem_ranges = [AddrRange('512MB')]
+
+system.cpu = getattr(m5.objects, args.cpu_type)()
+
+system.cpu.icache = Cache(size='32kB', assoc=8, tag_latency=1,
+    data_latency=1, response_latency=1, mshrs=8, tgts_per_mshr=16)
+system.cpu.dcache = Cache(size='48kB', assoc=12, tag_latency=2,
+    data_latency=2, response_latency=2, mshrs=16, tgts_per_mshr=16)
+system.cpu.dcache.prefetcher = BertiPrefetcher(
+    high_coverage_threshold=args.high_coverage,
+    low_coverage_threshold=args.low_coverage,
+    throttle_enable=args.throttle)
+
+system.cpu.icache_port = system.cpu.icache.cpu_side
+system.cpu.dcache_port = system.cpu.dcache.cpu_side
+
+system.l2bus = L2XBar()
+system.cpu.icache.mem_side = system.l2bus.cpu_side_ports
+system.cpu.dcache.mem_side = system.l2bus.cpu_side_ports
+
+system.l2cache = Cache(size='1MB', assoc=16, tag_latency=10,
+    data_latency=10, response_latency=10, mshrs=32, tgts_per_mshr=16)
+if args.l2_stride:
+    system.l2cache.prefetcher = StridePrefetcher(
+        throttle_enable=args.throttle)
+system.l2cache.cpu_side = system.l2bus.mem_side_ports
+
+system.membus = SystemXBar()
+system.l2cache.mem_side = system.membus.cpu_side_ports
+
+system.cpu.createInterruptController()
+if m5.defines.buildEnv['TARGET_ISA'] == "x86":
+    system.cpu.interrupts[0].pio = system.membus.mem_side_ports
+    system.cpu.interrupts[0].int_requestor = system.membus.cpu_side_ports
+    system.cpu.interrupts[0].int_responder = system.membus.mem_side_ports
+
+system.system_port = system.membus.cpu_side_ports
+
+system.mem_ctrl = MemCtrl()
+system.mem_ctrl.dram = DDR4_2400_8x8()
+system.mem_ctrl.dram.range = system.mem_ranges[0]
+system.mem_ctrl.port = system.membus.mem_side_ports
+
+system.workload = SEWorkload.init_compatible(args.binary)
+
+process = Process()
+process.cmd = [args.binary]
+system.cpu.workload = process
+system.cpu.createThreads()
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+print("Beginning simulation!")
+exit_event = m5.simulate()
+print('Exiting @ tick %i because %s' % (m5.curTick(), exit_event.getCause()))
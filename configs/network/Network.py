@@ -42,8 +42,10 @@ def define_options(parser):
         help="the number of rows in the mesh topology")
     parser.add_argument(
         "--network", default="simple",
-        choices=['simple', 'garnet'],
-        help="""'simple'|'garnet' (garnet2.0 will be deprecated.)""")
+        choices=['simple', 'garnet', 'analytical'],
+        help="""'simple'|'garnet'|'analytical' (garnet2.0 will be
+            deprecated.) The analytical network computes message latencies
+            from the topology instead of simulating routers.""")
     parser.add_argument(
         "--router-latency", action="store", type=int,
         default=1,
@@ -80,6 +82,14 @@ def define_options(parser):
         "--garnet-deadlock-threshold", action="store",
         type=int, default=50000,
         help="network-level deadlock threshold.")
+    parser.add_argument(
+        "--garnet-switch-allocator", action="store", default="separable",
+        choices=['separable', 'wavefront', 'islip'],
+        help="switch allocator of the garnet routers.")
+    parser.add_argument(
+        "--garnet-switch-allocator-iterations", action="store",
+        type=int, default=1,
+        help="number of iterations of the islip switch allocator.")
     parser.add_argument("--simple-physical-channels", action="store_true",
         default=False,
         help="""SimpleNetwork links uses a separate physical
@@ -103,6 +113,13 @@ def create_network(options, ruby):
         RouterClass = GarnetRouter
         InterfaceClass = GarnetNetworkInterface
 
+    elif options.network == "analytical":
+        NetworkClass = AnalyticalNetwork
+        IntLinkClass = BasicIntLink
+        ExtLinkClass = BasicExtLink
+        RouterClass = BasicRouter
+        InterfaceClass = None
+
     else:
         NetworkClass = SimpleNetwork
         IntLinkClass = SimpleIntLink
@@ -125,6 +142,9 @@ def init_network(options, network, InterfaceClass):
         network.ni_flit_size = options.link_width_bits / 8
         network.routing_algorithm = options.routing_algorithm
         network.garnet_deadlock_threshold = options.garnet_deadlock_threshold
+        network.switch_allocator = options.garnet_switch_allocator
+        network.switch_allocator_iterations = \
+            options.garnet_switch_allocator_iterations
 
         # Create Bridges and connect them to the corresponding links
         for intLink in network.int_links:
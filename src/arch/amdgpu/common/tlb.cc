@@ -527,11 +527,13 @@ namespace X86ISA
                         } else {
                             Addr alignedVaddr = p->pTable->pageAlign(vaddr);
 
+                            Addr alignedPaddr =
+                                pte->translate(alignedVaddr);
                             DPRINTF(GPUTLB, "Mapping %#x to %#x\n",
-                                    alignedVaddr, pte->paddr);
+                                    alignedVaddr, alignedPaddr);
 
                             TlbEntry gpuEntry(p->pid(), alignedVaddr,
-                                              pte->paddr, false, false);
+                                              alignedPaddr, false, false);
                             entry = insert(alignedVaddr, gpuEntry);
                         }
 
@@ -963,11 +965,12 @@ namespace X86ISA
             }
 
             if (pte) {
+                Addr alignedPaddr = pte->translate(alignedVaddr);
                 DPRINTF(GPUTLB, "Mapping %#x to %#x\n", alignedVaddr,
-                        pte->paddr);
+                        alignedPaddr);
 
                 sender_state->tlbEntry =
-                    new TlbEntry(p->pid(), virtPageAddr, pte->paddr, false,
+                    new TlbEntry(p->pid(), virtPageAddr, alignedPaddr, false,
                                  false);
             } else {
                 sender_state->tlbEntry = nullptr;
@@ -1173,11 +1176,12 @@ namespace X86ISA
                     assert(pte);
 
                     DPRINTF(GPUTLB, "Mapping %#x to %#x\n", alignedVaddr,
-                            pte->paddr);
+                            pte->translate(alignedVaddr));
 
                     sender_state->tlbEntry =
                         new TlbEntry(p->pid(), virt_page_addr,
-                                     pte->paddr, false, false);
+                                     pte->translate(alignedVaddr), false,
+                                     false);
                 } else {
                     // If this was a prefetch, then do the normal thing if it
                     // was a successful translation.  Otherwise, send an empty
@@ -1185,11 +1189,12 @@ namespace X86ISA
                     // and handled accordingly.
                     if (pte) {
                         DPRINTF(GPUTLB, "Mapping %#x to %#x\n", alignedVaddr,
-                                pte->paddr);
+                                pte->translate(alignedVaddr));
 
                         sender_state->tlbEntry =
                             new TlbEntry(p->pid(), virt_page_addr,
-                                         pte->paddr, false, false);
+                                         pte->translate(alignedVaddr), false,
+                                         false);
                     } else {
                         DPRINTF(GPUPrefetch, "Prefetch failed %#x\n",
                                 alignedVaddr);
@@ -662,7 +662,8 @@ FastInstructionAccessMMUMiss::invoke(ThreadContext *tc,
     // the logic works out to the following for the context.
     int context_id = (is_real_address || trapped) ? 0 : primary_context;
 
-    TlbEntry entry(p->pTable->pid(), alignedvaddr, pte->paddr,
+    TlbEntry entry(p->pTable->pid(), alignedvaddr,
+                   pte->translate(alignedvaddr),
                    pte->flags & EmulationPageTable::Uncacheable,
                    pte->flags & EmulationPageTable::ReadOnly);
 
@@ -750,7 +751,8 @@ FastDataAccessMMUMiss::invoke(ThreadContext *tc, const StaticInstPtr &inst)
     // The partition id distinguishes between virtualized environments.
     int const partition_id = 0;
 
-    TlbEntry entry(p->pTable->pid(), alignedvaddr, pte->paddr,
+    TlbEntry entry(p->pTable->pid(), alignedvaddr,
+                   pte->translate(alignedvaddr),
                    pte->flags & EmulationPageTable::Uncacheable,
                    pte->flags & EmulationPageTable::ReadOnly);
 
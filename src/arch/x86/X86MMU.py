@@ -35,6 +35,9 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+from m5.params import *
+from m5.proxy import *
+
 from m5.objects.BaseMMU import BaseMMU
 from m5.objects.X86TLB import X86TLB
 
@@ -42,8 +45,13 @@ class X86MMU(BaseMMU):
     type = 'X86MMU'
     cxx_class = 'gem5::X86ISA::MMU'
     cxx_header = 'arch/x86/mmu.hh'
-    itb = X86TLB(entry_type="instruction")
-    dtb = X86TLB(entry_type="data")
+
+    # Shared second level TLB, e.g. X86L2TLB(). Misses in the instruction
+    # and data TLBs go straight to the page table walkers without one.
+    l2_shared = Param.X86TLB(NULL, "Unified second level TLB")
+
+    itb = X86TLB(entry_type="instruction", next_level=Parent.l2_shared)
+    dtb = X86TLB(entry_type="data", next_level=Parent.l2_shared)
 
     @classmethod
     def walkerPorts(cls):
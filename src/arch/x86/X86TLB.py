@@ -49,6 +49,14 @@ class X86PagetableWalker(ClockedObject):
     num_squash_per_cycle = Param.Unsigned(4,
             "Number of outstanding walks that can be squashed per cycle")
 
+    # Paging-structure caches, which let a long mode walk skip the upper
+    # levels of the page table. A size of zero disables a cache.
+    pml4_cache_size = Param.Unsigned(0, "Number of PML4 entries cached")
+    pdp_cache_size = Param.Unsigned(0, "Number of PDP entries cached")
+    pd_cache_size = Param.Unsigned(0, "Number of PD entries cached")
+    paging_cache_latency = Param.Cycles(1,
+            "Latency of a paging-structure cache lookup")
+
 class X86TLB(BaseTLB):
     type = 'X86TLB'
     cxx_class = 'gem5::X86ISA::TLB'
@@ -58,3 +66,15 @@ class X86TLB(BaseTLB):
     system = Param.System(Parent.any, "system object")
     walker = Param.X86PagetableWalker(\
             X86PagetableWalker(), "page table walker")
+    lookup_latency = Param.Latency('0ns', "Time taken to look this TLB up "
+        "when it is the next level of another TLB")
+
+class X86L2TLB(X86TLB):
+    """
+    Unified second level TLB shared by the instruction and data TLBs. It
+    is only filled through them and has no walker of its own.
+    """
+    entry_type = 'unified'
+    size = 1536
+    lookup_latency = '3ns'
+    walker = NULL
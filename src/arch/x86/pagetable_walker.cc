@@ -70,13 +70,14 @@ namespace X86ISA {
 
 Fault
 Walker::start(ThreadContext * _tc, BaseMMU::Translation *_translation,
-              const RequestPtr &_req, BaseMMU::Mode _mode)
+              const RequestPtr &_req, BaseMMU::Mode _mode, Tick delay)
 {
     // TODO: in timing mode, instead of blocking when there are other
     // outstanding requests, see if this request can be coalesced with
     // another one (i.e. either coalesce or start walk)
     WalkerState * newState = new WalkerState(this, _translation, _req);
     newState->initState(_tc, _mode, sys->isTimingMode());
+    newState->startDelay = delay;
     if (currStates.size()) {
         assert(newState->isTiming());
         DPRINTF(PageTableWalker, "Walks in progress: %d\n", currStates.size());
@@ -169,6 +170,79 @@ bool Walker::sendTiming(WalkerState* sendingState, PacketPtr pkt)
 
 }
 
+void
+Walker::flushPagingCaches()
+{
+    pml4Cache.flush();
+    pdpCache.flush();
+    pdCache.flush();
+}
+
+const Walker::PagingCache::Entry *
+Walker::PagingCache::lookup(Addr vaddr)
+{
+    const Addr tag = tagOf(vaddr);
+    for (auto &entry : entries) {
+        if (entry.valid && entry.tag == tag) {
+            entry.lastUse = ++useSeq;
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void
+Walker::PagingCache::insert(Addr vaddr, const Entry &entry)
+{
+    if (!enabled())
+        return;
+
+    // Reuse the entry with the same tag if there is one, and otherwise a
+    // free entry or the least recently used one.
+    const Addr tag = tagOf(vaddr);
+    Entry *victim = &entries.front();
+    for (auto &candidate : entries) {
+        if (candidate.valid && candidate.tag == tag) {
+            victim = &candidate;
+            break;
+        }
+        if (!candidate.valid ||
+                (victim->valid && candidate.lastUse < victim->lastUse)) {
+            victim = &candidate;
+        }
+    }
+
+    *victim = entry;
+    victim->valid = true;
+    victim->tag = tag;
+    victim->lastUse = ++useSeq;
+}
+
+void
+Walker::PagingCache::flush()
+{
+    for (auto &entry : entries)
+        entry.valid = false;
+}
+
+Walker::WalkerStats::WalkerStats(statistics::Group *parent)
+  : statistics::Group(parent),
+    ADD_STAT(walks, statistics::units::Count::get(),
+             "Number of page table walks"),
+    ADD_STAT(walkReads, statistics::units::Count::get(),
+             "Number of page table entries read by walks"),
+    ADD_STAT(pml4CacheHits, statistics::units::Count::get(),
+             "Walks started at the PDP level from a PML4 cache hit"),
+    ADD_STAT(pdpCacheHits, statistics::units::Count::get(),
+             "Walks started at the PD level from a PDP cache hit"),
+    ADD_STAT(pdCacheHits, statistics::units::Count::get(),
+             "Walks started at the PTE level from a PD cache hit"),
+    ADD_STAT(readsPerWalk, statistics::units::Ratio::get(),
+             "Average number of page table entries read per walk")
+{
+    readsPerWalk = walkReads / walks;
+}
+
 Port &
 Walker::getPort(const std::string &if_name, PortID idx)
 {
@@ -226,18 +300,34 @@ Walker::startWalkWrapper()
         currState->startWalk();
 }
 
+void
+Walker::sendDelayedWalk()
+{
+    // Only one walk is in progress at a time, and it can't complete
+    // before its first access is sent.
+    assert(!currStates.empty() && currStates.front()->wasStarted());
+    currStates.front()->sendPackets();
+}
+
 Fault
 Walker::WalkerState::startWalk()
 {
     Fault fault = NoFault;
     assert(!started);
     started = true;
+    walker->stats.walks++;
     setupWalk(req->getVaddr());
     if (timing) {
         nextState = state;
         state = Waiting;
         timingFault = NoFault;
-        sendPackets();
+        // Lookups made before the first access hold it up.
+        if (startDelay) {
+            walker->schedule(walker->delayedWalkEvent,
+                             curTick() + startDelay);
+        } else {
+            sendPackets();
+        }
     } else {
         do {
             walker->port.sendAtomic(read);
@@ -312,6 +402,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
         }
         entry.noExec = pte.nx;
         nextState = LongPDP;
+        fillPagingCache(walker->pml4Cache, mbits(pte, 51, 12), uncacheable);
         break;
       case LongPDP:
         DPRINTF(PageTableWalker, "Got long mode PDP entry %#016x.\n", pte);
@@ -326,6 +417,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             break;
         }
         nextState = LongPD;
+        fillPagingCache(walker->pdpCache, mbits(pte, 51, 12), uncacheable);
         break;
       case LongPD:
         DPRINTF(PageTableWalker, "Got long mode PD entry %#016x.\n", pte);
@@ -343,6 +435,8 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             entry.logBytes = 12;
             nextRead = mbits(pte, 51, 12) + vaddr.longl1 * dataSize;
             nextState = LongPTE;
+            fillPagingCache(walker->pdCache, mbits(pte, 51, 12),
+                            uncacheable);
             break;
         } else {
             // 2 MB page
@@ -512,10 +606,12 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
         //If we didn't return, we're setting up another read.
         Request::Flags flags = oldRead->req->getFlags();
         flags.set(Request::UNCACHEABLE, uncacheable);
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = Request::create(
             nextRead, oldRead->getSize(), flags, walker->requestorId);
         read = new Packet(request, MemCmd::ReadReq);
         read->allocate();
+        if (!functional)
+            walker->stats.walkReads++;
         // If we need to write, adjust the read packet to write the modified
         // value back to memory.
         if (doWrite) {
@@ -550,11 +646,44 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     Efer efer = tc->readMiscRegNoEffect(misc_reg::Efer);
     dataSize = 8;
     Addr topAddr;
+    bool uncacheable = cr3.pcd;
     if (efer.lma) {
         // Do long mode.
         state = LongPML4;
         topAddr = (cr3.longPdtb << 12) + addr.longl4 * dataSize;
         enableNX = efer.nxe;
+
+        // Start below the levels the paging-structure caches cover.
+        // Functional walks leave the caches alone.
+        const PagingCache::Entry *hit = nullptr;
+        if (!functional) {
+            if ((hit = walker->pdCache.lookup(vaddr))) {
+                walker->stats.pdCacheHits++;
+                state = LongPTE;
+                entry.logBytes = 12;
+                topAddr = hit->table + addr.longl1 * dataSize;
+            } else if ((hit = walker->pdpCache.lookup(vaddr))) {
+                walker->stats.pdpCacheHits++;
+                state = LongPD;
+                topAddr = hit->table + addr.longl2 * dataSize;
+            } else if ((hit = walker->pml4Cache.lookup(vaddr))) {
+                walker->stats.pml4CacheHits++;
+                state = LongPDP;
+                topAddr = hit->table + addr.longl3 * dataSize;
+            }
+
+            if (walker->pml4Cache.enabled() || walker->pdpCache.enabled() ||
+                    walker->pdCache.enabled()) {
+                startDelay += walker->cyclesToTicks(
+                        walker->pagingCacheLatency);
+            }
+        }
+        if (hit) {
+            entry.writable = hit->writable;
+            entry.user = hit->user;
+            entry.noExec = hit->noExec;
+            uncacheable = hit->uncacheable;
+        }
     } else {
         // We're in some flavor of legacy mode.
         CR4 cr4 = tc->readMiscRegNoEffect(misc_reg::Cr4);
@@ -581,14 +710,16 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     entry.vaddr = vaddr;
 
     Request::Flags flags = Request::PHYSICAL;
-    if (cr3.pcd)
+    if (uncacheable)
         flags.set(Request::UNCACHEABLE);
 
-    RequestPtr request = std::make_shared<Request>(
+    RequestPtr request = Request::create(
         topAddr, dataSize, flags, walker->requestorId);
 
     read = new Packet(request, MemCmd::ReadReq);
     read->allocate();
+    if (!functional)
+        walker->stats.walkReads++;
 }
 
 bool
@@ -721,6 +852,22 @@ Walker::WalkerState::retry()
     sendPackets();
 }
 
+void
+Walker::WalkerState::fillPagingCache(PagingCache &cache, Addr table,
+                                     bool uncacheable)
+{
+    if (functional)
+        return;
+
+    PagingCache::Entry cached;
+    cached.table = table;
+    cached.writable = entry.writable;
+    cached.user = entry.user;
+    cached.noExec = entry.noExec;
+    cached.uncacheable = uncacheable;
+    cache.insert(entry.vaddr, cached);
+}
+
 Fault
 Walker::WalkerState::pageFault(bool present)
 {
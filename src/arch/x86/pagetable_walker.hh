@@ -43,11 +43,14 @@
 #include "arch/generic/mmu.hh"
 #include "arch/x86/pagetable.hh"
 #include "arch/x86/tlb.hh"
+#include "base/bitfield.hh"
+#include "base/object_pool.hh"
 #include "base/types.hh"
 #include "mem/packet.hh"
 #include "params/X86PagetableWalker.hh"
 #include "sim/clocked_object.hh"
 #include "sim/faults.hh"
+#include "sim/stats.hh"
 #include "sim/system.hh"
 
 namespace gem5
@@ -78,6 +81,47 @@ namespace X86ISA
         friend class WalkerPort;
         WalkerPort port;
 
+        /**
+         * Paging-structure cache for one level of the long mode page
+         * table. Entries are tagged with the virtual address bits that
+         * level and the ones above it translate, and hold the address of
+         * the table one level down along with the permissions gathered
+         * on the way there, so a walk can start right at that table.
+         */
+        class PagingCache
+        {
+          public:
+            struct Entry
+            {
+                bool valid = false;
+                Addr tag = 0;
+                Addr table = 0;
+                bool writable = false;
+                bool user = false;
+                bool noExec = false;
+                bool uncacheable = false;
+                uint64_t lastUse = 0;
+            };
+
+            PagingCache(unsigned size, unsigned shift) :
+                entries(size), shift(shift)
+            {}
+
+            const Entry *lookup(Addr vaddr);
+            void insert(Addr vaddr, const Entry &entry);
+            void flush();
+
+            bool enabled() const { return !entries.empty(); }
+
+          private:
+            Addr tagOf(Addr vaddr) const { return bits(vaddr, 47, shift); }
+
+            std::vector<Entry> entries;
+            // lowest virtual address bit translated by the cached level
+            const unsigned shift;
+            uint64_t useSeq = 0;
+        };
+
         // State to track each walk of the page table
         class WalkerState
         {
@@ -105,6 +149,8 @@ namespace X86ISA
             bool enableNX;
             unsigned inflight;
             TlbEntry entry;
+            // lookups done before the walk, which delay its first access
+            Tick startDelay;
             PacketPtr read;
             std::vector<PacketPtr> writes;
             Fault timingFault;
@@ -119,7 +165,7 @@ namespace X86ISA
             WalkerState(Walker * _walker, BaseMMU::Translation *_translation,
                         const RequestPtr &_req, bool _isFunctional = false) :
                 walker(_walker), req(_req), state(Ready),
-                nextState(Ready), inflight(0),
+                nextState(Ready), inflight(0), startDelay(0),
                 translation(_translation),
                 functional(_isFunctional), timing(false),
                 retrying(false), started(false), squashed(false)
@@ -144,6 +190,8 @@ namespace X86ISA
             void sendPackets();
             void endWalk();
             Fault pageFault(bool present);
+            void fillPagingCache(PagingCache &cache, Addr table,
+                                 bool uncacheable);
         };
 
         friend class WalkerState;
@@ -158,12 +206,15 @@ namespace X86ISA
             WalkerState * senderWalk;
             WalkerSenderState(WalkerState * _senderWalk) :
                 senderWalk(_senderWalk) {}
+
+            GEM5_POOLED_NEW(WalkerSenderState)
         };
 
       public:
-        // Kick off the state machine.
+        // Kick off the state machine. The delay is the time spent looking
+        // up the translation elsewhere before it got here.
         Fault start(ThreadContext * _tc, BaseMMU::Translation *translation,
-                const RequestPtr &req, BaseMMU::Mode mode);
+                const RequestPtr &req, BaseMMU::Mode mode, Tick delay = 0);
         Fault startFunctional(ThreadContext * _tc, Addr &addr,
                 unsigned &logBytes, BaseMMU::Mode mode);
         Port &getPort(const std::string &if_name,
@@ -178,6 +229,24 @@ namespace X86ISA
         // The number of outstanding walks that can be squashed per cycle.
         unsigned numSquashable;
 
+        // Paging-structure caches for the PML4, PDP and PD levels.
+        PagingCache pml4Cache;
+        PagingCache pdpCache;
+        PagingCache pdCache;
+        const Cycles pagingCacheLatency;
+
+        struct WalkerStats : public statistics::Group
+        {
+            WalkerStats(statistics::Group *parent);
+
+            statistics::Scalar walks;
+            statistics::Scalar walkReads;
+            statistics::Scalar pml4CacheHits;
+            statistics::Scalar pdpCacheHits;
+            statistics::Scalar pdCacheHits;
+            statistics::Formula readsPerWalk;
+        } stats;
+
         // Wrapper for checking for squashes before starting a translation.
         void startWalkWrapper();
 
@@ -186,6 +255,15 @@ namespace X86ISA
          **/
         EventFunctionWrapper startWalkWrapperEvent;
 
+        // Send the first access of the walk in progress, once the lookups
+        // made before it are done.
+        void sendDelayedWalk();
+
+        /**
+         * Event used to call sendDelayedWalk.
+         **/
+        EventFunctionWrapper delayedWalkEvent;
+
         // Functions for dealing with packets.
         bool recvTimingResp(PacketPtr pkt);
         void recvReqRetry();
@@ -198,6 +276,9 @@ namespace X86ISA
             tlb = _tlb;
         }
 
+        // Drop all paging-structure cache entries, as a TLB flush does.
+        void flushPagingCaches();
+
         using Params = X86PagetableWalkerParams;
 
         Walker(const Params &params) :
@@ -205,7 +286,13 @@ namespace X86ISA
             funcState(this, NULL, NULL, true), tlb(NULL), sys(params.system),
             requestorId(sys->getRequestorId(this)),
             numSquashable(params.num_squash_per_cycle),
-            startWalkWrapperEvent([this]{ startWalkWrapper(); }, name())
+            pml4Cache(params.pml4_cache_size, 39),
+            pdpCache(params.pdp_cache_size, 30),
+            pdCache(params.pd_cache_size, 21),
+            pagingCacheLatency(params.paging_cache_latency),
+            stats(this),
+            startWalkWrapperEvent([this]{ startWalkWrapper(); }, name()),
+            delayedWalkEvent([this]{ sendDelayedWalk(); }, name())
         {
         }
     };
@@ -53,6 +53,7 @@
 #include "mem/packet_access.hh"
 #include "mem/page_table.hh"
 #include "mem/request.hh"
+#include "sim/eventq.hh"
 #include "sim/full_system.hh"
 #include "sim/process.hh"
 #include "sim/pseudo_inst.hh"
@@ -63,8 +64,9 @@ namespace gem5
 namespace X86ISA {
 
 TLB::TLB(const Params &p)
-    : BaseTLB(p), configAddress(0), size(p.size),
-      tlb(size), lruSeq(0), m5opRange(p.system->m5opRange()), stats(this)
+    : BaseTLB(p), configAddress(0), lookupLatency(p.lookup_latency),
+      size(p.size), tlb(size), lruSeq(0),
+      m5opRange(p.system->m5opRange()), stats(this)
 {
     if (!size)
         fatal("TLBs must have a non-zero size.\n");
@@ -74,8 +76,11 @@ TLB::TLB(const Params &p)
         freeList.push_back(&tlb[x]);
     }
 
+    // A second level TLB is only filled through the TLBs in front of it
+    // and doesn't need a walker.
     walker = p.walker;
-    walker->setTLB(this);
+    if (walker)
+        walker->setTLB(this);
 }
 
 void
@@ -117,6 +122,11 @@ TLB::insert(Addr vpn, const TlbEntry &entry)
     newEntry->vaddr = vpn;
     newEntry->trieHandle =
     trie.insert(vpn, TlbEntryTrie::MaxBits - entry.logBytes, newEntry);
+
+    // The next level holds everything the levels above it do.
+    if (auto *next_level = static_cast<TLB *>(nextLevel()))
+        next_level->insert(vpn, entry);
+
     return newEntry;
 }
 
@@ -129,6 +139,22 @@ TLB::lookup(Addr va, bool update_lru)
     return entry;
 }
 
+TlbEntry *
+TLB::probe(Addr va, BaseMMU::Mode mode)
+{
+    TlbEntry *entry = lookup(va);
+    if (mode == BaseMMU::Read) {
+        stats.rdAccesses++;
+        if (!entry)
+            stats.rdMisses++;
+    } else {
+        stats.wrAccesses++;
+        if (!entry)
+            stats.wrMisses++;
+    }
+    return entry;
+}
+
 void
 TLB::flushAll()
 {
@@ -140,6 +166,9 @@ TLB::flushAll()
             freeList.push_back(&tlb[i]);
         }
     }
+
+    if (walker)
+        walker->flushPagingCaches();
 }
 
 void
@@ -159,6 +188,11 @@ TLB::flushNonGlobal()
             freeList.push_back(&tlb[i]);
         }
     }
+
+    if (walker)
+        walker->flushPagingCaches();
+    if (auto *next_level = static_cast<TLB *>(nextLevel()))
+        next_level->flushNonGlobal();
 }
 
 void
@@ -170,6 +204,12 @@ TLB::demapPage(Addr va, uint64_t asn)
         entry->trieHandle = NULL;
         freeList.push_back(entry);
     }
+
+    // Like INVLPG, drop all paging-structure cache entries as well.
+    if (walker)
+        walker->flushPagingCaches();
+    if (auto *next_level = static_cast<TLB *>(nextLevel()))
+        next_level->demapPage(va, asn);
 }
 
 namespace
@@ -309,7 +349,8 @@ TLB::finalizePhysical(const RequestPtr &req,
 Fault
 TLB::translate(const RequestPtr &req,
         ThreadContext *tc, BaseMMU::Translation *translation,
-        BaseMMU::Mode mode, bool &delayedResponse, bool timing)
+        BaseMMU::Mode mode, bool &delayedResponse, bool timing,
+        bool count_access)
 {
     Request::Flags flags = req->getFlags();
     int seg = flags & SegmentFlagMask;
@@ -391,22 +432,45 @@ TLB::translate(const RequestPtr &req,
             DPRINTF(TLB, "Paging enabled.\n");
             // The vaddr already has the segment base applied.
             TlbEntry *entry = lookup(vaddr);
-            if (mode == BaseMMU::Read) {
-                stats.rdAccesses++;
-            } else {
-                stats.wrAccesses++;
+            Tick next_level_latency = 0;
+            if (count_access) {
+                if (mode == BaseMMU::Read) {
+                    stats.rdAccesses++;
+                } else {
+                    stats.wrAccesses++;
+                }
             }
             if (!entry) {
                 DPRINTF(TLB, "Handling a TLB miss for "
                         "address %#x at pc %#x.\n",
                         vaddr, tc->pcState().instAddr());
-                if (mode == BaseMMU::Read) {
-                    stats.rdMisses++;
-                } else {
-                    stats.wrMisses++;
+                if (count_access) {
+                    if (mode == BaseMMU::Read) {
+                        stats.rdMisses++;
+                    } else {
+                        stats.wrMisses++;
+                    }
                 }
+
+                // Look in the second level TLB, if any, before walking.
+                if (auto *next_level = static_cast<TLB *>(nextLevel())) {
+                    next_level_latency = next_level->lookupLatency;
+                    if (TlbEntry *l2_entry = next_level->probe(vaddr, mode)) {
+                        DPRINTF(TLB, "Hit in the next level TLB.\n");
+                        entry = insert(l2_entry->vaddr, *l2_entry);
+                        if (timing && next_level_latency) {
+                            translateAfter(next_level_latency, req, tc,
+                                           translation, mode);
+                            delayedResponse = true;
+                            return NoFault;
+                        }
+                    }
+                }
+            }
+            if (!entry) {
                 if (FullSystem) {
-                    Fault fault = walker->start(tc, translation, req, mode);
+                    Fault fault = walker->start(tc, translation, req, mode,
+                                                next_level_latency);
                     if (timing || fault != NoFault) {
                         // This gets ignored in atomic mode.
                         delayedResponse = true;
@@ -422,15 +486,26 @@ TLB::translate(const RequestPtr &req,
                         return std::make_shared<PageFault>(vaddr, true, mode,
                                                            true, false);
                     } else {
-                        Addr alignedVaddr = p->pTable->pageAlign(vaddr);
+                        // Large pages get a matching large TLB entry.
+                        Addr alignedVaddr = vaddr & ~mask(pte->logBytes);
                         DPRINTF(TLB, "Mapping %#x to %#x\n", alignedVaddr,
                                 pte->paddr);
-                        entry = insert(alignedVaddr, TlbEntry(
+                        TlbEntry new_entry(
                                 p->pTable->pid(), alignedVaddr, pte->paddr,
                                 pte->flags & EmulationPageTable::Uncacheable,
-                                pte->flags & EmulationPageTable::ReadOnly));
+                                pte->flags & EmulationPageTable::ReadOnly);
+                        new_entry.logBytes = pte->logBytes;
+                        entry = insert(alignedVaddr, new_entry);
                     }
                     DPRINTF(TLB, "Miss was serviced.\n");
+                    // There is no walk to hold up, the next level's
+                    // lookup is charged before the retranslation.
+                    if (timing && next_level_latency) {
+                        translateAfter(next_level_latency, req, tc,
+                                       translation, mode);
+                        delayedResponse = true;
+                        return NoFault;
+                    }
                 }
             }
 
@@ -476,6 +551,25 @@ TLB::translate(const RequestPtr &req,
     return finalizePhysical(req, tc, mode);
 }
 
+void
+TLB::translateAfter(Tick delay, const RequestPtr &req, ThreadContext *tc,
+        BaseMMU::Translation *translation, BaseMMU::Mode mode)
+{
+    auto *event = new EventFunctionWrapper(
+        [this, req, tc, translation, mode]
+        {
+            // Should the entry have been evicted in the meantime, the
+            // translation is simply delayed again. The lookup has been
+            // counted already.
+            bool delayed;
+            Fault fault = translate(req, tc, translation, mode, delayed,
+                                    true, false);
+            if (!delayed)
+                translation->finish(fault, req, tc, mode);
+        }, name() + ".translateAfter", true);
+    schedule(event, curTick() + delay);
+}
+
 Fault
 TLB::translateAtomic(const RequestPtr &req, ThreadContext *tc,
     BaseMMU::Mode mode)
@@ -512,7 +606,7 @@ TLB::translateFunctional(const RequestPtr &req, ThreadContext *tc,
         if (!pte)
             return std::make_shared<PageFault>(vaddr, true, mode, true, false);
 
-        paddr = pte->paddr | process->pTable->pageOffset(vaddr);
+        paddr = pte->translate(vaddr);
     }
     DPRINTF(TLB, "Translated (functional) %#x -> %#x.\n", vaddr, paddr);
     req->setPaddr(paddr);
@@ -592,7 +686,7 @@ TLB::unserialize(CheckpointIn &cp)
 Port *
 TLB::getTableWalkerPort()
 {
-    return &walker->getPort("port");
+    return walker ? &walker->getPort("port") : nullptr;
 }
 
 } // namespace X86ISA
@@ -81,8 +81,25 @@ namespace X86ISA
 
         EntryList::iterator lookupIt(Addr va, bool update_lru = true);
 
+        /**
+         * Look up an entry on behalf of a TLB in front of this one,
+         * counting the access and any miss in this TLB's stats.
+         */
+        TlbEntry *probe(Addr va, BaseMMU::Mode mode);
+
+        /**
+         * Redo a translation after a delay, by which time its entry has
+         * been brought into this TLB, and let the requestor know.
+         */
+        void translateAfter(Tick delay, const RequestPtr &req,
+                ThreadContext *tc, BaseMMU::Translation *translation,
+                BaseMMU::Mode mode);
+
         Walker * walker;
 
+        // Time it takes a TLB in front of this one to look this one up.
+        const Tick lookupLatency;
+
       public:
         Walker *getWalker();
 
@@ -116,9 +133,15 @@ namespace X86ISA
 
         Fault translateInt(bool read, RequestPtr req, ThreadContext *tc);
 
+        /**
+         * @param count_access Count the lookup in the access and miss
+         *        stats, which a translation redone after a next level
+         *        hit already did
+         */
         Fault translate(const RequestPtr &req, ThreadContext *tc,
                 BaseMMU::Translation *translation, BaseMMU::Mode mode,
-                bool &delayedResponse, bool timing);
+                bool &delayedResponse, bool timing,
+                bool count_access=true);
 
       public:
 
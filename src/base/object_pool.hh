@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Thread local free lists for objects that are created and destroyed
+ * at a high rate, such as packets, requests and Ruby messages.
+ */
+
+#ifndef __BASE_OBJECT_POOL_HH__
+#define __BASE_OBJECT_POOL_HH__
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace gem5
+{
+
+/**
+ * Per-type free list for object storage. Only blocks of exactly
+ * sizeof(T) are recycled; any other size (e.g., a subclass without a
+ * pool of its own) is forwarded to the global allocator. The lists are
+ * thread local, so no locking is needed and a block may be returned to
+ * a different list than the one it was taken from, e.g., when an
+ * object is passed to another event queue. As objects may keep moving
+ * in one direction between threads, a list holds at most MaxFreeBlocks
+ * blocks and gives any further ones back to the global allocator.
+ */
+template <class T>
+class ObjectPool
+{
+  public:
+    /** Most blocks kept on the free list of one thread. */
+    static constexpr std::size_t MaxFreeBlocks = 4096;
+
+    static void *
+    allocate(std::size_t size)
+    {
+        auto &free_list = freeList();
+        if (size != sizeof(T) || free_list.blocks.empty())
+            return ::operator new(size);
+
+        void *block = free_list.blocks.back();
+        free_list.blocks.pop_back();
+        return block;
+    }
+
+    static void
+    release(void *block, std::size_t size)
+    {
+        auto &free_list = freeList();
+        if (size != sizeof(T) ||
+            free_list.blocks.size() >= MaxFreeBlocks) {
+            ::operator delete(block);
+            return;
+        }
+        free_list.blocks.push_back(block);
+    }
+
+  private:
+    struct FreeList
+    {
+        std::vector<void *> blocks;
+
+        ~FreeList()
+        {
+            for (auto block : blocks)
+                ::operator delete(block);
+        }
+    };
+
+    static FreeList &
+    freeList()
+    {
+        static thread_local FreeList free_list;
+        return free_list;
+    }
+};
+
+/**
+ * Standard allocator backed by an ObjectPool, for objects that are not
+ * created with new, e.g., through std::allocate_shared. The allocator
+ * is rebound to the type actually allocated (for std::allocate_shared,
+ * the object together with its control block), which gets a pool of
+ * its own.
+ */
+template <class T>
+class PoolAllocator
+{
+  public:
+    typedef T value_type;
+
+    PoolAllocator() = default;
+
+    template <class U>
+    PoolAllocator(const PoolAllocator<U> &) {}
+
+    T *
+    allocate(std::size_t n)
+    {
+        return static_cast<T *>(ObjectPool<T>::allocate(n * sizeof(T)));
+    }
+
+    void
+    deallocate(T *p, std::size_t n)
+    {
+        ObjectPool<T>::release(p, n * sizeof(T));
+    }
+
+    template <class U>
+    bool operator==(const PoolAllocator<U> &) const { return true; }
+
+    template <class U>
+    bool operator!=(const PoolAllocator<U> &) const { return false; }
+};
+
+} // namespace gem5
+
+/**
+ * Declare class specific operator new/delete backed by an ObjectPool.
+ */
+#define GEM5_POOLED_NEW(T)                                              \
+    static void *                                                       \
+    operator new(std::size_t size)                                      \
+    {                                                                   \
+        return ::gem5::ObjectPool<T>::allocate(size);                   \
+    }                                                                   \
+    static void                                                         \
+    operator delete(void *block, std::size_t size)                      \
+    {                                                                   \
+        ::gem5::ObjectPool<T>::release(block, size);                    \
+    }
+
+#endif // __BASE_OBJECT_POOL_HH__
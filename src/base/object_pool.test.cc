@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+
+#include "base/object_pool.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct Pooled
+{
+    uint64_t payload[4];
+
+    GEM5_POOLED_NEW(Pooled)
+};
+
+struct Larger : public Pooled
+{
+    uint64_t extra;
+};
+
+} // anonymous namespace
+
+TEST(ObjectPoolTest, DeletedObjectsAreRecycled)
+{
+    Pooled *first = new Pooled;
+    delete first;
+
+    Pooled *second = new Pooled;
+    EXPECT_EQ(second, first);
+    delete second;
+}
+
+TEST(ObjectPoolTest, OtherSizesBypassThePool)
+{
+    Pooled *pooled = new Pooled;
+    delete pooled;
+
+    // A subclass of a different size is not given a pooled block, and
+    // does not end up on the free list when deleted
+    Pooled *larger = new Larger;
+    EXPECT_NE(larger, pooled);
+    delete static_cast<Larger *>(larger);
+
+    Pooled *again = new Pooled;
+    EXPECT_EQ(again, pooled);
+    delete again;
+}
+
+TEST(ObjectPoolTest, AllocateShared)
+{
+    PoolAllocator<Pooled> alloc;
+    Pooled *first = std::allocate_shared<Pooled>(alloc).get();
+
+    // The object and its control block were released together and are
+    // handed out again as a unit
+    auto second = std::allocate_shared<Pooled>(alloc);
+    EXPECT_EQ(second.get(), first);
+}
@@ -210,6 +210,13 @@ class RefCountingPtr
     template <bool B = TisConst>
     RefCountingPtr(const NonConstT &r) { copy(r.data); }
 
+    /// Create a reference counting pointer to a base class of the
+    /// object held by another one (upcast).  Adds a reference.
+    template <class U, std::enable_if_t<std::is_base_of_v<T, U> &&
+        !std::is_same_v<std::remove_const_t<T>, std::remove_const_t<U>>,
+        int> = 0>
+    RefCountingPtr(const RefCountingPtr<U> &r) { copy(r.get()); }
+
     /// Destroy the pointer and any reference it may hold.
     ~RefCountingPtr() { del(); }
 
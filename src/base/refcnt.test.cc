@@ -70,6 +70,13 @@ class TestRC : public RefCounted
 };
 typedef RefCountingPtr<TestRC> Ptr;
 
+class DerivedTestRC : public TestRC
+{
+  public:
+    int derivedVal;
+};
+typedef RefCountingPtr<DerivedTestRC> DerivedPtr;
+
 } // anonymous namespace
 
 TEST(RefcntTest, NullPointerCheck)
@@ -172,3 +179,20 @@ TEST(RefcntTest, EqualityOperators)
     EXPECT_TRUE(equalTestAPtr != equalTestB);
     EXPECT_TRUE(equalTestAPtr != equalTestBPtr);
 }
+
+TEST(RefcntTest, ConstructionFromDerivedPointer)
+{
+    // Test that a pointer to a derived class can be upcast while
+    // sharing the reference.
+    DerivedPtr derived = new DerivedTestRC();
+    EXPECT_EQ(1, liveListSize());
+    {
+        Ptr base = derived;
+        RefCountingPtr<const TestRC> const_base = derived;
+        EXPECT_EQ(base.get(), derived.get());
+        EXPECT_EQ(const_base.get(), derived.get());
+        derived = NULL;
+        EXPECT_EQ(1, liveListSize());
+    }
+    EXPECT_EQ(0, liveListSize());
+}
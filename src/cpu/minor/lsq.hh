@@ -49,6 +49,7 @@
 #include <vector>
 
 #include "base/named.hh"
+#include "base/object_pool.hh"
 #include "cpu/minor/buffers.hh"
 #include "cpu/minor/cpu.hh"
 #include "cpu/minor/pipe_data.hh"
@@ -385,6 +386,8 @@ class LSQ : public Named
             packetInFlight(false),
             packetSent(false)
         { }
+
+        GEM5_POOLED_NEW(SingleDataRequest)
     };
 
     class SplitDataRequest : public LSQRequest
@@ -52,6 +52,7 @@
 #include "arch/generic/mmu.hh"
 #include "arch/generic/tlb.hh"
 #include "base/flags.hh"
+#include "base/object_pool.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
@@ -577,6 +578,9 @@ class LSQ
                        std::move(amo_op)) {}
 
         virtual ~SingleDataRequest() {}
+
+        GEM5_POOLED_NEW(SingleDataRequest)
+
         virtual void markAsStaleTranslation();
         virtual void initiateTranslation();
         virtual void finish(const Fault &fault, const RequestPtr &req,
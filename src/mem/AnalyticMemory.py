@@ -0,0 +1,70 @@
+# Copyright (c) 2025
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.objects.AbstractMemory import *
+
+# AnalyticMemory estimates the latency of a DRAM channel instead of
+# simulating it. It tracks the open row of every bank, measures the
+# utilization and bank-level parallelism of the recent traffic, and adds
+# an M/D/1 queueing delay, without scheduling any event per burst. The
+# defaults describe a single DDR4_2400_16x4 channel behind a MemCtrl with
+# default front- and back-end latencies.
+class AnalyticMemory(AbstractMemory):
+    type = 'AnalyticMemory'
+    cxx_header = "mem/analytic_mem.hh"
+    cxx_class = 'gem5::memory::AnalyticMemory'
+
+    port = ResponsePort("This port sends responses and receives requests")
+
+    frontend_latency = Param.Latency('10ns', "Controller latency before "
+        "an access, the only latency seen by writes")
+    backend_latency = Param.Latency('10ns', "Controller latency after a "
+        "read access")
+
+    row_hit_latency = Param.Latency('17.492ns', "Latency of a read that "
+        "hits in the row buffer (tCL + tBURST)")
+    row_miss_latency = Param.Latency('28.32ns', "Additional latency of a "
+        "row buffer miss (tRP + tRCD)")
+
+    burst_size = Param.MemorySize('64B', "Size of a burst")
+    burst_time = Param.Latency('3.332ns', "Time a burst occupies the data "
+        "bus (tBURST)")
+    row_buffer_size = Param.MemorySize('8KiB', "Row buffer size of a bank, "
+        "across all devices of a rank")
+    num_banks = Param.Unsigned(32, "Number of banks in the channel, "
+        "across all ranks")
+
+    utilization_window = Param.Latency('1us', "Interval over which "
+        "utilization and bank-level parallelism are measured")
+    max_utilization = Param.Float(0.95, "Cap on the utilization used by "
+        "the queueing estimate")
+    queue_scale = Param.Float(1.0, "Scale of the queueing estimate, "
+        "obtained by calibrating against a detailed controller")
+
+    def controller(self):
+        # Analytic memory doesn't use a MemCtrl
+        return self
@@ -0,0 +1,83 @@
+# Copyright (c) 2025
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+from m5.objects.ClockedObject import ClockedObject
+from m5.objects.DRAMInterface import DDR4_2400_16x4
+from m5.objects.MemCtrl import MemCtrl
+from m5.objects.SubSystem import SubSystem
+
+# CXLLink models the CXL.mem link in front of a Type-3 memory device. The
+# defaults correspond to a x16 CXL 2.0 link running at 32 GT/s with 68 byte
+# flits carrying four 16 byte slots
+class CXLLink(ClockedObject):
+    type = 'CXLLink'
+    cxx_header = "mem/cxl_link.hh"
+    cxx_class = 'gem5::CXLLink'
+
+    cpu_side_port = ResponsePort("This port receives requests and "
+                                 "sends responses")
+    mem_side_port = RequestPort("This port sends requests and "
+                                "receives responses")
+
+    ranges = VectorParam.AddrRange([AllMemory],
+        "Address ranges to pass through the link")
+
+    delay = Param.Latency('25ns', "One-way latency of the link, including "
+        "the host and device controllers")
+    num_lanes = Param.Unsigned(16, "Number of lanes in each direction")
+    lane_speed = Param.UInt64(32, "Speed of each lane (Gb/s)")
+
+    flit_size = Param.Unsigned(68, "Size of a flit on the wire (bytes), "
+        "including CRC and protocol identifiers")
+    slots_per_flit = Param.Unsigned(4, "Number of slots in a flit")
+    slot_size = Param.Unsigned(16, "Size of a slot (bytes)")
+
+    req_header_bits = Param.Unsigned(87, "Size of an M2S Req header")
+    rwd_header_bits = Param.Unsigned(87, "Size of an M2S RwD header")
+    ndr_header_bits = Param.Unsigned(30, "Size of an S2M NDR header")
+    drs_header_bits = Param.Unsigned(40, "Size of an S2M DRS header")
+
+    req_credits = Param.Unsigned(32, "Device buffers for read requests")
+    rwd_credits = Param.Unsigned(32, "Device buffers for write requests")
+
+    req_size = Param.Unsigned(32, "The number of requests to buffer at "
+        "the host")
+    resp_size = Param.Unsigned(64, "The number of responses the host "
+        "reserves space for")
+
+# A CXL Type-3 memory expander: a memory controller behind a CXL link,
+# serving its own address range. Connect link.cpu_side_port to the host
+# memory bus and add the range to the system memory map to expose it.
+# The range is plain memory to the guest, describing it as a separate
+# NUMA node (e.g. in the SRAT or the device tree) is not done here
+class CXLMemDevice(SubSystem):
+    def __init__(self, mem_range, dram=DDR4_2400_16x4, **kwargs):
+        super().__init__(**kwargs)
+        self.link = CXLLink(ranges=[mem_range])
+        self.mem_ctrl = MemCtrl(dram=dram(range=mem_range))
+        self.link.mem_side_port = self.mem_ctrl.port
@@ -67,6 +67,12 @@ class DRAMInterface(MemInterface):
     # performance being lower when enabled
     enable_dram_powerdown = Param.Bool(False, "Enable powerdown states")
 
+    # Stop the refresh event loop of a rank while the controller is idle,
+    # and account for the refreshes of the idle period in bulk once the
+    # rank is used again or the stats are dumped
+    bulk_idle_refresh = Param.Bool(True, "Account for the refreshes of "
+                                   "idle ranks in bulk")
+
     # For power modelling we need to know if the DRAM has a DLL or not
     dll = Param.Bool(True, "DRAM has DLL or not")
 
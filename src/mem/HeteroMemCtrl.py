@@ -42,6 +42,17 @@ from m5.params import *
 from m5.proxy import *
 from m5.objects.MemCtrl import *
 
+# Page placement policy of the tiering engine. 'fixed' keeps the address
+# map fixed, 'threshold' promotes NVM pages whose hotness reaches
+# migration_threshold into DRAM, demoting a colder DRAM page in exchange
+class TieringPolicy(Enum): vals = ['fixed', 'threshold']
+
+# How page hotness is tracked. 'counters' keeps a per-page access counter
+# that is halved every epoch, 'access_bits' keeps a per-page history of
+# the epochs in which the page was referenced, as an OS scanning page
+# table accessed bits would, and uses the number of recent epochs with a
+# reference as the hotness
+class HotnessTracking(Enum): vals = ['counters', 'access_bits']
 
 # HeteroMemCtrl controls a dram and an nvm interface
 # Both memory interfaces share the data and command bus
@@ -54,3 +65,24 @@ class HeteroMemCtrl(MemCtrl):
     # The dram interface `dram` used by HeteroMemCtrl is defined in
     # the MemCtrl
     nvm = Param.NVMInterface("NVM memory interface to use")
+
+    # Page-granularity tiering between the DRAM (fast) and NVM (slow)
+    # interfaces. Data always stays at its system address; the tiering
+    # engine only redirects the timing of an access to the media that
+    # currently holds the page
+    tiering_policy = Param.TieringPolicy('fixed',
+        "Page placement policy between the DRAM and NVM interfaces")
+    tier_page_size = Param.MemorySize('4KiB', "Granularity of migration, "
+        "at least a cache line and a burst of either interface")
+    hotness_tracking = Param.HotnessTracking('counters',
+        "How the hotness of a page is tracked")
+    hotness_sample_interval = Param.Unsigned(1,
+        "Only every n-th access updates the hotness of its page")
+    tiering_epoch = Param.Latency('100us',
+        "Interval at which hotness decays and migrations are decided")
+    migration_threshold = Param.Unsigned(8,
+        "Hotness an NVM page needs to become a promotion candidate")
+    max_migrations_per_epoch = Param.Unsigned(16,
+        "Maximum number of page swaps per epoch")
+    migration_bandwidth = Param.MemoryBandwidth('4GiB/s',
+        "Bandwidth of the shared bus available to page migration")
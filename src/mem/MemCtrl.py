@@ -46,6 +46,11 @@ from m5.objects.QoSMemCtrl import *
 # First-Served and a First-Row Hit then First-Come First-Served
 class MemSched(Enum): vals = ['fcfs', 'frfcfs']
 
+# Enum for the memory-side prefetcher, either fetching the next burst
+# after every read, or following a per-bank stride but only within a
+# row that is already open
+class MemPrefetchPolicy(ScopedEnum): vals = ['none', 'next_line', 'open_row']
+
 # MemCtrl is a single-channel single-ported Memory controller model
 # that aims to model the most important system-level performance
 # effects of a memory controller, interfacing with media specific
@@ -93,3 +98,12 @@ class MemCtrl(QoSMemCtrl):
     static_backend_latency = Param.Latency("10ns", "Static backend latency")
 
     command_window = Param.Latency("10ns", "Static backend latency")
+
+    # optional memory-side prefetcher that uses idle read slots to fill
+    # a small buffer in the controller, later reads that hit in the
+    # buffer are serviced without accessing the media
+    mem_prefetch_policy = Param.MemPrefetchPolicy('none',
+                                                  "Memory-side prefetch "
+                                                  "policy")
+    prefetch_buffer_size = Param.Unsigned(16, "Number of bursts held in "
+                                          "the prefetch buffer")
@@ -0,0 +1,393 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * AnalyticMemory definition
+ */
+
+#include "mem/analytic_mem.hh"
+
+#include <algorithm>
+
+#include "base/intmath.hh"
+#include "base/trace.hh"
+#include "debug/Drain.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+AnalyticMemory::AnalyticMemory(const AnalyticMemoryParams &p) :
+    AbstractMemory(p),
+    port(name() + ".port", *this),
+    frontendLatency(p.frontend_latency),
+    backendLatency(p.backend_latency),
+    rowHitLatency(p.row_hit_latency),
+    rowMissLatency(p.row_miss_latency),
+    burstSize(p.burst_size),
+    burstTime(p.burst_time),
+    rowBufferSize(p.row_buffer_size),
+    numBanks(p.num_banks),
+    window(p.utilization_window),
+    maxUtilization(p.max_utilization),
+    queueScale(p.queue_scale),
+    openRow(p.num_banks, MaxAddr),
+    windowStart(0), windowBursts(0), windowMisses(0),
+    windowBankUsed(p.num_banks, false), windowBanks(0),
+    queueDelay(0),
+    retryResp(false),
+    dequeueEvent([this]{ dequeue(); }, name()),
+    analyticStats(*this)
+{
+    fatal_if(burstSize == 0 || rowBufferSize < burstSize,
+             "%s: the row buffer must hold at least one burst\n", name());
+    fatal_if(numBanks == 0, "%s: needs at least one bank\n", name());
+    fatal_if(window == 0, "%s: utilization window must be non-zero\n",
+             name());
+    fatal_if(maxUtilization <= 0 || maxUtilization >= 1,
+             "%s: maximum utilization must be between 0 and 1\n", name());
+}
+
+void
+AnalyticMemory::init()
+{
+    AbstractMemory::init();
+
+    if (port.isConnected()) {
+        port.sendRangeChange();
+    }
+}
+
+void
+AnalyticMemory::updateWindow()
+{
+    const Tick elapsed = curTick() - windowStart;
+    if (elapsed < window)
+        return;
+
+    // Every burst holds the shared data bus for a burst time, while the
+    // precharge and activate of a row miss overlap across the banks in
+    // use
+    const double parallelism = std::max(windowBanks, 1u);
+    const double miss_rate = windowBursts ?
+        double(windowMisses) / windowBursts : 0;
+    const double service = burstTime +
+        miss_rate * rowMissLatency / parallelism;
+    const double utilization =
+        std::min(windowBursts * service / elapsed, maxUtilization);
+
+    // mean waiting time of an M/D/1 queue
+    queueDelay = queueScale * utilization * service /
+        (2 * (1 - utilization));
+
+    analyticStats.windows++;
+    analyticStats.totUtilization += utilization;
+    analyticStats.totBankParallelism += parallelism;
+
+    windowStart = curTick();
+    windowBursts = 0;
+    windowMisses = 0;
+    std::fill(windowBankUsed.begin(), windowBankUsed.end(), false);
+    windowBanks = 0;
+}
+
+Tick
+AnalyticMemory::estimateLatency(PacketPtr pkt)
+{
+    updateWindow();
+
+    // map the address row, bank, column from the most significant bit
+    // down, as the default RoRaBaCoCh address mapping does
+    const Addr offset = range.getOffset(pkt->getAddr());
+    const unsigned bursts = std::max<unsigned>(1,
+        divCeil(offset % burstSize + pkt->getSize(), burstSize));
+    const Addr row_addr = offset / rowBufferSize;
+    const unsigned bank = row_addr % numBanks;
+    const Addr row = row_addr / numBanks;
+
+    const bool hit = openRow[bank] == row;
+    openRow[bank] = row;
+    if (hit) {
+        analyticStats.rowHits++;
+    } else {
+        analyticStats.rowMisses++;
+        ++windowMisses;
+    }
+
+    windowBursts += bursts;
+    if (!windowBankUsed[bank]) {
+        windowBankUsed[bank] = true;
+        ++windowBanks;
+    }
+
+    // writes are buffered by the controller and only respond after the
+    // front end, but they do use the bus and the row buffers
+    if (pkt->isWrite()) {
+        analyticStats.writeBursts += bursts;
+        return frontendLatency;
+    }
+
+    const Tick latency = frontendLatency + rowHitLatency +
+        (hit ? 0 : rowMissLatency) + (bursts - 1) * burstTime +
+        queueDelay + backendLatency;
+
+    analyticStats.readBursts += bursts;
+    analyticStats.readReqs++;
+    analyticStats.totQueueLat += queueDelay;
+    analyticStats.totReadLat += latency;
+
+    return latency;
+}
+
+Tick
+AnalyticMemory::recvAtomic(PacketPtr pkt)
+{
+    panic_if(pkt->cacheResponding(), "Should not see packets where cache "
+             "is responding");
+
+    const Tick latency = estimateLatency(pkt);
+    access(pkt);
+    return latency;
+}
+
+void
+AnalyticMemory::recvFunctional(PacketPtr pkt)
+{
+    pkt->pushLabel(name());
+
+    functionalAccess(pkt);
+
+    bool done = false;
+    auto p = packetQueue.begin();
+    // potentially update the packets in our packet queue as well
+    while (!done && p != packetQueue.end()) {
+        done = pkt->trySatisfyFunctional(p->pkt);
+        ++p;
+    }
+
+    pkt->popLabel();
+}
+
+bool
+AnalyticMemory::recvTimingReq(PacketPtr pkt)
+{
+    panic_if(!(pkt->isRead() || pkt->isWrite()),
+             "Should only see read and writes at memory controller, "
+             "saw %s to %#llx\n", pkt->cmdString(), pkt->getAddr());
+
+    // the packet only reaches us after the header delay, and the payload
+    // has to be deserialised before a write
+    Tick receive_delay = pkt->headerDelay + pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+
+    bool needsResponse = pkt->needsResponse();
+    const Tick latency = recvAtomic(pkt);
+
+    if (needsResponse) {
+        assert(pkt->isResponse());
+
+        Tick when_to_send = curTick() + receive_delay + latency;
+
+        // latencies vary, so insert in order of time, but never in front
+        // of an earlier response to the same address
+        auto i = packetQueue.end();
+        while (i != packetQueue.begin()) {
+            auto prev = std::prev(i);
+            if (prev->tick <= when_to_send || prev->pkt->matchAddr(pkt))
+                break;
+            i = prev;
+        }
+        packetQueue.insert(i, {when_to_send, pkt});
+
+        if (!retryResp) {
+            const Tick next = std::max(packetQueue.front().tick, curTick());
+            if (!dequeueEvent.scheduled())
+                schedule(dequeueEvent, next);
+            else if (dequeueEvent.when() > next)
+                reschedule(dequeueEvent, next);
+        }
+    } else {
+        pendingDelete.reset(pkt);
+    }
+
+    return true;
+}
+
+void
+AnalyticMemory::dequeue()
+{
+    assert(!packetQueue.empty());
+    DeferredPacket deferred_pkt = packetQueue.front();
+
+    retryResp = !port.sendTimingResp(deferred_pkt.pkt);
+
+    if (!retryResp) {
+        packetQueue.pop_front();
+
+        if (!packetQueue.empty()) {
+            schedule(dequeueEvent,
+                     std::max(packetQueue.front().tick, curTick()));
+        } else if (drainState() == DrainState::Draining) {
+            DPRINTF(Drain, "Draining of AnalyticMemory complete\n");
+            signalDrainDone();
+        }
+    }
+}
+
+void
+AnalyticMemory::recvRespRetry()
+{
+    assert(retryResp);
+
+    dequeue();
+}
+
+Port &
+AnalyticMemory::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name != "port") {
+        return AbstractMemory::getPort(if_name, idx);
+    } else {
+        return port;
+    }
+}
+
+DrainState
+AnalyticMemory::drain()
+{
+    if (!packetQueue.empty()) {
+        DPRINTF(Drain, "AnalyticMemory Queue has requests, waiting to "
+                "drain\n");
+        return DrainState::Draining;
+    } else {
+        return DrainState::Drained;
+    }
+}
+
+AnalyticMemory::AnalyticStats::AnalyticStats(AnalyticMemory &mem)
+    : statistics::Group(&mem),
+
+    ADD_STAT(readBursts, statistics::units::Count::get(),
+             "Number of read bursts"),
+    ADD_STAT(writeBursts, statistics::units::Count::get(),
+             "Number of write bursts"),
+    ADD_STAT(rowHits, statistics::units::Count::get(),
+             "Number of accesses that hit in an open row"),
+    ADD_STAT(rowMisses, statistics::units::Count::get(),
+             "Number of accesses that opened a row"),
+    ADD_STAT(rowHitRate, statistics::units::Ratio::get(),
+             "Row buffer hit rate"),
+
+    ADD_STAT(windows, statistics::units::Count::get(),
+             "Number of utilization windows"),
+    ADD_STAT(totUtilization, statistics::units::Ratio::get(),
+             "Sum of the utilization of all windows"),
+    ADD_STAT(totBankParallelism, statistics::units::Count::get(),
+             "Sum of the banks in use in all windows"),
+    ADD_STAT(avgUtilization, statistics::units::Ratio::get(),
+             "Average estimated utilization per window"),
+    ADD_STAT(avgBankParallelism, statistics::units::Rate<
+                statistics::units::Count, statistics::units::Count>::get(),
+             "Average number of banks in use per window"),
+
+    ADD_STAT(readReqs, statistics::units::Count::get(),
+             "Number of read requests"),
+    ADD_STAT(totQueueLat, statistics::units::Tick::get(),
+             "Total estimated queueing latency of reads"),
+    ADD_STAT(totReadLat, statistics::units::Tick::get(),
+             "Total estimated latency of reads"),
+    ADD_STAT(avgQueueLat, statistics::units::Rate<
+                statistics::units::Tick, statistics::units::Count>::get(),
+             "Average estimated queueing latency per read"),
+    ADD_STAT(avgReadLat, statistics::units::Rate<
+                statistics::units::Tick, statistics::units::Count>::get(),
+             "Average estimated latency per read")
+{
+}
+
+void
+AnalyticMemory::AnalyticStats::regStats()
+{
+    using namespace statistics;
+
+    rowHitRate.precision(4);
+    rowHitRate = rowHits / (rowHits + rowMisses);
+
+    avgUtilization.precision(4);
+    avgUtilization = totUtilization / windows;
+    avgBankParallelism.precision(2);
+    avgBankParallelism = totBankParallelism / windows;
+
+    avgQueueLat.precision(2);
+    avgQueueLat = totQueueLat / readReqs;
+    avgReadLat.precision(2);
+    avgReadLat = totReadLat / readReqs;
+}
+
+AnalyticMemory::MemoryPort::MemoryPort(const std::string &_name,
+                                       AnalyticMemory &_mem)
+    : ResponsePort(_name, &_mem), mem(_mem)
+{ }
+
+AddrRangeList
+AnalyticMemory::MemoryPort::getAddrRanges() const
+{
+    AddrRangeList ranges;
+    ranges.push_back(mem.getAddrRange());
+    return ranges;
+}
+
+Tick
+AnalyticMemory::MemoryPort::recvAtomic(PacketPtr pkt)
+{
+    return mem.recvAtomic(pkt);
+}
+
+void
+AnalyticMemory::MemoryPort::recvFunctional(PacketPtr pkt)
+{
+    mem.recvFunctional(pkt);
+}
+
+bool
+AnalyticMemory::MemoryPort::recvTimingReq(PacketPtr pkt)
+{
+    return mem.recvTimingReq(pkt);
+}
+
+void
+AnalyticMemory::MemoryPort::recvRespRetry()
+{
+    mem.recvRespRetry();
+}
+
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,199 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * AnalyticMemory declaration
+ */
+
+#ifndef __MEM_ANALYTIC_MEMORY_HH__
+#define __MEM_ANALYTIC_MEMORY_HH__
+
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "mem/abstract_mem.hh"
+#include "mem/port.hh"
+#include "params/AnalyticMemory.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * A fast DRAM model for sampled simulation and fast-forwarding, placed
+ * between SimpleMemory and a MemCtrl with a DRAMInterface in accuracy.
+ * The latency of each request is estimated when it arrives from the
+ * open row of its bank and a queueing delay. The queueing delay follows
+ * an M/D/1 queue whose service time accounts for the row misses and
+ * the bank-level parallelism of the previous utilization window, so
+ * nothing but the response itself is scheduled.
+ */
+class AnalyticMemory : public AbstractMemory
+{
+  private:
+
+    /**
+     * A deferred packet stores a packet along with its scheduled
+     * transmission time
+     */
+    struct DeferredPacket
+    {
+        Tick tick;
+        PacketPtr pkt;
+    };
+
+    class MemoryPort : public ResponsePort
+    {
+      private:
+        AnalyticMemory &mem;
+
+      public:
+        MemoryPort(const std::string &_name, AnalyticMemory &_mem);
+
+      protected:
+        Tick recvAtomic(PacketPtr pkt) override;
+        void recvFunctional(PacketPtr pkt) override;
+        bool recvTimingReq(PacketPtr pkt) override;
+        void recvRespRetry() override;
+        AddrRangeList getAddrRanges() const override;
+    };
+
+    MemoryPort port;
+
+    const Tick frontendLatency;
+    const Tick backendLatency;
+    const Tick rowHitLatency;
+    const Tick rowMissLatency;
+    const unsigned burstSize;
+    const Tick burstTime;
+    const Addr rowBufferSize;
+    const unsigned numBanks;
+    const Tick window;
+    const double maxUtilization;
+    const double queueScale;
+
+    /** Open row of every bank, MaxAddr if the bank is closed. */
+    std::vector<Addr> openRow;
+
+    /** @{ */
+    /** Traffic seen in the current utilization window. */
+    Tick windowStart;
+    uint64_t windowBursts;
+    uint64_t windowMisses;
+    std::vector<bool> windowBankUsed;
+    unsigned windowBanks;
+    /** @} */
+
+    /** Queueing delay estimated from the previous window. */
+    Tick queueDelay;
+
+    /**
+     * Close the utilization window if it has expired and update the
+     * queueing delay from it. Idle windows are folded into the same
+     * update, so an idle memory costs nothing.
+     */
+    void updateWindow();
+
+    /**
+     * Estimate the latency of a request and update the model state.
+     *
+     * @param pkt the request
+     * @return the latency until the response is ready
+     */
+    Tick estimateLatency(PacketPtr pkt);
+
+    /** Responses waiting for their estimated latency to pass. */
+    std::list<DeferredPacket> packetQueue;
+
+    /** Remember if we failed to send a response. */
+    bool retryResp;
+
+    /** Send the response at the head of the queue. */
+    void dequeue();
+
+    EventFunctionWrapper dequeueEvent;
+
+    /**
+     * Upstream caches need this packet until true is returned, so
+     * hold it for deletion until a subsequent call
+     */
+    std::unique_ptr<Packet> pendingDelete;
+
+    struct AnalyticStats : public statistics::Group
+    {
+        AnalyticStats(AnalyticMemory &mem);
+
+        void regStats() override;
+
+        statistics::Scalar readBursts;
+        statistics::Scalar writeBursts;
+        statistics::Scalar rowHits;
+        statistics::Scalar rowMisses;
+        statistics::Formula rowHitRate;
+
+        statistics::Scalar windows;
+        statistics::Scalar totUtilization;
+        statistics::Scalar totBankParallelism;
+        statistics::Formula avgUtilization;
+        statistics::Formula avgBankParallelism;
+
+        statistics::Scalar readReqs;
+        statistics::Scalar totQueueLat;
+        statistics::Scalar totReadLat;
+        statistics::Formula avgQueueLat;
+        statistics::Formula avgReadLat;
+    };
+
+    AnalyticStats analyticStats;
+
+  public:
+
+    AnalyticMemory(const AnalyticMemoryParams &p);
+
+    DrainState drain() override;
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+    void init() override;
+
+  protected:
+    Tick recvAtomic(PacketPtr pkt);
+    void recvFunctional(PacketPtr pkt);
+    bool recvTimingReq(PacketPtr pkt);
+    void recvRespRetry();
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif //__MEM_ANALYTIC_MEMORY_HH__
@@ -42,6 +42,7 @@ from m5.SimObject import SimObject
 
 from m5.objects.ClockedObject import ClockedObject
 from m5.objects.Compressors import BaseCacheCompressor
+from m5.objects.PartitioningPolicies import BasePartitioningPolicy
 from m5.objects.Prefetcher import BasePrefetcher
 from m5.objects.ReplacementPolicies import *
 from m5.objects.Tags import *
@@ -105,6 +106,8 @@ class BaseCache(ClockedObject):
     tags = Param.BaseTags(BaseSetAssoc(), "Tag store")
     replacement_policy = Param.BaseReplacementPolicy(LRURP(),
         "Replacement policy")
+    partitioning_policy = Param.BasePartitioningPolicy(NULL,
+        "Policy restricting the ways each requestor may allocate into")
 
     compressor = Param.BaseCacheCompressor(NULL, "Cache compressor.")
     replace_expansions = Param.Bool(True, "Apply replacement policy to " \
@@ -118,6 +121,19 @@ class BaseCache(ClockedObject):
     sequential_access = Param.Bool(False,
         "Whether to access tags and data sequentially")
 
+    # Banking of the tag and data arrays. Accesses to a busy bank wait for
+    # it to become free. Without banks, the arrays have no conflicts.
+    tag_banks = Param.Unsigned(0,
+        "Number of tag array banks (0 to model no bank conflicts)")
+    data_banks = Param.Unsigned(0,
+        "Number of data array banks (0 to model no bank conflicts)")
+    bank_interleaving = Param.Unsigned(Parent.cache_line_size,
+        "Granularity of the address interleaving across banks, in bytes")
+    tag_bank_occupancy = Param.Cycles(1,
+        "Number of cycles a tag bank is busy per access")
+    data_bank_occupancy = Param.Cycles(1,
+        "Number of cycles a data bank is busy per access")
+
     cpu_side = ResponsePort("Upstream port closer to the CPU and/or device")
     mem_side = RequestPort("Downstream port closer to memory")
 
@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the reservations of a single bank of a banked array.
+ */
+
+#ifndef __MEM_CACHE_BANK_SCHEDULE_HH__
+#define __MEM_CACHE_BANK_SCHEDULE_HH__
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * The times a bank is reserved for, as a set of disjoint intervals.
+ * Accesses can be reserved ahead of time, e.g., the data array write
+ * of a fill that is still on its way, so an access only waits for the
+ * reservations it actually overlaps with and may use the bank before
+ * a later one.
+ */
+class BankSchedule
+{
+  private:
+    /** End of each reserved interval, indexed by its start. */
+    std::map<Tick, Tick> busy;
+
+  public:
+    /**
+     * Reserve the bank at the first time it is free for long enough.
+     *
+     * @param when The tick at which the access is ready to start.
+     * @param duration The number of ticks the access uses the bank.
+     * @return The tick at which the access starts.
+     */
+    Tick
+    reserve(Tick when, Tick duration)
+    {
+        Tick start = when;
+
+        // Skip past the interval we start in, if any, and then past
+        // the following ones until there is a large enough gap
+        auto it = busy.upper_bound(start);
+        if (it != busy.begin())
+            start = std::max(start, std::prev(it)->second);
+        for (; it != busy.end() && it->first < start + duration; ++it)
+            start = std::max(start, it->second);
+
+        busy.emplace(start, start + duration);
+        return start;
+    }
+
+    /**
+     * Forget the reservations that are over.
+     *
+     * @param now The current tick; no access is ready before it.
+     */
+    void
+    release(Tick now)
+    {
+        auto it = busy.begin();
+        while (it != busy.end() && it->second <= now)
+            it = busy.erase(it);
+    }
+
+    /** Number of reservations kept. */
+    size_t size() const { return busy.size(); }
+};
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_BANK_SCHEDULE_HH__
@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "mem/cache/bank_schedule.hh"
+
+using namespace gem5;
+
+/** Back-to-back accesses to a bank are serialized. */
+TEST(BankScheduleTest, Serialized)
+{
+    BankSchedule bank;
+    ASSERT_EQ(bank.reserve(0, 10), 0);
+    ASSERT_EQ(bank.reserve(0, 10), 10);
+    ASSERT_EQ(bank.reserve(5, 10), 20);
+    ASSERT_EQ(bank.reserve(40, 10), 40);
+}
+
+/** An access before a reservation made ahead of time does not wait. */
+TEST(BankScheduleTest, BeforeFutureReservation)
+{
+    BankSchedule bank;
+    ASSERT_EQ(bank.reserve(100, 10), 100);
+    ASSERT_EQ(bank.reserve(0, 10), 0);
+    // Exactly fills the gap up to the future reservation
+    ASSERT_EQ(bank.reserve(90, 10), 90);
+}
+
+/** An access that would overlap a future reservation goes after it. */
+TEST(BankScheduleTest, OverlapsFutureReservation)
+{
+    BankSchedule bank;
+    ASSERT_EQ(bank.reserve(100, 10), 100);
+    ASSERT_EQ(bank.reserve(95, 10), 110);
+    // The gap between two reservations is too small
+    ASSERT_EQ(bank.reserve(125, 10), 125);
+    ASSERT_EQ(bank.reserve(112, 10), 135);
+    // But is used when large enough
+    ASSERT_EQ(bank.reserve(0, 20), 0);
+    ASSERT_EQ(bank.reserve(50, 20), 50);
+}
+
+/** Reservations that are over are dropped. */
+TEST(BankScheduleTest, Release)
+{
+    BankSchedule bank;
+    bank.reserve(0, 10);
+    bank.reserve(20, 10);
+    bank.reserve(100, 10);
+    bank.release(25);
+    ASSERT_EQ(bank.size(), 2);
+    bank.release(30);
+    ASSERT_EQ(bank.size(), 1);
+    ASSERT_EQ(bank.reserve(30, 10), 30);
+}
@@ -123,6 +123,17 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
 
     tempBlock = new TempCacheBlk(blkSize);
 
+    if (p.tag_banks > 0) {
+        tagBanks.reset(new CacheBanks(*this, "tagBanks", p.tag_banks,
+                                      p.bank_interleaving,
+                                      p.tag_bank_occupancy));
+    }
+    if (p.data_banks > 0) {
+        dataBanks.reset(new CacheBanks(*this, "dataBanks", p.data_banks,
+                                       p.bank_interleaving,
+                                       p.data_bank_occupancy));
+    }
+
     tags->tagsInit();
     if (prefetcher)
         prefetcher->setCache(this);
@@ -245,7 +256,7 @@ BaseCache::handleTimingReqHit(PacketPtr pkt, CacheBlk *blk, Tick request_time)
             // Basically we need to get the MSHR in the same state as if
             // we had missed and just received the response.
             // Request *req2 = new Request(*(pkt->req));
-            RequestPtr req2 = std::make_shared<Request>(*(pkt->req));
+            RequestPtr req2 = Request::create(*(pkt->req));
             PacketPtr pkt2 = new Packet(req2, pkt->cmd);
             MSHR *mshr = allocateMissBuffer(pkt2, curTick(), true);
             // Mark the MSHR "in service" (even though it's not) to prevent
@@ -339,6 +350,11 @@ BaseCache::handleTimingReqMiss(PacketPtr pkt, MSHR *mshr, CacheBlk *blk,
                 assert(pkt->req->requestorId() < system->maxRequestors());
                 stats.cmdStats(pkt).mshrHits[pkt->req->requestorId()]++;
 
+                // A demand coalescing with an in-flight prefetch means
+                // the prefetch was useful, but issued too late
+                if (prefetcher && pkt->isDemand() && mshr->isPrefetch())
+                    prefetcher->prefetchLate();
+
                 // We use forward_time here because it is the same
                 // considering new targets. We have multiple
                 // requests for the same address here. It
@@ -363,7 +379,7 @@ BaseCache::handleTimingReqMiss(PacketPtr pkt, MSHR *mshr, CacheBlk *blk,
         assert(pkt->req->requestorId() < system->maxRequestors());
         stats.cmdStats(pkt).mshrMisses[pkt->req->requestorId()]++;
         if (prefetcher && pkt->isDemand())
-            prefetcher->incrDemandMhsrMisses();
+            prefetcher->incrDemandMhsrMisses(pkt->getBlockAddr(blkSize));
 
         if (pkt->isEviction() || pkt->cmd == MemCmd::WriteClean) {
             // We use forward_time here because there is an
@@ -1022,7 +1038,8 @@ BaseCache::updateCompressionData(CacheBlk *&blk, const uint64_t* data,
         CacheBlk *victim = nullptr;
         if (replaceExpansions || is_data_contraction) {
             victim = tags->findVictim(regenerateBlkAddr(blk),
-                blk->isSecure(), compression_size, evict_blks);
+                blk->isSecure(), compression_size, evict_blks,
+                blk->getSrcRequestorId());
 
             // It is valid to return nullptr if there is no victim
             if (!victim) {
@@ -1084,7 +1101,8 @@ BaseCache::updateCompressionData(CacheBlk *&blk, const uint64_t* data,
 }
 
 void
-BaseCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool)
+BaseCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool,
+                          const Packet *fill_pkt)
 {
     assert(pkt->isRequest());
 
@@ -1154,7 +1172,11 @@ BaseCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool)
 
         // all read responses have a data payload
         assert(pkt->hasRespData());
-        pkt->setDataFromBlock(blk->data, blkSize);
+        if (fill_pkt) {
+            pkt->shareDataFrom(fill_pkt);
+        } else {
+            pkt->setDataFromBlock(blk->data, blkSize);
+        }
     } else if (pkt->isUpgrade()) {
         // sanity check
         assert(!pkt->hasSharers());
@@ -1181,6 +1203,25 @@ BaseCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool)
 // Access path: requests coming in from the CPU side
 //
 /////////////////////////////////////////////////////
+Cycles
+BaseCache::calculateBankConflictLatency(CacheBanks *banks, const Addr addr,
+                                        const Tick when)
+{
+    // Atomic accesses do not overlap in time, so they cannot conflict
+    if (!banks || !system->isTimingMode()) {
+        return Cycles(0);
+    }
+    return banks->reserve(addr, when);
+}
+
+void
+BaseCache::occupyDataBank(const Addr addr, const Tick when)
+{
+    // The write is not on the critical path, so the wait is not charged
+    // to it, but the bank is busy for the accesses that follow
+    calculateBankConflictLatency(dataBanks.get(), addr, when);
+}
+
 Cycles
 BaseCache::calculateTagOnlyLatency(const uint32_t delay,
                                    const Cycles lookup_lat) const
@@ -1191,8 +1232,9 @@ BaseCache::calculateTagOnlyLatency(const uint32_t delay,
 }
 
 Cycles
-BaseCache::calculateAccessLatency(const CacheBlk* blk, const uint32_t delay,
-                                  const Cycles lookup_lat) const
+BaseCache::calculateAccessLatency(const CacheBlk* blk, const Addr addr,
+                                  const uint32_t delay,
+                                  const Cycles lookup_lat)
 {
     Cycles lat(0);
 
@@ -1206,6 +1248,13 @@ BaseCache::calculateAccessLatency(const CacheBlk* blk, const uint32_t delay,
             lat = ticksToCycles(delay) + std::max(lookup_lat, dataLatency);
         }
 
+        // Wait for the data bank, which is accessed after the tags when
+        // they are accessed sequentially. The wait for the tag bank is
+        // already part of the lookup latency.
+        lat += calculateBankConflictLatency(dataBanks.get(), addr,
+            curTick() + delay +
+            (sequentialAccess ? cyclesToTicks(lookup_lat) : 0));
+
         // Check if the block to be accessed is available. If not, apply the
         // access latency on top of when the block is ready to be accessed.
         const Tick tick = curTick() + delay;
@@ -1239,6 +1288,11 @@ BaseCache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
     Cycles tag_latency(0);
     blk = tags->accessBlock(pkt, tag_latency);
 
+    // Every access looks the tags up exactly once, so this is where its
+    // tag bank is reserved; any wait for it adds to the lookup latency
+    tag_latency += calculateBankConflictLatency(tagBanks.get(),
+        pkt->getAddr(), curTick() + pkt->headerDelay);
+
     DPRINTF(Cache, "%s for %s %s\n", __func__, pkt->print(),
             blk ? "hit " + blk->print() : "miss");
 
@@ -1365,6 +1419,7 @@ BaseCache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
         assert(!pkt->needsResponse());
 
         updateBlockData(blk, pkt, has_old_data);
+        occupyDataBank(pkt->getAddr(), curTick() + cyclesToTicks(lat));
         DPRINTF(Cache, "%s new state is %s\n", __func__, blk->print());
         incHitCount(pkt);
 
@@ -1440,6 +1495,7 @@ BaseCache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
         assert(!pkt->needsResponse());
 
         updateBlockData(blk, pkt, has_old_data);
+        occupyDataBank(pkt->getAddr(), curTick() + cyclesToTicks(lat));
         DPRINTF(Cache, "%s new state is %s\n", __func__, blk->print());
 
         incHitCount(pkt);
@@ -1460,7 +1516,8 @@ BaseCache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
 
         // Calculate access latency based on the need to access the data array
         if (pkt->isRead()) {
-            lat = calculateAccessLatency(blk, pkt->headerDelay, tag_latency);
+            lat = calculateAccessLatency(blk, pkt->getAddr(),
+                                         pkt->headerDelay, tag_latency);
 
             // When a block is compressed, it must first be decompressed
             // before being read. This adds to the access latency.
@@ -1469,6 +1526,10 @@ BaseCache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
             }
         } else {
             lat = calculateTagOnlyLatency(pkt->headerDelay, tag_latency);
+            if (pkt->isWrite()) {
+                occupyDataBank(pkt->getAddr(),
+                               curTick() + cyclesToTicks(lat));
+            }
         }
 
         satisfyRequest(pkt, blk);
@@ -1482,7 +1543,8 @@ BaseCache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
 
     incMissCount(pkt);
 
-    lat = calculateAccessLatency(blk, pkt->headerDelay, tag_latency);
+    lat = calculateAccessLatency(blk, pkt->getAddr(),
+                                 pkt->headerDelay, tag_latency);
 
     if (!blk && pkt->isLLSC() && pkt->isWrite()) {
         // complete miss on store conditional... just give up now
@@ -1593,6 +1655,8 @@ BaseCache::handleFill(PacketPtr pkt, CacheBlk *blk, PacketList &writebacks,
         assert(pkt->getSize() == blkSize);
 
         updateBlockData(blk, pkt, has_old_data);
+        occupyDataBank(addr, curTick() + pkt->headerDelay +
+                       pkt->payloadDelay);
     }
     // The block will be ready when the payload arrives and the fill is done
     blk->setWhenReady(clockEdge(fillLatency) + pkt->headerDelay +
@@ -1631,7 +1695,7 @@ BaseCache::allocateBlock(const PacketPtr pkt, PacketList &writebacks)
     // Find replacement victim
     std::vector<CacheBlk*> evict_blks;
     CacheBlk *victim = tags->findVictim(addr, is_secure, blk_size_bits,
-                                        evict_blks);
+                                        evict_blks, pkt->req->requestorId());
 
     // It is valid to return nullptr if there is no victim
     if (!victim)
@@ -1640,6 +1704,16 @@ BaseCache::allocateBlock(const PacketPtr pkt, PacketList &writebacks)
     // Print victim block's information
     DPRINTF(CacheRepl, "Replacement victim: %s\n", victim->print());
 
+    // Let the prefetcher know which blocks its fills displace, so that
+    // later demand misses on them can be accounted as pollution
+    if (prefetcher && pkt->cmd == MemCmd::HardPFResp) {
+        for (const auto& blk : evict_blks) {
+            if (blk->isValid()) {
+                prefetcher->prefetchEvicted(regenerateBlkAddr(blk));
+            }
+        }
+    }
+
     // Try to evict blocks; if it fails, give up on allocation
     if (!handleEvictions(evict_blks, writebacks)) {
         return nullptr;
@@ -1697,7 +1771,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 
     stats.writebacks[Request::wbRequestorId]++;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1740,7 +1814,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 PacketPtr
 BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure()) {
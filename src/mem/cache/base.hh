@@ -58,6 +58,7 @@
 #include "debug/Cache.hh"
 #include "debug/CachePort.hh"
 #include "enums/Clusivity.hh"
+#include "mem/cache/cache_banks.hh"
 #include "mem/cache/cache_blk.hh"
 #include "mem/cache/compressors/base.hh"
 #include "mem/cache/mshr_queue.hh"
@@ -458,12 +459,34 @@ class BaseCache : public ClockedObject
      */
     Addr regenerateBlkAddr(CacheBlk* blk);
 
+    /**
+     * Calculate the time an access waits for a bank of an array, and
+     * reserve the bank. Bank conflicts are only modeled in timing mode.
+     *
+     * @param banks The banks of the array, or nullptr if not banked.
+     * @param addr The address being accessed.
+     * @param when The tick at which the access is ready to start.
+     * @return The number of cycles waited for the bank.
+     */
+    Cycles calculateBankConflictLatency(CacheBanks *banks, const Addr addr,
+                                        const Tick when);
+
+    /**
+     * Keep the data bank of an address busy for a write to the data
+     * array, which is not on the critical path of the access.
+     *
+     * @param addr The address being written.
+     * @param when The tick at which the write is ready to start.
+     */
+    void occupyDataBank(const Addr addr, const Tick when);
+
     /**
      * Calculate latency of accesses that only touch the tag array.
      * @sa calculateAccessLatency
      *
      * @param delay The delay until the packet's metadata is present.
-     * @param lookup_lat Latency of the respective tag lookup.
+     * @param lookup_lat Latency of the respective tag lookup, including
+     *                   any wait for the tag bank.
      * @return The number of ticks that pass due to a tag-only access.
      */
     Cycles calculateTagOnlyLatency(const uint32_t delay,
@@ -473,12 +496,15 @@ class BaseCache : public ClockedObject
      * whether access was a hit or miss.
      *
      * @param blk The cache block that was accessed.
+     * @param addr The address being accessed.
      * @param delay The delay until the packet's metadata is present.
-     * @param lookup_lat Latency of the respective tag lookup.
+     * @param lookup_lat Latency of the respective tag lookup, including
+     *                   any wait for the tag bank.
      * @return The number of ticks that pass due to a block access.
      */
-    Cycles calculateAccessLatency(const CacheBlk* blk, const uint32_t delay,
-                                  const Cycles lookup_lat) const;
+    Cycles calculateAccessLatency(const CacheBlk* blk, const Addr addr,
+                                  const uint32_t delay,
+                                  const Cycles lookup_lat);
 
     /**
      * Does all the processing necessary to perform the provided request.
@@ -738,10 +764,15 @@ class BaseCache : public ClockedObject
      * @param blk Cache block that the packet hit
      * @param deferred_response Whether this request originally missed
      * @param pending_downgrade Whether the writable flag is to be removed
+     * @param fill_pkt Response that just filled the block, if the block
+     *                 still holds exactly its data; a read then shares
+     *                 the payload of the response instead of copying
+     *                 the block
      */
     virtual void satisfyRequest(PacketPtr pkt, CacheBlk *blk,
                                 bool deferred_response = false,
-                                bool pending_downgrade = false);
+                                bool pending_downgrade = false,
+                                const Packet *fill_pkt = nullptr);
 
     /**
      * Maintain the clusivity of this cache by potentially
@@ -921,6 +952,12 @@ class BaseCache : public ClockedObject
      */
     const bool sequentialAccess;
 
+    /** Banks of the tag array, or nullptr if it is not banked. */
+    std::unique_ptr<CacheBanks> tagBanks;
+
+    /** Banks of the data array, or nullptr if it is not banked. */
+    std::unique_ptr<CacheBanks> dataBanks;
+
     /** The number of targets for each MSHR. */
     const int numTarget;
 
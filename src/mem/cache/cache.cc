@@ -76,9 +76,10 @@ Cache::Cache(const CacheParams &p)
 
 void
 Cache::satisfyRequest(PacketPtr pkt, CacheBlk *blk,
-                      bool deferred_response, bool pending_downgrade)
+                      bool deferred_response, bool pending_downgrade,
+                      const Packet *fill_pkt)
 {
-    BaseCache::satisfyRequest(pkt, blk);
+    BaseCache::satisfyRequest(pkt, blk, false, false, fill_pkt);
 
     if (pkt->isRead()) {
         // determine if this read is from a (coherent) cache or not
@@ -378,10 +379,10 @@ Cache::handleTimingReqMiss(PacketPtr pkt, CacheBlk *blk, Tick forward_time,
 
         if (!mshr) {
             // copy the request and create a new SoftPFReq packet
-            RequestPtr req = std::make_shared<Request>(pkt->req->getPaddr(),
-                                                    pkt->req->getSize(),
-                                                    pkt->req->getFlags(),
-                                                    pkt->req->requestorId());
+            RequestPtr req = Request::create(pkt->req->getPaddr(),
+                                             pkt->req->getSize(),
+                                             pkt->req->getFlags(),
+                                             pkt->req->requestorId());
             pf = new Packet(req, pkt->cmd);
             pf->allocate();
             assert(pf->matchAddr(pkt));
@@ -714,6 +715,12 @@ Cache::serviceMSHRTargets(MSHR *mshr, const PacketPtr pkt, CacheBlk *blk)
         initial_tgt = nullptr;
     }
 
+    // As long as the block holds exactly the data the response filled
+    // it with, reads take a share of the response payload rather than
+    // a copy of the block
+    const Packet *fill_pkt =
+        !mshr->isForward && !is_error && pkt->isRead() ? pkt : nullptr;
+
     MSHR::TargetList targets = mshr->extractServiceableTargets(pkt);
     for (auto &target: targets) {
         Packet *tgt_pkt = target.pkt;
@@ -782,7 +789,14 @@ Cache::serviceMSHRTargets(MSHR *mshr, const PacketPtr pkt, CacheBlk *blk)
             // either); otherwise we use the packet data.
             if (blk && blk->isValid() &&
                 (!mshr->isForward || !pkt->hasData())) {
-                satisfyRequest(tgt_pkt, blk, true, mshr->hasPostDowngrade());
+                const bool is_read = tgt_pkt->isRead() &&
+                    !tgt_pkt->isWrite();
+                satisfyRequest(tgt_pkt, blk, true, mshr->hasPostDowngrade(),
+                               is_read ? fill_pkt : nullptr);
+                if (!is_read) {
+                    // the block may no longer match the response
+                    fill_pkt = nullptr;
+                }
 
                 // How many bytes past the first request is this one
                 int transfer_offset =
@@ -858,7 +872,7 @@ Cache::serviceMSHRTargets(MSHR *mshr, const PacketPtr pkt, CacheBlk *blk)
                         assert(pkt->matchAddr(tgt_pkt));
                         assert(pkt->getSize() >= tgt_pkt->getSize());
 
-                        tgt_pkt->setData(pkt->getConstPtr<uint8_t>());
+                        tgt_pkt->shareDataFrom(pkt);
                     } else {
                         // MSHR targets can read data either from the
                         // block or the response pkt. If we can't get data
@@ -963,7 +977,7 @@ Cache::cleanEvictBlk(CacheBlk *blk)
     assert(blk && blk->isValid() && !blk->isSet(CacheBlk::DirtyBit));
 
     // Creating a zero sized write, a message to the snoop filter
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
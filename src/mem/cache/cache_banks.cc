@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/cache_banks.hh"
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "sim/clocked_object.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+CacheBanks::CacheBanks(ClockedObject &_owner, const std::string &name,
+                       unsigned num_banks, unsigned interleaving,
+                       Cycles _occupancy)
+  : owner(_owner), interleavingBits(floorLog2(interleaving)),
+    occupancy(_occupancy), banks(num_banks),
+    stats(&_owner, name, num_banks)
+{
+    fatal_if(num_banks == 0, "%s must have at least one bank", name);
+    fatal_if(!isPowerOf2(interleaving),
+             "The bank interleaving of %s must be a power of 2", name);
+    fatal_if(occupancy == 0,
+             "The banks of %s must be busy for at least one cycle", name);
+}
+
+CacheBanks::BankStats::BankStats(statistics::Group *parent,
+                                 const std::string &name, unsigned num_banks)
+  : statistics::Group(parent, name.c_str()),
+    ADD_STAT(accesses, statistics::units::Count::get(),
+             "Number of accesses to each bank"),
+    ADD_STAT(conflicts, statistics::units::Count::get(),
+             "Number of accesses that found their bank busy"),
+    ADD_STAT(conflictRate, statistics::units::Ratio::get(),
+             "Fraction of the accesses that found their bank busy",
+             conflicts / accesses),
+    ADD_STAT(conflictCycles, statistics::units::Cycle::get(),
+             "Number of cycles spent waiting for busy banks"),
+    ADD_STAT(avgConflictCycles, statistics::units::Rate<
+                statistics::units::Cycle, statistics::units::Count>::get(),
+             "Average number of cycles waited by a conflicting access",
+             conflictCycles / statistics::sum(conflicts))
+{
+    accesses.init(num_banks);
+    conflicts.init(num_banks);
+    conflictRate.flags(statistics::nozero | statistics::nonan);
+    avgConflictCycles.flags(statistics::nozero | statistics::nonan);
+}
+
+Cycles
+CacheBanks::reserve(Addr addr, Tick when)
+{
+    const unsigned bank = getBank(addr);
+    stats.accesses[bank]++;
+
+    // Wait until the bank is free for long enough
+    banks[bank].release(curTick());
+    const Tick start =
+        banks[bank].reserve(when, owner.cyclesToTicks(occupancy));
+    const Cycles wait = owner.ticksToCycles(start - when);
+    if (wait > 0) {
+        stats.conflicts[bank]++;
+        stats.conflictCycles += wait;
+    }
+
+    return wait;
+}
+
+} // namespace gem5
@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a banked array contention model for the classic caches.
+ *
+ * The tag or data array of a cache can be split into banks, which the
+ * addresses are interleaved across. Each access keeps its bank busy for a
+ * number of cycles, and accesses that find their bank busy wait for it to
+ * become free, which serializes concurrent accesses to the same bank.
+ * Accesses may be reserved ahead of time; an access only waits for the
+ * reservations it overlaps with.
+ * This is the classic cache counterpart of Ruby's BankedArray, except
+ * that conflicts are turned into extra latency rather than retries.
+ */
+
+#ifndef __MEM_CACHE_CACHE_BANKS_HH__
+#define __MEM_CACHE_CACHE_BANKS_HH__
+
+#include <string>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/cache/bank_schedule.hh"
+
+namespace gem5
+{
+
+class ClockedObject;
+
+class CacheBanks
+{
+  private:
+    /** The cache the array belongs to, used for clocking. */
+    const ClockedObject &owner;
+
+    /** log2 of the interleaving granularity, in bytes. */
+    const unsigned interleavingBits;
+
+    /** Number of cycles a bank is busy per access. */
+    const Cycles occupancy;
+
+    /** Reservations of each bank. */
+    std::vector<BankSchedule> banks;
+
+    struct BankStats : public statistics::Group
+    {
+        BankStats(statistics::Group *parent, const std::string &name,
+                  unsigned num_banks);
+
+        /** Number of accesses to each bank. */
+        statistics::Vector accesses;
+        /** Number of accesses that found their bank busy. */
+        statistics::Vector conflicts;
+        /** Fraction of the accesses that found their bank busy. */
+        statistics::Formula conflictRate;
+        /** Number of cycles spent waiting for busy banks. */
+        statistics::Scalar conflictCycles;
+        /** Average number of cycles waited by a conflicting access. */
+        statistics::Formula avgConflictCycles;
+    } stats;
+
+  public:
+    /**
+     * @param _owner The cache the array belongs to.
+     * @param name Name of the array, used to group its stats.
+     * @param num_banks Number of banks of the array.
+     * @param interleaving Interleaving granularity, in bytes.
+     * @param _occupancy Number of cycles a bank is busy per access.
+     */
+    CacheBanks(ClockedObject &_owner, const std::string &name,
+               unsigned num_banks, unsigned interleaving, Cycles _occupancy);
+
+    /**
+     * Get the bank an address maps to.
+     *
+     * @param addr The address.
+     * @return The index of the bank.
+     */
+    unsigned
+    getBank(Addr addr) const
+    {
+        return (addr >> interleavingBits) % banks.size();
+    }
+
+    /**
+     * Reserve the bank of an address for an access, waiting for it to
+     * become free if it is busy at that time.
+     *
+     * @param addr The address being accessed.
+     * @param when The tick at which the access is ready to start.
+     * @return The number of cycles the access has to wait for the bank.
+     */
+    Cycles reserve(Addr addr, Tick when);
+};
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_CACHE_BANKS_HH__
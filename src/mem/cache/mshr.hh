@@ -323,6 +323,12 @@ class MSHR : public QueueEntry, public Printable
         return pkt->isClean();
     }
 
+    /** True if this MSHR was allocated by a hardware prefetch. */
+    bool isPrefetch() const {
+        return !targets.empty() &&
+            targets.front().source == Target::FromPrefetcher;
+    }
+
     bool isPendingModified() const {
         assert(inService); return pendingModified;
     }
@@ -67,13 +67,14 @@ NoncoherentCache::NoncoherentCache(const NoncoherentCacheParams &p)
 }
 
 void
-NoncoherentCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool)
+NoncoherentCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool,
+                                 const Packet *fill_pkt)
 {
     // As this a non-coherent cache located below the point of
     // coherency, we do not expect requests that are typically used to
     // keep caches coherent (e.g., InvalidateReq or UpdateReq).
     assert(pkt->isRead() || pkt->isWrite());
-    BaseCache::satisfyRequest(pkt, blk);
+    BaseCache::satisfyRequest(pkt, blk, false, false, fill_pkt);
 }
 
 bool
@@ -248,6 +249,12 @@ NoncoherentCache::serviceMSHRTargets(MSHR *mshr, const PacketPtr pkt,
     bool from_core = false;
     bool from_pref = false;
 
+    // As long as the block holds exactly the data the response filled
+    // it with, reads take a share of the response payload rather than
+    // a copy of the block
+    const Packet *fill_pkt = !mshr->isForward && !pkt->isError() &&
+        pkt->isRead() ? pkt : nullptr;
+
     MSHR::TargetList targets = mshr->extractServiceableTargets(pkt);
     for (auto &target: targets) {
         Packet *tgt_pkt = target.pkt;
@@ -264,7 +271,13 @@ NoncoherentCache::serviceMSHRTargets(MSHR *mshr, const PacketPtr pkt,
             // packet comes from it, charged on headerDelay.
             completion_time = pkt->headerDelay;
 
-            satisfyRequest(tgt_pkt, blk);
+            if (tgt_pkt->isRead() && !tgt_pkt->isWrite()) {
+                satisfyRequest(tgt_pkt, blk, false, false, fill_pkt);
+            } else {
+                satisfyRequest(tgt_pkt, blk);
+                // the block may no longer match the response
+                fill_pkt = nullptr;
+            }
 
             // How many bytes past the first request is this one
             int transfer_offset;
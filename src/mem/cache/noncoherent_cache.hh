@@ -108,7 +108,8 @@ class NoncoherentCache : public BaseCache
 
     void satisfyRequest(PacketPtr pkt, CacheBlk *blk,
                         bool deferred_response = false,
-                        bool pending_downgrade = false) override;
+                        bool pending_downgrade = false,
+                        const Packet *fill_pkt = nullptr) override;
 
     /*
      * Creates a new packet with the request to be send to the memory
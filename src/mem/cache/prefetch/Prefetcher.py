@@ -84,6 +84,39 @@ class BasePrefetcher(ClockedObject):
     page_bytes = Param.MemorySize('4KiB',
             "Size of pages for virtual addresses")
 
+    # Feedback-directed throttling. At the end of every interval the
+    # accuracy, lateness and pollution caused by the prefetcher are used to
+    # move it between aggressiveness levels. Level i (1-based) limits the
+    # number of prefetches per trigger to throttle_degrees[i-1] (0 means no
+    # limit) and moves them throttle_distances[i-1] steps further ahead of
+    # the triggering access. Prefetch issue is disabled when the lowest
+    # level is still inaccurate. Only queued prefetchers act on the level.
+    throttle_enable = Param.Bool(False,
+        "Enable feedback-directed prefetch throttling")
+    throttle_interval = Param.Unsigned(8192,
+        "Number of observed accesses per throttling interval")
+    throttle_accuracy_high = Param.Float(0.75,
+        "Accuracy at or above which the prefetcher is deemed accurate")
+    throttle_accuracy_low = Param.Float(0.40,
+        "Accuracy below which the prefetcher is deemed inaccurate")
+    throttle_lateness_threshold = Param.Float(0.01,
+        "Fraction of late useful prefetches above which issue is late")
+    throttle_pollution_threshold = Param.Float(0.005,
+        "Fraction of demand misses caused by prefetches above which the "
+        "prefetcher is deemed polluting")
+    throttle_disable_accuracy = Param.Float(0.05,
+        "Accuracy below which issue is disabled at the lowest level")
+    throttle_disable_intervals = Param.Unsigned(4,
+        "Number of intervals issue stays disabled before being retried")
+    throttle_degrees = VectorParam.Unsigned([1, 1, 2, 4, 0],
+        "Maximum prefetches per trigger of each level (0 means no limit)")
+    throttle_distances = VectorParam.Unsigned([0, 1, 2, 4, 8],
+        "Extra distance of each level, in steps of the first candidate")
+    throttle_initial_level = Param.Unsigned(3,
+        "Aggressiveness level at the start of the simulation")
+    throttle_pollution_filter_entries = Param.Unsigned(4096,
+        "Number of entries of the filter tracking prefetch evictions")
+
     def __init__(self, **kwargs):
         super().__init__(**kwargs)
         self._events = []
@@ -180,6 +213,54 @@ class StridePrefetcher(QueuedPrefetcher):
     table_replacement_policy = Param.BaseReplacementPolicy(RandomRP(),
         "Replacement policy of the PC table")
 
+class BertiPrefetcher(QueuedPrefetcher):
+    type = 'BertiPrefetcher'
+    cxx_class = 'gem5::prefetch::Berti'
+    cxx_header = "mem/cache/prefetch/berti.hh"
+
+    # Berti learns from every miss and from hits on prefetched blocks
+    prefetch_on_access = True
+    # Do not consult Berti on instruction accesses
+    on_inst = False
+
+    history_per_entry = Param.Unsigned(8,
+        "Number of accesses recorded per IP in the history table")
+    history_table_entries = Param.MemorySize("16",
+        "Number of entries of the history table")
+    history_table_assoc = Param.Unsigned(16,
+        "Associativity of the history table")
+    history_table_indexing_policy = Param.BaseIndexingPolicy(
+        SetAssociative(entry_size = 1, assoc = Parent.history_table_assoc,
+        size = Parent.history_table_entries),
+        "Indexing policy of the history table")
+    history_table_replacement_policy = Param.BaseReplacementPolicy(LRURP(),
+        "Replacement policy of the history table")
+
+    deltas_per_entry = Param.Unsigned(16,
+        "Number of deltas tracked per IP in the delta table")
+    delta_bits = Param.Unsigned(13, "Bits per delta, including the sign")
+    delta_table_entries = Param.MemorySize("16",
+        "Number of entries of the delta table")
+    delta_table_assoc = Param.Unsigned(16,
+        "Associativity of the delta table")
+    delta_table_indexing_policy = Param.BaseIndexingPolicy(
+        SetAssociative(entry_size = 1, assoc = Parent.delta_table_assoc,
+        size = Parent.delta_table_entries),
+        "Indexing policy of the delta table")
+    delta_table_replacement_policy = Param.BaseReplacementPolicy(FIFORP(),
+        "Replacement policy of the delta table")
+
+    searches_per_round = Param.Unsigned(16,
+        "Number of history searches after which deltas are classified")
+    high_coverage_threshold = Param.Percent(65,
+        "Coverage at or above which deltas are prefetched with high "
+        "confidence")
+    low_coverage_threshold = Param.Percent(35,
+        "Coverage at or above which deltas are prefetched with low "
+        "confidence")
+    max_pending_misses = Param.Unsigned(64,
+        "Maximum number of demand misses whose fill latency is tracked")
+
 class TaggedPrefetcher(QueuedPrefetcher):
     type = 'TaggedPrefetcher'
     cxx_class = 'gem5::prefetch::Tagged'
@@ -45,9 +45,12 @@
 
 #include "mem/cache/prefetch/base.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "base/intmath.hh"
+#include "base/trace.hh"
+#include "debug/HWPrefetch.hh"
 #include "mem/cache/base.hh"
 #include "params/BasePrefetcher.hh"
 #include "sim/system.hh"
@@ -101,12 +104,46 @@ Base::Base(const BasePrefetcherParams &p)
       pageBytes(p.page_bytes),
       prefetchOnAccess(p.prefetch_on_access),
       prefetchOnPfHit(p.prefetch_on_pf_hit),
-      useVirtualAddresses(p.use_virtual_addresses),
-      prefetchStats(this), issuedPrefetches(0),
+      useVirtualAddresses(p.use_virtual_addresses), throttle(p),
+      prefetchStats(this, throttle.numLevels()), issuedPrefetches(0),
       usefulPrefetches(0), tlb(nullptr)
 {
 }
 
+Base::Throttle::Throttle(const BasePrefetcherParams &p)
+  : enable(p.throttle_enable), interval(p.throttle_interval),
+    accuracyHigh(p.throttle_accuracy_high),
+    accuracyLow(p.throttle_accuracy_low),
+    latenessThreshold(p.throttle_lateness_threshold),
+    pollutionThreshold(p.throttle_pollution_threshold),
+    disableAccuracy(p.throttle_disable_accuracy),
+    disableIntervals(p.throttle_disable_intervals),
+    degrees(p.throttle_degrees), distances(p.throttle_distances),
+    level(p.throttle_initial_level), disabledFor(0),
+    accesses(0), issued(0), useful(0), late(0), demandMisses(0),
+    polluting(0), accuracy(0), lateness(0), pollution(0),
+    pollutionFilter(p.throttle_pollution_filter_entries, false)
+{
+    fatal_if(degrees.empty(), "At least one throttling level is needed");
+    fatal_if(degrees.size() != distances.size(),
+        "The throttling degrees and distances must have the same size");
+    fatal_if(level < 1 || level > degrees.size(),
+        "The initial throttling level must be within [1, %d]",
+        degrees.size());
+    fatal_if(accuracyLow > accuracyHigh,
+        "The low accuracy threshold must not exceed the high one");
+    fatal_if(enable && interval == 0,
+        "The throttling interval must be greater than 0");
+    fatal_if(pollutionFilter.empty(),
+        "The pollution filter must have at least one entry");
+}
+
+size_t
+Base::Throttle::filterIndex(Addr blk_index) const
+{
+    return (blk_index ^ (blk_index >> 12)) % pollutionFilter.size();
+}
+
 void
 Base::setCache(BaseCache *_cache)
 {
@@ -118,7 +155,8 @@ Base::setCache(BaseCache *_cache)
     lBlkSize = floorLog2(blkSize);
 }
 
-Base::StatGroup::StatGroup(statistics::Group *parent)
+Base::StatGroup::StatGroup(statistics::Group *parent,
+                           unsigned num_throttle_levels)
   : statistics::Group(parent),
     ADD_STAT(demandMshrMisses, statistics::units::Count::get(),
         "demands not covered by prefetchs"),
@@ -142,7 +180,18 @@ Base::StatGroup::StatGroup(statistics::Group *parent)
     ADD_STAT(pfHitInWB, statistics::units::Count::get(),
         "number of prefetches hit in the Write Buffer"),
     ADD_STAT(pfLate, statistics::units::Count::get(),
-        "number of late prefetches (hitting in cache, MSHR or WB)")
+        "number of late prefetches (hitting in cache, MSHR or WB)"),
+    ADD_STAT(pfUsefulLate, statistics::units::Count::get(),
+        "number of demands hitting on an in-flight prefetch"),
+    ADD_STAT(pfPollution, statistics::units::Count::get(),
+        "number of demand misses on blocks evicted by prefetches"),
+    ADD_STAT(throttleLevelIntervals, statistics::units::Count::get(),
+        "number of throttling intervals spent at each level (0 means "
+        "prefetch issue disabled)"),
+    ADD_STAT(throttleIncrements, statistics::units::Count::get(),
+        "number of times the throttling level was increased"),
+    ADD_STAT(throttleDecrements, statistics::units::Count::get(),
+        "number of times the throttling level was decreased")
 {
     using namespace statistics;
 
@@ -155,6 +204,109 @@ Base::StatGroup::StatGroup(statistics::Group *parent)
     coverage = pfUseful / (pfUseful + demandMshrMisses);
 
     pfLate = pfHitInCache + pfHitInMSHR + pfHitInWB;
+
+    pfUsefulLate.flags(nozero);
+    pfPollution.flags(nozero);
+    throttleLevelIntervals.init(num_throttle_levels + 1).flags(nozero);
+    throttleIncrements.flags(nozero);
+    throttleDecrements.flags(nozero);
+}
+
+void
+Base::incrDemandMhsrMisses(Addr blk_addr)
+{
+    prefetchStats.demandMshrMisses++;
+
+    if (!throttle.enable)
+        return;
+
+    throttle.demandMisses++;
+    const size_t idx = throttle.filterIndex(blockIndex(blk_addr));
+    if (throttle.pollutionFilter[idx]) {
+        throttle.pollutionFilter[idx] = false;
+        throttle.polluting++;
+        prefetchStats.pfPollution++;
+    }
+}
+
+void
+Base::prefetchEvicted(Addr blk_addr)
+{
+    if (throttle.enable) {
+        throttle.pollutionFilter[throttle.filterIndex(blockIndex(blk_addr))] =
+            true;
+    }
+}
+
+void
+Base::updateThrottle()
+{
+    // Fold the interval feedback into the running metrics, giving the
+    // last interval the same weight as the whole history
+    const uint64_t useful = throttle.useful + throttle.late;
+    const double accuracy = throttle.issued ?
+        std::min(1.0, double(useful) / throttle.issued) : throttle.accuracy;
+    const double lateness = useful ?
+        double(throttle.late) / useful : throttle.lateness;
+    const double pollution = throttle.demandMisses ?
+        double(throttle.polluting) / throttle.demandMisses :
+        throttle.pollution;
+    throttle.accuracy = (throttle.accuracy + accuracy) / 2;
+    throttle.lateness = (throttle.lateness + lateness) / 2;
+    throttle.pollution = (throttle.pollution + pollution) / 2;
+
+    throttle.accesses = 0;
+    throttle.issued = 0;
+    throttle.useful = 0;
+    throttle.late = 0;
+    throttle.demandMisses = 0;
+    throttle.polluting = 0;
+
+    prefetchStats.throttleLevelIntervals[throttle.level]++;
+
+    if (throttle.level == 0) {
+        // Nothing is issued while disabled, so there is no feedback to
+        // act on. Probe again at the lowest level after a while.
+        if (++throttle.disabledFor >= throttle.disableIntervals) {
+            throttle.disabledFor = 0;
+            throttle.level = 1;
+            throttle.accuracy = throttle.accuracyLow;
+            prefetchStats.throttleIncrements++;
+            DPRINTF(HWPrefetch, "Throttle: re-enabling prefetch issue\n");
+        }
+        return;
+    }
+
+    const bool late = throttle.lateness > throttle.latenessThreshold;
+    const bool polluting = throttle.pollution > throttle.pollutionThreshold;
+
+    // Decision table of feedback-directed prefetching: +1 increments the
+    // level, -1 decrements it and 0 leaves it unchanged
+    int delta = 0;
+    if (throttle.accuracy >= throttle.accuracyHigh) {
+        delta = late ? 1 : (polluting ? -1 : 0);
+    } else if (throttle.accuracy >= throttle.accuracyLow) {
+        delta = late ? (polluting ? -1 : 1) : (polluting ? -1 : 0);
+    } else {
+        delta = (late || polluting) ? -1 : 0;
+    }
+
+    if (delta > 0 && throttle.level < throttle.numLevels()) {
+        throttle.level++;
+        prefetchStats.throttleIncrements++;
+    } else if (delta < 0 && throttle.level > 1) {
+        throttle.level--;
+        prefetchStats.throttleDecrements++;
+    } else if (throttle.level == 1 &&
+               throttle.accuracy < throttle.disableAccuracy) {
+        // Even the least aggressive level is wasting bandwidth
+        throttle.level = 0;
+        prefetchStats.throttleDecrements++;
+    }
+
+    DPRINTF(HWPrefetch, "Throttle: accuracy %.3f lateness %.3f pollution "
+            "%.3f, level %d\n", throttle.accuracy, throttle.lateness,
+            throttle.pollution, throttle.level);
 }
 
 bool
@@ -251,8 +403,13 @@ Base::probeNotify(const PacketPtr &pkt, bool miss)
         panic("Request must have a physical address");
     }
 
+    if (throttle.enable && ++throttle.accesses >= throttle.interval) {
+        updateThrottle();
+    }
+
     if (hasBeenPrefetched(pkt->getAddr(), pkt->isSecure())) {
         usefulPrefetches += 1;
+        throttle.useful++;
         prefetchStats.pfUseful++;
         if (miss)
             // This case happens when a demand hits on a prefetched line
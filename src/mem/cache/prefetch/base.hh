@@ -47,6 +47,7 @@
 #define __MEM_CACHE_PREFETCH_BASE_HH__
 
 #include <cstdint>
+#include <vector>
 
 #include "arch/generic/tlb.hh"
 #include "base/compiler.hh"
@@ -301,6 +302,71 @@ class Base : public ClockedObject
     /** Use Virtual Addresses for prefetching */
     const bool useVirtualAddresses;
 
+    /**
+     * Feedback-directed throttling (Srinath et al., HPCA'07). The
+     * controller samples accuracy, lateness and cache pollution over
+     * fixed intervals of observed accesses and moves the prefetcher
+     * between aggressiveness levels. Each level caps the number of
+     * candidates issued per trigger (degree) and pushes the candidates
+     * further ahead of the triggering access (distance). Level 0 means
+     * that prefetch issue is disabled.
+     */
+    struct Throttle
+    {
+        /** Whether the throttling controller is active */
+        const bool enable;
+        /** Number of observed accesses per interval */
+        const unsigned interval;
+        /** Accuracy at or above which the prefetcher is accurate */
+        const double accuracyHigh;
+        /** Accuracy below which the prefetcher is inaccurate */
+        const double accuracyLow;
+        /** Fraction of useful prefetches that may arrive late */
+        const double latenessThreshold;
+        /** Fraction of demand misses that may be caused by prefetches */
+        const double pollutionThreshold;
+        /** Accuracy below which issue is disabled at the lowest level */
+        const double disableAccuracy;
+        /** Intervals spent disabled before issue is re-enabled */
+        const unsigned disableIntervals;
+        /** Maximum degree of each level, 0 meaning unlimited */
+        const std::vector<unsigned> degrees;
+        /** Extra distance of each level, in multiples of the lead delta */
+        const std::vector<unsigned> distances;
+
+        /** Current aggressiveness level, 0 when issue is disabled */
+        unsigned level;
+        /** Number of consecutive intervals spent disabled */
+        unsigned disabledFor;
+
+        /** Feedback collected during the current interval */
+        uint64_t accesses;
+        uint64_t issued;
+        uint64_t useful;
+        uint64_t late;
+        uint64_t demandMisses;
+        uint64_t polluting;
+
+        /** Running metrics, halved on every interval boundary */
+        double accuracy;
+        double lateness;
+        double pollution;
+
+        /**
+         * Filter of the block addresses evicted by prefetch fills. A
+         * demand miss on one of those addresses is counted as pollution.
+         */
+        std::vector<bool> pollutionFilter;
+
+        Throttle(const BasePrefetcherParams &p);
+
+        /** Number of aggressiveness levels, not counting level 0 */
+        unsigned numLevels() const { return degrees.size(); }
+
+        /** Index of an address in the pollution filter */
+        size_t filterIndex(Addr blk_index) const;
+    } throttle;
+
     /**
      * Determine if this access should be observed
      * @param pkt The memory request causing the event
@@ -330,7 +396,7 @@ class Base : public ClockedObject
     Addr pageIthBlockAddress(Addr page, uint32_t i) const;
     struct StatGroup : public statistics::Group
     {
-        StatGroup(statistics::Group *parent);
+        StatGroup(statistics::Group *parent, unsigned num_throttle_levels);
         statistics::Scalar demandMshrMisses;
         statistics::Scalar pfIssued;
         /** The number of times a HW-prefetched block is evicted w/o
@@ -357,6 +423,19 @@ class Base : public ClockedObject
         /** The number of times a HW-prefetch is late
          * (hit in cache, MSHR, WB). */
         statistics::Formula pfLate;
+
+        /** The number of demands that hit on an in-flight prefetch. */
+        statistics::Scalar pfUsefulLate;
+
+        /** The number of demand misses on blocks evicted by prefetches. */
+        statistics::Scalar pfPollution;
+
+        /** The number of throttling intervals spent at each level. */
+        statistics::Vector throttleLevelIntervals;
+
+        /** The number of throttling level changes. */
+        statistics::Scalar throttleIncrements;
+        statistics::Scalar throttleDecrements;
     } prefetchStats;
 
     /** Total prefetches issued */
@@ -367,6 +446,48 @@ class Base : public ClockedObject
     /** Registered tlb for address translations */
     BaseTLB * tlb;
 
+    /**
+     * Closes the current throttling interval: updates the running
+     * metrics from the interval feedback and moves the aggressiveness
+     * level accordingly.
+     */
+    void updateThrottle();
+
+    /**
+     * Whether the throttling controller currently allows prefetches to
+     * be issued.
+     */
+    bool
+    throttleIssueEnabled() const
+    {
+        return !throttle.enable || throttle.level > 0;
+    }
+
+    /**
+     * Maximum number of prefetches that can be generated per trigger at
+     * the current throttling level.
+     * @return the maximum degree, 0 if unlimited
+     */
+    unsigned
+    throttleDegree() const
+    {
+        if (!throttle.enable || throttle.level == 0)
+            return 0;
+        return throttle.degrees[throttle.level - 1];
+    }
+
+    /**
+     * Extra distance at the current throttling level, expressed in
+     * multiples of the delta between the trigger and the first candidate.
+     */
+    unsigned
+    throttleDistance() const
+    {
+        if (!throttle.enable || throttle.level == 0)
+            return 0;
+        return throttle.distances[throttle.level - 1];
+    }
+
   public:
     Base(const BasePrefetcherParams &p);
     virtual ~Base() = default;
@@ -393,12 +514,29 @@ class Base : public ClockedObject
         prefetchStats.pfUnused++;
     }
 
+    /**
+     * Notify the prefetcher of a demand miss that allocated a new MSHR.
+     * @param blk_addr block address of the demand miss
+     */
+    void incrDemandMhsrMisses(Addr blk_addr);
+
+    /**
+     * Notify the prefetcher that a demand hit on an in-flight prefetch,
+     * i.e., the prefetch was useful but late.
+     */
     void
-    incrDemandMhsrMisses()
+    prefetchLate()
     {
-        prefetchStats.demandMshrMisses++;
+        prefetchStats.pfUsefulLate++;
+        throttle.late++;
     }
 
+    /**
+     * Notify the prefetcher that a prefetch fill evicted a block.
+     * @param blk_addr block address of the evicted block
+     */
+    void prefetchEvicted(Addr blk_addr);
+
     void
     pfHitInCache()
     {
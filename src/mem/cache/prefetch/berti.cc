@@ -0,0 +1,294 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/prefetch/berti.hh"
+
+#include <algorithm>
+
+#include "base/trace.hh"
+#include "debug/HWPrefetch.hh"
+#include "mem/cache/prefetch/associative_set_impl.hh"
+#include "params/BertiPrefetcher.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Prefetcher, prefetch);
+namespace prefetch
+{
+
+Berti::Berti(const BertiPrefetcherParams &p)
+  : Queued(p), historyPerEntry(p.history_per_entry),
+    deltasPerEntry(p.deltas_per_entry),
+    maxDelta((int64_t(1) << (p.delta_bits - 1)) - 1),
+    searchesPerRound(p.searches_per_round),
+    highCoverageThreshold(p.high_coverage_threshold),
+    lowCoverageThreshold(p.low_coverage_threshold),
+    maxPendingMisses(p.max_pending_misses),
+    historyTable(p.history_table_assoc, p.history_table_entries,
+                 p.history_table_indexing_policy,
+                 p.history_table_replacement_policy,
+                 HistoryEntry(historyPerEntry)),
+    deltaTable(p.delta_table_assoc, p.delta_table_entries,
+               p.delta_table_indexing_policy,
+               p.delta_table_replacement_policy),
+    avgFillLatency(0), statsBerti(this)
+{
+    fatal_if(p.delta_bits < 2 || p.delta_bits > 32,
+        "The number of bits of a delta must be within [2, 32]");
+    fatal_if(searchesPerRound == 0,
+        "There must be at least one search per learning round");
+    fatal_if(lowCoverageThreshold > highCoverageThreshold,
+        "The low coverage threshold must not exceed the high one");
+    fatal_if(maxPendingMisses == 0,
+        "At least one pending demand miss must be tracked");
+}
+
+Berti::BertiStats::BertiStats(statistics::Group *parent)
+  : statistics::Group(parent),
+    ADD_STAT(searches, statistics::units::Count::get(),
+             "number of searches for timely deltas"),
+    ADD_STAT(timelyDeltas, statistics::units::Count::get(),
+             "number of deltas found that would have been timely"),
+    ADD_STAT(lateDeltas, statistics::units::Count::get(),
+             "number of deltas found that would have been late"),
+    ADD_STAT(highConfidenceDeltas, statistics::units::Count::get(),
+             "number of deltas selected with high confidence"),
+    ADD_STAT(lowConfidenceDeltas, statistics::units::Count::get(),
+             "number of deltas selected with low confidence"),
+    ADD_STAT(deltaCoverage, statistics::units::Ratio::get(),
+             "coverage of the deltas at the end of each learning round "
+             "(percent)"),
+    ADD_STAT(demandFillLatency, statistics::units::Cycle::get(),
+             "fill latency of the demand misses")
+{
+    deltaCoverage.init(0, 100, 10);
+    demandFillLatency.init(16);
+}
+
+void
+Berti::recordAccess(Addr pc, Addr blk_index, Tick time)
+{
+    HistoryEntry *entry = historyTable.findEntry(pc, false /* unused */);
+    if (entry != nullptr) {
+        historyTable.accessEntry(entry);
+    } else {
+        entry = historyTable.findVictim(pc);
+        historyTable.insertEntry(pc, false /* unused */, entry);
+    }
+
+    // Consecutive accesses to the same block do not add new deltas
+    if (!entry->accesses.empty() &&
+        entry->accesses.back().blkIndex == blk_index) {
+        return;
+    }
+    entry->accesses.push_back(AccessRecord{blk_index, time});
+}
+
+void
+Berti::countDelta(DeltaEntry &entry, int64_t delta)
+{
+    for (DeltaInfo &info : entry.deltas) {
+        if (info.delta == delta) {
+            info.counter++;
+            return;
+        }
+    }
+
+    if (entry.deltas.size() < deltasPerEntry) {
+        entry.deltas.push_back(DeltaInfo{delta, 1, DeltaStatus::NoPrefetch});
+        return;
+    }
+
+    // Replace the least counted delta that is not being prefetched
+    auto victim = entry.deltas.end();
+    for (auto it = entry.deltas.begin(); it != entry.deltas.end(); it++) {
+        if (it->status == DeltaStatus::NoPrefetch &&
+            (victim == entry.deltas.end() || it->counter < victim->counter)) {
+            victim = it;
+        }
+    }
+    if (victim != entry.deltas.end()) {
+        *victim = DeltaInfo{delta, 1, DeltaStatus::NoPrefetch};
+    }
+}
+
+void
+Berti::selectDeltas(DeltaEntry &entry)
+{
+    for (DeltaInfo &info : entry.deltas) {
+        const unsigned coverage = (100 * info.counter) / entry.searches;
+        statsBerti.deltaCoverage.sample(coverage);
+        if (coverage >= highCoverageThreshold) {
+            info.status = DeltaStatus::HighConfidence;
+            statsBerti.highConfidenceDeltas++;
+        } else if (coverage >= lowCoverageThreshold) {
+            info.status = DeltaStatus::LowConfidence;
+            statsBerti.lowConfidenceDeltas++;
+        } else {
+            info.status = DeltaStatus::NoPrefetch;
+        }
+        DPRINTF(HWPrefetch, "Berti: delta %d coverage %d%%\n", info.delta,
+                coverage);
+        info.counter = 0;
+    }
+    entry.searches = 0;
+}
+
+void
+Berti::learn(Addr pc, Addr blk_index, Tick time, Tick latency)
+{
+    HistoryEntry *history = historyTable.findEntry(pc, false /* unused */);
+    if (history == nullptr) {
+        return;
+    }
+
+    DeltaEntry *entry = deltaTable.findEntry(pc, false /* unused */);
+    if (entry != nullptr) {
+        deltaTable.accessEntry(entry);
+    } else {
+        entry = deltaTable.findVictim(pc);
+        deltaTable.insertEntry(pc, false /* unused */, entry);
+    }
+
+    entry->searches++;
+    statsBerti.searches++;
+
+    // Only the accesses that happened at least one fill latency before
+    // the access being learned could have prefetched it in time. Each
+    // delta is counted at most once per search.
+    std::vector<int64_t> found;
+    for (const AccessRecord &record : history->accesses) {
+        if (record.time >= time) {
+            continue;
+        }
+        const int64_t delta = int64_t(blk_index - record.blkIndex);
+        if (delta == 0 || delta > maxDelta || delta < -maxDelta) {
+            continue;
+        }
+        if (record.time + latency > time) {
+            statsBerti.lateDeltas++;
+            continue;
+        }
+        if (std::find(found.begin(), found.end(), delta) != found.end()) {
+            continue;
+        }
+        found.push_back(delta);
+        statsBerti.timelyDeltas++;
+        countDelta(*entry, delta);
+    }
+
+    if (entry->searches >= searchesPerRound) {
+        selectDeltas(*entry);
+    }
+}
+
+void
+Berti::notifyFill(const PacketPtr &pkt)
+{
+    const Addr blk_addr = pkt->getBlockAddr(blkSize);
+    auto it = std::find_if(pendingMisses.begin(), pendingMisses.end(),
+        [blk_addr, &pkt](const PendingMiss &miss) {
+            return miss.blkAddr == blk_addr && miss.secure == pkt->isSecure();
+        });
+    if (it == pendingMisses.end()) {
+        return;
+    }
+
+    const Tick latency = curTick() - it->time;
+    avgFillLatency = avgFillLatency == 0 ? latency :
+        (7 * avgFillLatency + latency) / 8;
+    statsBerti.demandFillLatency.sample(ticksToCycles(latency));
+
+    learn(it->pc, it->blkIndex, it->time, latency);
+    pendingMisses.erase(it);
+}
+
+void
+Berti::calculatePrefetch(const PrefetchInfo &pfi,
+                         std::vector<AddrPriority> &addresses)
+{
+    if (!pfi.hasPC()) {
+        DPRINTF(HWPrefetch, "Ignoring request with no PC.\n");
+        return;
+    }
+
+    const Addr pc = pfi.getPC();
+    const Addr blk_index = blockIndex(pfi.getAddr());
+    const Tick now = curTick();
+
+    if (pfi.isCacheMiss()) {
+        // Secondary misses are filled along with the first one
+        const Addr blk_addr = blockAddress(pfi.getPaddr());
+        const bool pending = std::any_of(pendingMisses.begin(),
+            pendingMisses.end(), [blk_addr, &pfi](const PendingMiss &miss) {
+                return miss.blkAddr == blk_addr &&
+                    miss.secure == pfi.isSecure();
+            });
+        if (!pending) {
+            if (pendingMisses.size() == maxPendingMisses) {
+                pendingMisses.pop_front();
+            }
+            pendingMisses.push_back(PendingMiss{blk_addr, pfi.isSecure(),
+                pc, blk_index, now});
+        }
+        recordAccess(pc, blk_index, now);
+    } else if (hasBeenPrefetched(pfi.getPaddr(), pfi.isSecure())) {
+        // Without prefetching this hit would have been a miss, so learn
+        // from it using the typical fill latency
+        if (avgFillLatency != 0) {
+            learn(pc, blk_index, now, avgFillLatency);
+        }
+        recordAccess(pc, blk_index, now);
+    }
+
+    DeltaEntry *entry = deltaTable.findEntry(pc, false /* unused */);
+    if (entry == nullptr) {
+        return;
+    }
+
+    // Generate the high confidence candidates first, so that they are
+    // kept when the number of prefetches is limited
+    for (DeltaStatus status : {DeltaStatus::HighConfidence,
+                               DeltaStatus::LowConfidence}) {
+        for (const DeltaInfo &info : entry->deltas) {
+            if (info.status != status) {
+                continue;
+            }
+            if (info.delta < 0 && blk_index < Addr(-info.delta)) {
+                continue;
+            }
+            const Addr pf_addr = (blk_index + info.delta) << lBlkSize;
+            addresses.push_back(AddrPriority(pf_addr,
+                status == DeltaStatus::HighConfidence ? 1 : 0));
+        }
+    }
+}
+
+} // namespace prefetch
+} // namespace gem5
@@ -0,0 +1,256 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Implementation of the Berti prefetcher
+ * Reference:
+ *   Berti: an Accurate Local-Delta Data Prefetcher.
+ *   Agustín Navarro-Torres, Biswabandan Panda, Jesús Alastruey-Benedé,
+ *   Pablo Ibáñez, Víctor Viñals-Yúfera and Alberto Ros. 2022.
+ *   In 55th IEEE/ACM International Symposium on Microarchitecture (MICRO'22)
+ *
+ * Berti learns, for each instruction pointer, the deltas that would have
+ * brought a missing line in time. When a demand miss is filled, its fill
+ * latency is used to look back in the history of accesses of the same IP:
+ * only the accesses that happened at least that long before the miss could
+ * have triggered a timely prefetch, and the deltas to them are counted.
+ * Periodically, the deltas are classified by their coverage, and the ones
+ * covering enough misses are used to prefetch on every access of the IP.
+ *
+ * Berti also selects deltas to prefetch into the L2; here low-confidence
+ * deltas are instead issued into the same cache with a lower priority.
+ */
+
+#ifndef __MEM_CACHE_PREFETCH_BERTI_HH__
+#define __MEM_CACHE_PREFETCH_BERTI_HH__
+
+#include <list>
+#include <vector>
+
+#include "base/circular_queue.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/cache/prefetch/associative_set.hh"
+#include "mem/cache/prefetch/queued.hh"
+#include "mem/packet.hh"
+
+namespace gem5
+{
+
+struct BertiPrefetcherParams;
+
+GEM5_DEPRECATED_NAMESPACE(Prefetcher, prefetch);
+namespace prefetch
+{
+
+class Berti : public Queued
+{
+  protected:
+    /** Classification of a delta after a learning round */
+    enum class DeltaStatus
+    {
+        /** Not enough coverage to prefetch */
+        NoPrefetch,
+        /** Medium coverage, prefetched with a low priority */
+        LowConfidence,
+        /** High coverage, prefetched with a high priority */
+        HighConfidence
+    };
+
+    /** A demand access recorded in the history of an IP */
+    struct AccessRecord
+    {
+        /** Block index of the accessed address */
+        Addr blkIndex;
+        /** Time of the access */
+        Tick time;
+    };
+
+    /** History table entry, holding the recent accesses of an IP */
+    struct HistoryEntry : public TaggedEntry
+    {
+        CircularQueue<AccessRecord> accesses;
+
+        HistoryEntry(unsigned num_accesses)
+          : TaggedEntry(), accesses(num_accesses)
+        {}
+
+        void
+        invalidate() override
+        {
+            TaggedEntry::invalidate();
+            accesses.flush();
+        }
+    };
+
+    /** A delta learned for an IP */
+    struct DeltaInfo
+    {
+        /** Distance in blocks from the triggering access */
+        int64_t delta;
+        /** Number of timely occurrences in the current round */
+        unsigned counter;
+        /** Classification given in the last learning round */
+        DeltaStatus status;
+    };
+
+    /** Delta table entry, holding the deltas learned for an IP */
+    struct DeltaEntry : public TaggedEntry
+    {
+        std::vector<DeltaInfo> deltas;
+        /** Number of searches performed in the current round */
+        unsigned searches;
+
+        DeltaEntry() : TaggedEntry(), searches(0) {}
+
+        void
+        invalidate() override
+        {
+            TaggedEntry::invalidate();
+            deltas.clear();
+            searches = 0;
+        }
+    };
+
+    /** A demand miss whose fill has not been observed yet */
+    struct PendingMiss
+    {
+        /** Physical block address of the miss */
+        Addr blkAddr;
+        /** Whether the miss targets the secure memory space */
+        bool secure;
+        /** IP of the missing access */
+        Addr pc;
+        /** Block index used for training */
+        Addr blkIndex;
+        /** Time of the missing access */
+        Tick time;
+    };
+
+    /** Number of accesses recorded per IP */
+    const unsigned historyPerEntry;
+
+    /** Maximum number of deltas tracked per IP */
+    const unsigned deltasPerEntry;
+
+    /** Largest delta, in blocks, that can be learned */
+    const int64_t maxDelta;
+
+    /** Number of searches after which deltas are classified */
+    const unsigned searchesPerRound;
+
+    /** Coverage, in percent, of high-confidence deltas */
+    const unsigned highCoverageThreshold;
+
+    /** Coverage, in percent, of low-confidence deltas */
+    const unsigned lowCoverageThreshold;
+
+    /** Maximum number of demand misses waiting for their fill */
+    const unsigned maxPendingMisses;
+
+    /** Recent accesses of each IP */
+    AssociativeSet<HistoryEntry> historyTable;
+
+    /** Deltas learned for each IP */
+    AssociativeSet<DeltaEntry> deltaTable;
+
+    /** Demand misses waiting for their fill, oldest first */
+    std::list<PendingMiss> pendingMisses;
+
+    /**
+     * Running average of the demand fill latency, used to learn from hits
+     * on prefetched blocks, whose fill latency is not known.
+     */
+    Tick avgFillLatency;
+
+    struct BertiStats : public statistics::Group
+    {
+        BertiStats(statistics::Group *parent);
+
+        /** Number of searches in the history table */
+        statistics::Scalar searches;
+        /** Number of deltas found that would have been timely */
+        statistics::Scalar timelyDeltas;
+        /** Number of deltas found that would have been late */
+        statistics::Scalar lateDeltas;
+        /** Number of deltas selected with each confidence */
+        statistics::Scalar highConfidenceDeltas;
+        statistics::Scalar lowConfidenceDeltas;
+        /** Coverage of the deltas at the end of each round, in percent */
+        statistics::Distribution deltaCoverage;
+        /** Fill latency of the demand misses, in cycles */
+        statistics::Histogram demandFillLatency;
+    } statsBerti;
+
+    /**
+     * Records a demand access in the history of its IP.
+     * @param pc IP of the access
+     * @param blk_index block index of the access
+     * @param time time of the access
+     */
+    void recordAccess(Addr pc, Addr blk_index, Tick time);
+
+    /**
+     * Searches the history of an IP for the accesses that would have
+     * prefetched the provided block in time, and counts their deltas.
+     * @param pc IP of the access to learn from
+     * @param blk_index block index of the access to learn from
+     * @param time time of the access to learn from
+     * @param latency time needed to bring the block into the cache
+     */
+    void learn(Addr pc, Addr blk_index, Tick time, Tick latency);
+
+    /**
+     * Counts an occurrence of a delta, allocating it if needed.
+     * @param entry delta table entry of the IP
+     * @param delta delta to count
+     */
+    void countDelta(DeltaEntry &entry, int64_t delta);
+
+    /**
+     * Classifies the deltas of an entry by their coverage in the round
+     * that has just finished, and starts a new round.
+     * @param entry delta table entry of the IP
+     */
+    void selectDeltas(DeltaEntry &entry);
+
+  public:
+    Berti(const BertiPrefetcherParams &p);
+    ~Berti() = default;
+
+    void calculatePrefetch(const PrefetchInfo &pfi,
+                           std::vector<AddrPriority> &addresses) override;
+
+    /** Learns from the fill latency of demand misses */
+    void notifyFill(const PacketPtr &pkt) override;
+};
+
+} // namespace prefetch
+} // namespace gem5
+
+#endif // __MEM_CACHE_PREFETCH_BERTI_HH__
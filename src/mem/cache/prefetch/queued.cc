@@ -61,8 +61,7 @@ Queued::DeferredPacket::createPkt(Addr paddr, unsigned blk_size,
                                             bool tag_prefetch,
                                             Tick t) {
     /* Create a prefetch memory request */
-    RequestPtr req = std::make_shared<Request>(paddr, blk_size,
-                                                0, requestor_id);
+    RequestPtr req = Request::create(paddr, blk_size, 0, requestor_id);
 
     if (pfInfo.isSecure()) {
         req->setFlags(Request::SECURE);
@@ -169,6 +168,36 @@ Queued::getMaxPermittedPrefetches(size_t total) const
     return max_pfs;
 }
 
+void
+Queued::applyThrottle(const PrefetchInfo &pfi,
+                      std::vector<AddrPriority> &addresses)
+{
+    if (addresses.empty())
+        return;
+
+    if (!throttleIssueEnabled()) {
+        statsQueued.pfThrottled += addresses.size();
+        addresses.clear();
+        return;
+    }
+
+    const unsigned degree = throttleDegree();
+    if (degree != 0 && addresses.size() > degree) {
+        statsQueued.pfThrottled += addresses.size() - degree;
+        addresses.resize(degree);
+    }
+
+    const unsigned distance = throttleDistance();
+    if (distance != 0) {
+        // Use the first candidate to find the direction and step of the
+        // prefetcher for this trigger
+        const Addr lead_delta = addresses.front().first - pfi.getAddr();
+        for (AddrPriority& addr_prio : addresses) {
+            addr_prio.first += lead_delta * distance;
+        }
+    }
+}
+
 void
 Queued::notify(const PacketPtr &pkt, const PrefetchInfo &pfi)
 {
@@ -198,6 +227,11 @@ Queued::notify(const PacketPtr &pkt, const PrefetchInfo &pfi)
     std::vector<AddrPriority> addresses;
     calculatePrefetch(pfi, addresses);
 
+    // Adjust the candidates to the current aggressiveness level
+    if (throttle.enable) {
+        applyThrottle(pfi, addresses);
+    }
+
     // Get the maximu number of prefetches that we are allowed to generate
     size_t max_pfs = getMaxPermittedPrefetches(addresses.size());
 
@@ -255,6 +289,7 @@ Queued::getPacket()
 
     prefetchStats.pfIssued++;
     issuedPrefetches += 1;
+    throttle.issued++;
     assert(pkt != nullptr);
     DPRINTF(HWPrefetch, "Generating prefetch for %#x.\n", pkt->getAddr());
 
@@ -278,8 +313,12 @@ Queued::QueuedStats::QueuedStats(statistics::Group *parent)
     ADD_STAT(pfSpanPage, statistics::units::Count::get(),
              "number of prefetches that crossed the page"),
     ADD_STAT(pfUsefulSpanPage, statistics::units::Count::get(),
-             "number of prefetches that is useful and crossed the page")
+             "number of prefetches that is useful and crossed the page"),
+    ADD_STAT(pfThrottled, statistics::units::Count::get(),
+             "number of prefetch candidates dropped by the throttling "
+             "controller")
 {
+    pfThrottled.flags(statistics::nozero);
 }
 
 
@@ -374,7 +413,7 @@ RequestPtr
 Queued::createPrefetchRequest(Addr addr, PrefetchInfo const &pfi,
                                         PacketPtr pkt)
 {
-    RequestPtr translation_req = std::make_shared<Request>(
+    RequestPtr translation_req = Request::create(
             addr, blkSize, pkt->req->getFlags(), requestorId, pfi.getPC(),
             pkt->req->contextId());
     translation_req->setFlags(Request::PREFETCH);
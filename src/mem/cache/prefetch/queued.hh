@@ -186,6 +186,7 @@ class Queued : public Base
         statistics::Scalar pfRemovedFull;
         statistics::Scalar pfSpanPage;
         statistics::Scalar pfUsefulSpanPage;
+        statistics::Scalar pfThrottled;
     } statsQueued;
   public:
     using AddrPriority = std::pair<Addr, int32_t>;
@@ -256,6 +257,17 @@ class Queued : public Base
      */
     size_t getMaxPermittedPrefetches(size_t total) const;
 
+    /**
+     * Applies the degree and distance of the current throttling level to
+     * the prefetch candidates. Candidates are moved away from the trigger
+     * address by a multiple of the delta between the trigger and the first
+     * candidate, and the candidates in excess of the degree are dropped.
+     * @param pfi the access that triggered the prefetches
+     * @param addresses the prefetch candidates, modified in place
+     */
+    void applyThrottle(const PrefetchInfo &pfi,
+                       std::vector<AddrPriority> &addresses);
+
     RequestPtr createPrefetchRequest(Addr addr, PrefetchInfo const &pfi,
                                         PacketPtr pkt);
 };
@@ -139,6 +139,43 @@ class SHiPPCRP(SHiPRP):
     cxx_class = 'gem5::replacement_policy::SHiPPC'
     cxx_header = "mem/cache/replacement_policies/ship_rp.hh"
 
+class HawkeyeRP(BRRIPRP):
+    type = 'HawkeyeRP'
+    cxx_class = 'gem5::replacement_policy::Hawkeye'
+    cxx_header = "mem/cache/replacement_policies/hawkeye_rp.hh"
+
+    cache_size = Param.MemorySize(Parent.size, "Size of the cache")
+    assoc = Param.Int(Parent.assoc, "Associativity of the cache")
+    block_size = Param.Int(Parent.cache_line_size, "Block size in bytes")
+    num_sampled_sets = Param.Unsigned(64,
+        "Number of sets observed by OPTgen")
+    history_multiplier = Param.Unsigned(8,
+        "Length of the OPTgen history, in multiples of the associativity")
+    predictor_size = Param.Unsigned(2048, "Number of predictor entries")
+    predictor_bits = Param.Unsigned(3, "Number of bits per predictor entry")
+    # Cache-averse lines are inserted with the maximum RRPV
+    num_bits = 3
+    # Let the predictor decide the insertion RRPV
+    btp = 0
+
+class MockingjayRP(BaseReplacementPolicy):
+    type = 'MockingjayRP'
+    cxx_class = 'gem5::replacement_policy::Mockingjay'
+    cxx_header = "mem/cache/replacement_policies/mockingjay_rp.hh"
+
+    cache_size = Param.MemorySize(Parent.size, "Size of the cache")
+    assoc = Param.Int(Parent.assoc, "Associativity of the cache")
+    block_size = Param.Int(Parent.cache_line_size, "Block size in bytes")
+    num_sampled_sets = Param.Unsigned(64,
+        "Number of sets used to train the reuse distance predictor")
+    history_multiplier = Param.Unsigned(8,
+        "Length of the sampled history, in multiples of the associativity")
+    rdp_size = Param.Unsigned(2048,
+        "Number of reuse distance predictor entries")
+    granularity = Param.Unsigned(8,
+        "Number of set accesses represented by one unit of the estimated "
+        "time of reuse")
+
 class TreePLRURP(BaseReplacementPolicy):
     type = 'TreePLRURP'
     cxx_class = 'gem5::replacement_policy::TreePLRU'
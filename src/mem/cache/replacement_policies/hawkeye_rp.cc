@@ -0,0 +1,259 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/replacement_policies/hawkeye_rp.hh"
+
+#include <cassert>
+#include <memory>
+
+#include "base/logging.hh"
+#include "params/HawkeyeRP.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+Hawkeye::Hawkeye(const Params &p)
+  : BRRIP(p),
+    sampler(p.cache_size, p.assoc, p.block_size, p.num_sampled_sets,
+            p.history_multiplier * p.assoc),
+    optgen(sampler.getNumSampledSets(),
+           OPTgen(p.assoc, p.history_multiplier * p.assoc)),
+    friendlyThreshold(1 << (p.predictor_bits - 1)),
+    predictor(p.predictor_size,
+              SatCounter8(p.predictor_bits, friendlyThreshold)),
+    stats(this)
+{
+    fatal_if(p.predictor_bits == 0 || p.predictor_bits > 8,
+             "The predictor counters must have between 1 and 8 bits");
+    fatal_if(p.predictor_size == 0, "The predictor must have entries");
+    fatal_if(p.history_multiplier == 0,
+             "The OPTgen history must cover at least one access per way");
+}
+
+Hawkeye::HawkeyeStats::HawkeyeStats(statistics::Group *parent)
+  : statistics::Group(parent),
+    ADD_STAT(optHits, statistics::units::Count::get(),
+             "Number of sampled reuses on which OPT would have hit"),
+    ADD_STAT(optMisses, statistics::units::Count::get(),
+             "Number of sampled reuses on which OPT would have missed"),
+    ADD_STAT(correctPredictions, statistics::units::Count::get(),
+             "Number of predictions matching the OPT decision"),
+    ADD_STAT(incorrectPredictions, statistics::units::Count::get(),
+             "Number of predictions not matching the OPT decision"),
+    ADD_STAT(accuracy, statistics::units::Ratio::get(),
+             "Fraction of predictions matching the OPT decision",
+             correctPredictions / (correctPredictions + incorrectPredictions)),
+    ADD_STAT(friendlyAccesses, statistics::units::Count::get(),
+             "Number of accesses predicted as cache-friendly"),
+    ADD_STAT(averseAccesses, statistics::units::Count::get(),
+             "Number of accesses predicted as cache-averse"),
+    ADD_STAT(friendlyEvictions, statistics::units::Count::get(),
+             "Number of evictions of lines predicted as cache-friendly")
+{
+}
+
+Hawkeye::SignatureType
+Hawkeye::getSignature(const PacketPtr pkt) const
+{
+    SignatureType signature;
+
+    if (pkt->req->hasPC()) {
+        signature = static_cast<SignatureType>(pkt->req->getPC());
+    } else {
+        signature = NO_PC_SIGNATURE;
+    }
+
+    return signature % predictor.size();
+}
+
+bool
+Hawkeye::isFriendly(SignatureType signature) const
+{
+    return predictor[signature] >= friendlyThreshold;
+}
+
+void
+Hawkeye::train(SignatureType signature, bool opt_hit)
+{
+    if (isFriendly(signature) == opt_hit) {
+        stats.correctPredictions++;
+    } else {
+        stats.incorrectPredictions++;
+    }
+
+    if (opt_hit) {
+        stats.optHits++;
+        predictor[signature]++;
+    } else {
+        stats.optMisses++;
+        predictor[signature]--;
+    }
+}
+
+void
+Hawkeye::sample(const PacketPtr pkt, SignatureType signature)
+{
+    const int sampled_set = sampler.sampledSet(pkt->getAddr());
+    if (sampled_set < 0) {
+        return;
+    }
+    OPTgen &set_optgen = optgen[sampled_set];
+
+    SetSampler::Entry *entry = sampler.find(sampled_set, pkt->getAddr());
+    if (entry != nullptr) {
+        // The line is reused: learn whether OPT would have kept it
+        train(entry->signature, set_optgen.shouldCache(entry->lastTime));
+    } else {
+        // Lines that leave the sampler are reused too far away to be kept
+        SetSampler::Entry evicted;
+        entry = &sampler.allocate(sampled_set, pkt->getAddr(), evicted);
+        if (evicted.valid) {
+            train(evicted.signature, false);
+        }
+    }
+
+    entry->lastTime = set_optgen.access();
+    entry->signature = signature;
+}
+
+void
+Hawkeye::update(const std::shared_ptr<ReplacementData>& replacement_data,
+                const PacketPtr pkt)
+{
+    std::shared_ptr<HawkeyeReplData> casted_replacement_data =
+        std::static_pointer_cast<HawkeyeReplData>(replacement_data);
+
+    const SignatureType signature = getSignature(pkt);
+    sample(pkt, signature);
+
+    casted_replacement_data->signature = signature;
+    if (isFriendly(signature)) {
+        stats.friendlyAccesses++;
+        casted_replacement_data->rrpv.reset();
+    } else {
+        stats.averseAccesses++;
+        casted_replacement_data->rrpv.saturate();
+    }
+}
+
+void
+Hawkeye::touch(const std::shared_ptr<ReplacementData>& replacement_data,
+    const PacketPtr pkt)
+{
+    update(replacement_data, pkt);
+}
+
+void
+Hawkeye::touch(const std::shared_ptr<ReplacementData>& replacement_data)
+    const
+{
+    panic("Cant train Hawkeye's predictor without access information.");
+}
+
+void
+Hawkeye::reset(const std::shared_ptr<ReplacementData>& replacement_data,
+    const PacketPtr pkt)
+{
+    update(replacement_data, pkt);
+
+    // Mark entry as ready to be used
+    std::static_pointer_cast<HawkeyeReplData>(replacement_data)->valid = true;
+}
+
+void
+Hawkeye::reset(const std::shared_ptr<ReplacementData>& replacement_data)
+    const
+{
+    panic("Cant train Hawkeye's predictor without access information.");
+}
+
+ReplaceableEntry*
+Hawkeye::getVictim(const ReplacementCandidates& candidates) const
+{
+    // There must be at least one replacement candidate
+    assert(candidates.size() > 0);
+
+    // Use first candidate as dummy victim
+    ReplaceableEntry* victim = candidates[0];
+    int victim_RRPV = std::static_pointer_cast<HawkeyeReplData>(
+                        victim->replacementData)->rrpv;
+
+    // Visit all candidates to find victim
+    for (const auto& candidate : candidates) {
+        std::shared_ptr<HawkeyeReplData> candidate_repl_data =
+            std::static_pointer_cast<HawkeyeReplData>(
+                candidate->replacementData);
+
+        // Stop searching for victims if an invalid entry is found
+        if (!candidate_repl_data->valid) {
+            return candidate;
+        }
+
+        // Update victim entry if necessary
+        int candidate_RRPV = candidate_repl_data->rrpv;
+        if (candidate_RRPV > victim_RRPV) {
+            victim = candidate;
+            victim_RRPV = candidate_RRPV;
+        }
+    }
+
+    // If every line is cache-friendly, the predictor was wrong about the
+    // oldest one
+    const int max_RRPV = (1 << numRRPVBits) - 1;
+    if (victim_RRPV < max_RRPV) {
+        stats.friendlyEvictions++;
+        predictor[std::static_pointer_cast<HawkeyeReplData>(
+            victim->replacementData)->signature]--;
+    }
+
+    // Age the remaining cache-friendly lines, without making them averse
+    for (const auto& candidate : candidates) {
+        std::shared_ptr<HawkeyeReplData> candidate_repl_data =
+            std::static_pointer_cast<HawkeyeReplData>(
+                candidate->replacementData);
+        if (candidate != victim && candidate_repl_data->rrpv < max_RRPV - 1) {
+            candidate_repl_data->rrpv++;
+        }
+    }
+
+    return victim;
+}
+
+std::shared_ptr<ReplacementData>
+Hawkeye::instantiateEntry()
+{
+    return std::shared_ptr<ReplacementData>(
+        new HawkeyeReplData(numRRPVBits));
+}
+
+} // namespace replacement_policy
+} // namespace gem5
@@ -0,0 +1,220 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the Hawkeye replacement policy, as described in "Back to
+ * the Future: Leveraging Belady's Algorithm for Improved Cache
+ * Replacement", by Jain and Lin.
+ *
+ * Hawkeye reconstructs the decisions of Belady's optimal policy (OPT) on a
+ * few sampled sets with OPTgen, and uses them to train a PC-indexed
+ * predictor: every time a line of a sampled set is reused, the PC of its
+ * previous access learns whether OPT would have kept it cached. Lines
+ * brought or accessed by cache-friendly PCs are inserted with an RRPV of 0,
+ * and lines of cache-averse PCs with the maximum RRPV, making them the
+ * first to be evicted.
+ *
+ * When no cache-averse line is available, the friendly line with the
+ * highest RRPV is evicted and its PC is detrained. Friendly lines are aged
+ * on every eviction rather than on every friendly insertion, since the
+ * replacement interface does not provide the whole set on insertion.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_HAWKEYE_RP_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_HAWKEYE_RP_HH__
+
+#include <cstddef>
+#include <vector>
+
+#include "base/sat_counter.hh"
+#include "base/statistics.hh"
+#include "mem/cache/replacement_policies/brrip_rp.hh"
+#include "mem/cache/replacement_policies/optgen.hh"
+#include "mem/cache/replacement_policies/set_sampler.hh"
+#include "mem/packet.hh"
+
+namespace gem5
+{
+
+struct HawkeyeRPParams;
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+class Hawkeye : public BRRIP
+{
+  protected:
+    typedef std::size_t SignatureType;
+
+    /** Hawkeye-specific implementation of replacement data. */
+    struct HawkeyeReplData : BRRIPReplData
+    {
+        /** Signature of the last access to this entry. */
+        SignatureType signature;
+
+        HawkeyeReplData(const int num_bits)
+          : BRRIPReplData(num_bits), signature(0)
+        {
+        }
+    };
+
+    /** Observed sets and their recently accessed lines. */
+    SetSampler sampler;
+
+    /** OPT decisions of each sampled set. */
+    std::vector<OPTgen> optgen;
+
+    /** Counter value from which a signature is cache-friendly. */
+    const unsigned friendlyThreshold;
+
+    /**
+     * PC-indexed predictor of the OPT decisions. Mutable because evicting
+     * a line predicted as cache-friendly detrains its signature.
+     */
+    mutable std::vector<SatCounter8> predictor;
+
+    /** Signature used for accesses without a PC. */
+    const SignatureType NO_PC_SIGNATURE = 0;
+
+    /**
+     * Extract the signature of an access.
+     *
+     * @param pkt The packet of the access.
+     * @return The signature extracted.
+     */
+    SignatureType getSignature(const PacketPtr pkt) const;
+
+    /**
+     * Whether lines of a signature are predicted as cache-friendly.
+     *
+     * @param signature The signature.
+     * @return True if cache-friendly, false if cache-averse.
+     */
+    bool isFriendly(SignatureType signature) const;
+
+    /**
+     * Train the predictor with an OPT decision.
+     *
+     * @param signature The signature of the access that brought the line.
+     * @param opt_hit Whether OPT would have kept the line cached.
+     */
+    void train(SignatureType signature, bool opt_hit);
+
+    /**
+     * Observe an access in OPTgen, if it belongs to a sampled set.
+     *
+     * @param pkt The packet of the access.
+     * @param signature The signature of the access.
+     */
+    void sample(const PacketPtr pkt, SignatureType signature);
+
+    /**
+     * Update the replacement data of an accessed or inserted entry with
+     * the prediction for the access.
+     *
+     * @param replacement_data Replacement data of the entry.
+     * @param pkt The packet of the access.
+     */
+    void update(const std::shared_ptr<ReplacementData>& replacement_data,
+                const PacketPtr pkt);
+
+    struct HawkeyeStats : public statistics::Group
+    {
+        HawkeyeStats(statistics::Group *parent);
+
+        /** Sampled reuses on which OPT would have hit or missed. */
+        statistics::Scalar optHits;
+        statistics::Scalar optMisses;
+        /** Predictions that did or did not match the OPT decision. */
+        statistics::Scalar correctPredictions;
+        statistics::Scalar incorrectPredictions;
+        statistics::Formula accuracy;
+        /** Accesses predicted as cache-friendly or cache-averse. */
+        statistics::Scalar friendlyAccesses;
+        statistics::Scalar averseAccesses;
+        /** Evictions of lines predicted as cache-friendly. */
+        statistics::Scalar friendlyEvictions;
+    };
+
+    /** Mutable because evictions are accounted in getVictim(). */
+    mutable HawkeyeStats stats;
+
+  public:
+    typedef HawkeyeRPParams Params;
+    Hawkeye(const Params &p);
+    ~Hawkeye() = default;
+
+    /**
+     * Touch an entry to update its replacement data.
+     * Trains OPTgen and sets the RRPV from the prediction for the PC.
+     *
+     * @param replacement_data Replacement data to be touched.
+     * @param pkt Packet that generated this hit.
+     */
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data,
+        const PacketPtr pkt) override;
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+        override;
+
+    /**
+     * Reset replacement data. Used when an entry is inserted.
+     * Trains OPTgen and sets the RRPV from the prediction for the PC.
+     *
+     * @param replacement_data Replacement data to be reset.
+     * @param pkt Packet that generated this miss.
+     */
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data,
+        const PacketPtr pkt) override;
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+        override;
+
+    /**
+     * Find replacement victim among candidates. Cache-averse lines are
+     * evicted first; otherwise the oldest friendly line is evicted and its
+     * signature detrained.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
+    /**
+     * Instantiate a replacement data entry.
+     *
+     * @return A shared pointer to the new replacement data.
+     */
+    std::shared_ptr<ReplacementData> instantiateEntry() override;
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_HAWKEYE_RP_HH__
@@ -0,0 +1,272 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/replacement_policies/mockingjay_rp.hh"
+
+#include <cassert>
+#include <cstdlib>
+#include <memory>
+
+#include "base/logging.hh"
+#include "params/MockingjayRP.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+Mockingjay::Mockingjay(const Params &p)
+  : Base(p), historyLength(p.history_multiplier * p.assoc),
+    infiniteRD(p.history_multiplier * p.assoc + 1),
+    granularity(p.granularity),
+    sampler(p.cache_size, p.assoc, p.block_size, p.num_sampled_sets,
+            p.history_multiplier * p.assoc),
+    clocks(sampler.getNumSets(), 0), rdpValid(p.rdp_size, false),
+    rdp(p.rdp_size, 0), stats(this)
+{
+    fatal_if(p.rdp_size == 0, "The RDP must have entries");
+    fatal_if(p.history_multiplier == 0,
+             "The sampled history must cover at least one access per way");
+    fatal_if(granularity == 0, "The ETR granularity must be positive");
+}
+
+Mockingjay::MockingjayStats::MockingjayStats(statistics::Group *parent)
+  : statistics::Group(parent),
+    ADD_STAT(correctPredictions, statistics::units::Count::get(),
+             "Number of sampled reuses whose predicted reuse distance was "
+             "on the same side of the history length as the observed one"),
+    ADD_STAT(incorrectPredictions, statistics::units::Count::get(),
+             "Number of sampled reuses whose predicted reuse distance was "
+             "on the other side of the history length"),
+    ADD_STAT(accuracy, statistics::units::Ratio::get(),
+             "Fraction of correct reuse distance predictions",
+             correctPredictions / (correctPredictions + incorrectPredictions)),
+    ADD_STAT(finiteReuses, statistics::units::Count::get(),
+             "Number of correctly predicted finite reuse distances"),
+    ADD_STAT(absoluteError, statistics::units::Count::get(),
+             "Sum of the absolute errors of finite reuse distance "
+             "predictions, in set accesses"),
+    ADD_STAT(avgAbsoluteError, statistics::units::Rate<
+                statistics::units::Count, statistics::units::Count>::get(),
+             "Average absolute error of finite reuse distance predictions",
+             absoluteError / finiteReuses),
+    ADD_STAT(infinitePredictions, statistics::units::Count::get(),
+             "Number of accesses predicted as never reused"),
+    ADD_STAT(overdueEvictions, statistics::units::Count::get(),
+             "Number of victims whose predicted reuse was overdue")
+{
+}
+
+Mockingjay::SignatureType
+Mockingjay::getSignature(const PacketPtr pkt) const
+{
+    SignatureType signature;
+
+    if (pkt->req->hasPC()) {
+        signature = static_cast<SignatureType>(pkt->req->getPC());
+    } else {
+        signature = NO_PC_SIGNATURE;
+    }
+
+    return signature % rdp.size();
+}
+
+uint64_t
+Mockingjay::predict(SignatureType signature) const
+{
+    // Untrained signatures are expected to be reused immediately, so
+    // their lines age as in LRU until the RDP learns otherwise
+    return rdpValid[signature] ? rdp[signature] : 0;
+}
+
+void
+Mockingjay::train(SignatureType signature, uint64_t reuse_distance)
+{
+    const uint64_t predicted = predict(signature);
+    const bool predicted_reused = predicted < historyLength;
+    const bool reused = reuse_distance < historyLength;
+    if (predicted_reused == reused) {
+        stats.correctPredictions++;
+        if (reused) {
+            stats.finiteReuses++;
+            stats.absoluteError += (predicted > reuse_distance) ?
+                predicted - reuse_distance : reuse_distance - predicted;
+        }
+    } else {
+        stats.incorrectPredictions++;
+    }
+
+    if (rdpValid[signature]) {
+        rdp[signature] = (rdp[signature] + reuse_distance) / 2;
+    } else {
+        rdp[signature] = reuse_distance;
+        rdpValid[signature] = true;
+    }
+}
+
+void
+Mockingjay::sample(const PacketPtr pkt, SignatureType signature,
+                   uint64_t time)
+{
+    const int sampled_set = sampler.sampledSet(pkt->getAddr());
+    if (sampled_set < 0) {
+        return;
+    }
+
+    SetSampler::Entry *entry = sampler.find(sampled_set, pkt->getAddr());
+    if (entry != nullptr) {
+        const uint64_t reuse_distance = time - entry->lastTime;
+        train(entry->signature, (reuse_distance < historyLength) ?
+            reuse_distance : infiniteRD);
+    } else {
+        // Lines that leave the sampler are reused too far away to be kept
+        SetSampler::Entry evicted;
+        entry = &sampler.allocate(sampled_set, pkt->getAddr(), evicted);
+        if (evicted.valid) {
+            train(evicted.signature, infiniteRD);
+        }
+    }
+
+    entry->lastTime = time;
+    entry->signature = signature;
+}
+
+void
+Mockingjay::update(const std::shared_ptr<ReplacementData>& replacement_data,
+                   const PacketPtr pkt)
+{
+    std::shared_ptr<MockingjayReplData> casted_replacement_data =
+        std::static_pointer_cast<MockingjayReplData>(replacement_data);
+
+    const unsigned set = sampler.setIndex(pkt->getAddr());
+    const uint64_t time = ++clocks[set];
+    const SignatureType signature = getSignature(pkt);
+    sample(pkt, signature, time);
+
+    casted_replacement_data->set = set;
+    casted_replacement_data->lastTime = time;
+    casted_replacement_data->predictedRD = predict(signature);
+    if (casted_replacement_data->predictedRD >= historyLength) {
+        stats.infinitePredictions++;
+    }
+}
+
+int64_t
+Mockingjay::getETR(const MockingjayReplData &repl_data) const
+{
+    const uint64_t age = clocks[repl_data.set] - repl_data.lastTime;
+    return (int64_t(repl_data.predictedRD) - int64_t(age)) / granularity;
+}
+
+void
+Mockingjay::invalidate(
+    const std::shared_ptr<ReplacementData>& replacement_data)
+{
+    std::static_pointer_cast<MockingjayReplData>(
+        replacement_data)->valid = false;
+}
+
+void
+Mockingjay::touch(const std::shared_ptr<ReplacementData>& replacement_data,
+    const PacketPtr pkt)
+{
+    update(replacement_data, pkt);
+}
+
+void
+Mockingjay::touch(const std::shared_ptr<ReplacementData>& replacement_data)
+    const
+{
+    panic("Cant train Mockingjay's predictor without access information.");
+}
+
+void
+Mockingjay::reset(const std::shared_ptr<ReplacementData>& replacement_data,
+    const PacketPtr pkt)
+{
+    update(replacement_data, pkt);
+
+    // Mark entry as ready to be used
+    std::static_pointer_cast<MockingjayReplData>(
+        replacement_data)->valid = true;
+}
+
+void
+Mockingjay::reset(const std::shared_ptr<ReplacementData>& replacement_data)
+    const
+{
+    panic("Cant train Mockingjay's predictor without access information.");
+}
+
+ReplaceableEntry*
+Mockingjay::getVictim(const ReplacementCandidates& candidates) const
+{
+    // There must be at least one replacement candidate
+    assert(candidates.size() > 0);
+
+    ReplaceableEntry* victim = nullptr;
+    int64_t victim_ETR = 0;
+    for (const auto& candidate : candidates) {
+        const MockingjayReplData &candidate_repl_data =
+            *std::static_pointer_cast<MockingjayReplData>(
+                candidate->replacementData);
+
+        // Stop searching for victims if an invalid entry is found
+        if (!candidate_repl_data.valid) {
+            return candidate;
+        }
+
+        // Evict the line reused the furthest away; on ties, prefer the
+        // line whose reuse is overdue
+        const int64_t candidate_ETR = getETR(candidate_repl_data);
+        if (victim == nullptr ||
+            std::abs(candidate_ETR) > std::abs(victim_ETR) ||
+            (std::abs(candidate_ETR) == std::abs(victim_ETR) &&
+             candidate_ETR < victim_ETR)) {
+            victim = candidate;
+            victim_ETR = candidate_ETR;
+        }
+    }
+
+    if (victim_ETR < 0) {
+        stats.overdueEvictions++;
+    }
+
+    return victim;
+}
+
+std::shared_ptr<ReplacementData>
+Mockingjay::instantiateEntry()
+{
+    return std::shared_ptr<ReplacementData>(new MockingjayReplData());
+}
+
+} // namespace replacement_policy
+} // namespace gem5
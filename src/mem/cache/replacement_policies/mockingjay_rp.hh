@@ -0,0 +1,253 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the Mockingjay replacement policy, as described in
+ * "Effective Mimicry of Belady's MIN Policy", by Shah, Jain and Lin.
+ *
+ * Rather than classifying lines as cache-friendly or cache-averse,
+ * Mockingjay predicts the reuse distance of each access from its PC, and
+ * evicts the line whose estimated time of reuse (ETR) is the furthest
+ * away. The reuse distance predictor (RDP) is trained on a few sampled
+ * sets, where the reuse distance of each line is measured in accesses to
+ * the set; lines that are not reused within the sampled history are
+ * trained as never reused.
+ *
+ * The ETR of a line is its predicted reuse distance minus the number of
+ * accesses its set received since the line was last accessed. It is
+ * computed lazily from a per-set clock instead of being decremented on
+ * every access, and is quantized by a configurable granularity. Lines
+ * whose ETR became negative were expected to be reused already, so they
+ * are evicted according to how overdue they are. Bypassing is not
+ * supported by the replacement interface, so lines predicted as never
+ * reused are inserted as the next victims instead.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_MOCKINGJAY_RP_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_MOCKINGJAY_RP_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/statistics.hh"
+#include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/set_sampler.hh"
+#include "mem/packet.hh"
+
+namespace gem5
+{
+
+struct MockingjayRPParams;
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+class Mockingjay : public Base
+{
+  protected:
+    typedef std::size_t SignatureType;
+
+    /** Mockingjay-specific implementation of replacement data. */
+    struct MockingjayReplData : ReplacementData
+    {
+        /** Set of the entry, used to find its clock. */
+        unsigned set;
+
+        /** Value of the set's clock on the last access to this entry. */
+        uint64_t lastTime;
+
+        /** Predicted reuse distance of the last access, in set accesses. */
+        uint64_t predictedRD;
+
+        /** Whether the entry is valid. */
+        bool valid;
+
+        MockingjayReplData()
+          : set(0), lastTime(0), predictedRD(0), valid(false)
+        {
+        }
+    };
+
+    /** Number of set accesses kept in the sampled history. */
+    const unsigned historyLength;
+
+    /** Reuse distance representing lines that are never reused. */
+    const uint64_t infiniteRD;
+
+    /** Number of set accesses represented by one ETR unit. */
+    const unsigned granularity;
+
+    /** Observed sets and their recently accessed lines. */
+    SetSampler sampler;
+
+    /** Number of accesses received by each set. */
+    std::vector<uint64_t> clocks;
+
+    /** Whether each entry of the RDP has been trained. */
+    std::vector<bool> rdpValid;
+
+    /** PC-indexed reuse distance predictor. */
+    std::vector<uint64_t> rdp;
+
+    /** Signature used for accesses without a PC. */
+    const SignatureType NO_PC_SIGNATURE = 0;
+
+    /**
+     * Extract the signature of an access.
+     *
+     * @param pkt The packet of the access.
+     * @return The signature extracted.
+     */
+    SignatureType getSignature(const PacketPtr pkt) const;
+
+    /**
+     * Predict the reuse distance of an access.
+     *
+     * @param signature The signature of the access.
+     * @return The predicted reuse distance, in set accesses.
+     */
+    uint64_t predict(SignatureType signature) const;
+
+    /**
+     * Train the RDP with an observed reuse distance.
+     *
+     * @param signature The signature of the access that brought the line.
+     * @param reuse_distance The observed reuse distance.
+     */
+    void train(SignatureType signature, uint64_t reuse_distance);
+
+    /**
+     * Observe an access, if it belongs to a sampled set.
+     *
+     * @param pkt The packet of the access.
+     * @param signature The signature of the access.
+     * @param time The clock of the set at the access.
+     */
+    void sample(const PacketPtr pkt, SignatureType signature, uint64_t time);
+
+    /**
+     * Update the replacement data of an accessed or inserted entry.
+     *
+     * @param replacement_data Replacement data of the entry.
+     * @param pkt The packet of the access.
+     */
+    void update(const std::shared_ptr<ReplacementData>& replacement_data,
+                const PacketPtr pkt);
+
+    /**
+     * Get the estimated time of reuse of an entry, quantized.
+     *
+     * @param repl_data Replacement data of the entry.
+     * @return The ETR; negative if the reuse is overdue.
+     */
+    int64_t getETR(const MockingjayReplData &repl_data) const;
+
+    struct MockingjayStats : public statistics::Group
+    {
+        MockingjayStats(statistics::Group *parent);
+
+        /** Sampled reuses whose predicted reuse distance was (in)correct. */
+        statistics::Scalar correctPredictions;
+        statistics::Scalar incorrectPredictions;
+        statistics::Formula accuracy;
+        /** Correctly predicted finite reuses, and their absolute error. */
+        statistics::Scalar finiteReuses;
+        statistics::Scalar absoluteError;
+        statistics::Formula avgAbsoluteError;
+        /** Accesses predicted as never reused. */
+        statistics::Scalar infinitePredictions;
+        /** Victims whose reuse was overdue. */
+        statistics::Scalar overdueEvictions;
+    };
+
+    /** Mutable because evictions are accounted in getVictim(). */
+    mutable MockingjayStats stats;
+
+  public:
+    typedef MockingjayRPParams Params;
+    Mockingjay(const Params &p);
+    ~Mockingjay() = default;
+
+    /**
+     * Invalidate replacement data to set it as the next probable victim.
+     *
+     * @param replacement_data Replacement data to be invalidated.
+     */
+    void invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+                                                                    override;
+
+    /**
+     * Touch an entry to update its replacement data.
+     * Trains the RDP and predicts the reuse distance of the access.
+     *
+     * @param replacement_data Replacement data to be touched.
+     * @param pkt Packet that generated this hit.
+     */
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data,
+        const PacketPtr pkt) override;
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+        override;
+
+    /**
+     * Reset replacement data. Used when an entry is inserted.
+     * Trains the RDP and predicts the reuse distance of the access.
+     *
+     * @param replacement_data Replacement data to be reset.
+     * @param pkt Packet that generated this miss.
+     */
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data,
+        const PacketPtr pkt) override;
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+        override;
+
+    /**
+     * Find replacement victim among candidates: the entry whose estimated
+     * time of reuse is the furthest away, in the future or in the past.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
+    /**
+     * Instantiate a replacement data entry.
+     *
+     * @return A shared pointer to the new replacement data.
+     */
+    std::shared_ptr<ReplacementData> instantiateEntry() override;
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_MOCKINGJAY_RP_HH__
@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of OPTgen, which computes the decisions Belady's optimal
+ * replacement policy would have taken on a cache set, as described in
+ * "Back to the Future: Leveraging Belady's Algorithm for Improved Cache
+ * Replacement", by Jain and Lin.
+ *
+ * Time is measured in accesses to the set. Each time slot of a bounded
+ * history keeps the number of lines that OPT would have kept cached
+ * during that slot (its occupancy). When a line is reused, OPT would have
+ * hit on it only if the cache was never full during the line's usage
+ * interval, i.e., between its previous access and the current one; in
+ * that case the line occupies a way during the whole interval.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_OPTGEN_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_OPTGEN_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "base/compiler.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+class OPTgen
+{
+  private:
+    /** Number of ways of the modeled set. */
+    unsigned assoc;
+
+    /** Occupancy of the time slots in the history, used circularly. */
+    std::vector<unsigned> occupancy;
+
+    /** Current time, i.e., number of accesses seen so far. */
+    uint64_t time;
+
+  public:
+    /**
+     * @param _assoc Associativity of the modeled set.
+     * @param history_length Number of accesses kept in the history.
+     */
+    OPTgen(unsigned _assoc, unsigned history_length)
+      : assoc(_assoc), occupancy(history_length, 0), time(0)
+    {
+        assert(history_length > 0);
+    }
+
+    /** Number of accesses covered by the history. */
+    uint64_t historyLength() const { return occupancy.size(); }
+
+    /** Time of the next access. */
+    uint64_t now() const { return time; }
+
+    /**
+     * Whether a line whose previous access happened at the given time is
+     * still within the history.
+     *
+     * @param last_time Time of the previous access to the line.
+     * @return True if the usage interval can be evaluated.
+     */
+    bool
+    inHistory(uint64_t last_time) const
+    {
+        return time - last_time < occupancy.size();
+    }
+
+    /**
+     * Decide whether OPT would have hit on a reused line, and if so make
+     * the line occupy a way during its usage interval. Must be called
+     * before access() for the current access.
+     *
+     * @param last_time Time of the previous access to the line.
+     * @return True if OPT would have kept the line cached.
+     */
+    bool
+    shouldCache(uint64_t last_time)
+    {
+        if (!inHistory(last_time)) {
+            return false;
+        }
+        for (uint64_t t = last_time; t < time; t++) {
+            if (occupancy[t % occupancy.size()] >= assoc) {
+                return false;
+            }
+        }
+        for (uint64_t t = last_time; t < time; t++) {
+            occupancy[t % occupancy.size()]++;
+        }
+        return true;
+    }
+
+    /**
+     * Record an access, opening a new time slot.
+     *
+     * @return The time of the access.
+     */
+    uint64_t
+    access()
+    {
+        occupancy[time % occupancy.size()] = 0;
+        return time++;
+    }
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_OPTGEN_HH__
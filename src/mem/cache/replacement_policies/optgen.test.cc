@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "mem/cache/replacement_policies/optgen.hh"
+
+using namespace gem5;
+
+/** A line reused while the set is never full is a hit. */
+TEST(OPTgenTest, ReuseWithoutContention)
+{
+    replacement_policy::OPTgen optgen(1, 8);
+    const uint64_t a = optgen.access();
+    optgen.access();
+    ASSERT_TRUE(optgen.shouldCache(a));
+}
+
+/**
+ * With a single way, A B A B: OPT keeps A during [0, 2), so B cannot be
+ * kept during [1, 3).
+ */
+TEST(OPTgenTest, OverlappingIntervals)
+{
+    replacement_policy::OPTgen optgen(1, 8);
+    const uint64_t a = optgen.access();
+    const uint64_t b = optgen.access();
+    ASSERT_TRUE(optgen.shouldCache(a));
+    optgen.access();
+    ASSERT_FALSE(optgen.shouldCache(b));
+    optgen.access();
+}
+
+/** Two ways are enough to keep both lines of A B A B. */
+TEST(OPTgenTest, TwoWays)
+{
+    replacement_policy::OPTgen optgen(2, 8);
+    const uint64_t a = optgen.access();
+    const uint64_t b = optgen.access();
+    ASSERT_TRUE(optgen.shouldCache(a));
+    optgen.access();
+    ASSERT_TRUE(optgen.shouldCache(b));
+    optgen.access();
+}
+
+/** Reuses beyond the history are always misses. */
+TEST(OPTgenTest, OutOfHistory)
+{
+    replacement_policy::OPTgen optgen(4, 4);
+    const uint64_t a = optgen.access();
+    for (int i = 0; i < 4; i++) {
+        optgen.access();
+    }
+    ASSERT_FALSE(optgen.inHistory(a));
+    ASSERT_FALSE(optgen.shouldCache(a));
+}
+
+/** Slots are cleared when they are reused by the circular history. */
+TEST(OPTgenTest, HistoryWrapsAround)
+{
+    replacement_policy::OPTgen optgen(1, 2);
+    uint64_t last = optgen.access();
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(optgen.shouldCache(last));
+        last = optgen.access();
+    }
+}
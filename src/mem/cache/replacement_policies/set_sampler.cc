@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/replacement_policies/set_sampler.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+SetSampler::SetSampler(uint64_t cache_size, unsigned assoc,
+                       unsigned block_size, unsigned num_sampled_sets,
+                       unsigned entries_per_set)
+  : blkBits(floorLog2(block_size)),
+    numSets(cache_size / (uint64_t(assoc) * block_size)),
+    stride(std::max(1u, numSets / std::max(1u, num_sampled_sets)))
+{
+    fatal_if(numSets == 0, "The cache must have at least one set");
+    fatal_if(!isPowerOf2(block_size), "The block size must be a power of 2");
+    fatal_if(entries_per_set == 0,
+             "At least one line must be tracked per sampled set");
+    entries.resize(divCeil(numSets, stride),
+                   std::vector<Entry>(entries_per_set));
+}
+
+SetSampler::Entry *
+SetSampler::find(int sampled_set, Addr addr)
+{
+    assert(sampled_set >= 0 && sampled_set < entries.size());
+    const Addr blk_addr = addr >> blkBits;
+    for (auto &entry : entries[sampled_set]) {
+        if (entry.valid && entry.blkAddr == blk_addr) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+SetSampler::Entry &
+SetSampler::allocate(int sampled_set, Addr addr, Entry &evicted)
+{
+    assert(sampled_set >= 0 && sampled_set < entries.size());
+    std::vector<Entry> &set = entries[sampled_set];
+
+    // Use an invalid entry if there is one, otherwise the least recently
+    // accessed line
+    auto victim = std::find_if(set.begin(), set.end(),
+        [](const Entry &entry) { return !entry.valid; });
+    if (victim == set.end()) {
+        victim = std::min_element(set.begin(), set.end(),
+            [](const Entry &a, const Entry &b) {
+                return a.lastTime < b.lastTime;
+            });
+    }
+
+    evicted = *victim;
+    victim->valid = true;
+    victim->blkAddr = addr >> blkBits;
+    return *victim;
+}
+
+} // namespace replacement_policy
+} // namespace gem5
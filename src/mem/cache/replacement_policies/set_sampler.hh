@@ -0,0 +1,150 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the set sampler used by the replacement policies that
+ * learn from the optimal policy. A subset of the cache sets is observed,
+ * and for each of them the recently accessed lines are kept along with
+ * the time and signature of their last access, so that their reuse can
+ * be detected.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_SET_SAMPLER_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_SET_SAMPLER_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+class SetSampler
+{
+  public:
+    /** A line recently accessed in a sampled set. */
+    struct Entry
+    {
+        /** Whether the entry holds a line. */
+        bool valid = false;
+        /** Block address of the line. */
+        Addr blkAddr = 0;
+        /** Time of the last access to the line, in set accesses. */
+        uint64_t lastTime = 0;
+        /** Signature of the last access to the line. */
+        uint64_t signature = 0;
+    };
+
+  private:
+    /** log2 of the block size. */
+    const unsigned blkBits;
+
+    /** Number of sets of the cache. */
+    const unsigned numSets;
+
+    /** Distance between two consecutive sampled sets. */
+    const unsigned stride;
+
+    /** Recently accessed lines of each sampled set. */
+    std::vector<std::vector<Entry>> entries;
+
+  public:
+    /**
+     * @param cache_size Size of the cache, in bytes.
+     * @param assoc Associativity of the cache.
+     * @param block_size Block size of the cache, in bytes.
+     * @param num_sampled_sets Number of sets to observe.
+     * @param entries_per_set Number of lines kept per sampled set.
+     */
+    SetSampler(uint64_t cache_size, unsigned assoc, unsigned block_size,
+               unsigned num_sampled_sets, unsigned entries_per_set);
+
+    /** Number of sets of the cache. */
+    unsigned getNumSets() const { return numSets; }
+
+    /** Number of sets being observed. */
+    unsigned getNumSampledSets() const { return entries.size(); }
+
+    /**
+     * Get the set an address maps to, assuming modulo indexing.
+     *
+     * @param addr The address.
+     * @return The index of the set.
+     */
+    unsigned
+    setIndex(Addr addr) const
+    {
+        return (addr >> blkBits) % numSets;
+    }
+
+    /**
+     * Get the sampled set an address maps to.
+     *
+     * @param addr The address.
+     * @return The index of the sampled set, or -1 if the set is not
+     *         sampled.
+     */
+    int
+    sampledSet(Addr addr) const
+    {
+        const unsigned set = setIndex(addr);
+        return (set % stride == 0) ? int(set / stride) : -1;
+    }
+
+    /**
+     * Find the entry of a line in a sampled set.
+     *
+     * @param sampled_set Index of the sampled set.
+     * @param addr Address of the line.
+     * @return The entry, or nullptr if the line is not being tracked.
+     */
+    Entry *find(int sampled_set, Addr addr);
+
+    /**
+     * Allocate an entry for a line in a sampled set, replacing the least
+     * recently accessed line if needed. The caller must fill it.
+     *
+     * @param sampled_set Index of the sampled set.
+     * @param addr Address of the line.
+     * @param evicted Filled with the replaced entry, if valid.
+     * @return The allocated entry.
+     */
+    Entry &allocate(int sampled_set, Addr addr, Entry &evicted);
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_SET_SAMPLER_HH__
@@ -37,6 +37,7 @@ from m5.params import *
 from m5.proxy import *
 from m5.objects.ClockedObject import ClockedObject
 from m5.objects.IndexingPolicies import *
+from m5.objects.PartitioningPolicies import *
 
 class BaseTags(ClockedObject):
     type = 'BaseTags'
@@ -84,6 +85,10 @@ class BaseSetAssoc(BaseTags):
     replacement_policy = Param.BaseReplacementPolicy(
         Parent.replacement_policy, "Replacement policy")
 
+    # Get partitioning policy from the parent (cache)
+    partitioning_policy = Param.BasePartitioningPolicy(
+        Parent.partitioning_policy, "Partitioning policy")
+
 class SectorTags(BaseTags):
     type = 'SectorTags'
     cxx_header = "mem/cache/tags/sector_tags.hh"
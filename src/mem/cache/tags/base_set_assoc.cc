@@ -55,7 +55,8 @@ namespace gem5
 BaseSetAssoc::BaseSetAssoc(const Params &p)
     :BaseTags(p), allocAssoc(p.assoc), blks(p.size / p.block_size),
      sequentialAccess(p.sequential_access),
-     replacementPolicy(p.replacement_policy)
+     replacementPolicy(p.replacement_policy),
+     partitioningPolicy(p.partitioning_policy)
 {
     // There must be a indexing policy
     fatal_if(!p.indexing_policy, "An indexing policy is required");
@@ -88,6 +89,10 @@ BaseSetAssoc::tagsInit()
 void
 BaseSetAssoc::invalidate(CacheBlk *blk)
 {
+    if (partitioningPolicy) {
+        partitioningPolicy->notifyRelease(blk->getSrcRequestorId());
+    }
+
     BaseTags::invalidate(blk);
 
     // Decrease the number of tags in use
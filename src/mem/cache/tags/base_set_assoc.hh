@@ -59,6 +59,7 @@
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/cache/tags/base.hh"
 #include "mem/cache/tags/indexing_policies/base.hh"
+#include "mem/cache/tags/partitioning_policies/base.hh"
 #include "mem/packet.hh"
 #include "params/BaseSetAssoc.hh"
 
@@ -87,6 +88,9 @@ class BaseSetAssoc : public BaseTags
     /** Replacement policy */
     replacement_policy::Base *replacementPolicy;
 
+    /** Partitioning policy, if the ways are partitioned among requestors */
+    partitioning_policy::Base *partitioningPolicy;
+
   public:
     /** Convenience typedef. */
      typedef BaseSetAssocParams Params;
@@ -149,6 +153,10 @@ class BaseSetAssoc : public BaseTags
             replacementPolicy->touch(blk->replacementData, pkt);
         }
 
+        if (partitioningPolicy) {
+            partitioningPolicy->notifyAccess(pkt, blk != nullptr);
+        }
+
         // The tag lookup latency is the same for a hit or a miss
         lat = lookupLatency;
 
@@ -157,22 +165,30 @@ class BaseSetAssoc : public BaseTags
 
     /**
      * Find replacement victim based on address. The list of evicted blocks
-     * only contains the victim.
+     * only contains the victim. If the ways are partitioned, the victim is
+     * chosen among the ways of the requestor's partition.
      *
      * @param addr Address to find a victim for.
      * @param is_secure True if the target memory space is secure.
      * @param size Size, in bits, of new block to allocate.
      * @param evict_blks Cache blocks to be evicted.
+     * @param requestor_id The requestor allocating the block.
      * @return Cache block to be replaced.
      */
     CacheBlk* findVictim(Addr addr, const bool is_secure,
                          const std::size_t size,
-                         std::vector<CacheBlk*>& evict_blks) override
+                         std::vector<CacheBlk*>& evict_blks,
+                         const RequestorID requestor_id) override
     {
         // Get possible entries to be victimized
-        const std::vector<ReplaceableEntry*> entries =
+        std::vector<ReplaceableEntry*> entries =
             indexingPolicy->getPossibleEntries(addr);
 
+        // Restrict them to the ways the requestor may allocate into
+        if (partitioningPolicy) {
+            partitioningPolicy->filterByPartition(entries, requestor_id);
+        }
+
         // Choose replacement victim from replacement candidates
         CacheBlk* victim = static_cast<CacheBlk*>(replacementPolicy->getVictim(
                                 entries));
@@ -197,6 +213,10 @@ class BaseSetAssoc : public BaseTags
         // Increment tag counter
         stats.tagsInUse++;
 
+        if (partitioningPolicy) {
+            partitioningPolicy->notifyAcquire(blk->getSrcRequestorId());
+        }
+
         // Update replacement policy
         replacementPolicy->reset(blk->replacementData, pkt);
     }
@@ -102,11 +102,13 @@ class CompressedTags : public SectorTags
      * @param is_secure True if the target memory space is secure.
      * @param compressed_size Size, in bits, of new block to allocate.
      * @param evict_blks Cache blocks to be evicted.
+     * @param requestor_id The requestor allocating the block.
      * @return Cache block to be replaced.
      */
     CacheBlk* findVictim(Addr addr, const bool is_secure,
                          const std::size_t compressed_size,
-                         std::vector<CacheBlk*>& evict_blks) override;
+                         std::vector<CacheBlk*>& evict_blks,
+                         const RequestorID requestor_id) override;
 
     /**
      * Visit each sub-block in the tags and apply a visitor.
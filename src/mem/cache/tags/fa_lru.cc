@@ -191,7 +191,8 @@ FALRU::findBlockBySetAndWay(int set, int way) const
 
 CacheBlk*
 FALRU::findVictim(Addr addr, const bool is_secure, const std::size_t size,
-                  std::vector<CacheBlk*>& evict_blks)
+                  std::vector<CacheBlk*>& evict_blks,
+                  const RequestorID requestor_id)
 {
     // The victim is always stored on the tail for the FALRU
     FALRUBlk* victim = tail;
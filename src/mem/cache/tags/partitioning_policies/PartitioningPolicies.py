@@ -0,0 +1,91 @@
+# Copyright (c) 2025
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import *
+
+class BasePartitioningPolicy(SimObject):
+    type = 'BasePartitioningPolicy'
+    abstract = True
+    cxx_class = 'gem5::partitioning_policy::Base'
+    cxx_header = "mem/cache/tags/partitioning_policies/base.hh"
+
+    cxx_exports = [
+        PyBindMethod('initRequestorName'),
+        PyBindMethod('initRequestorObj'),
+    ]
+
+    system = Param.System(Parent.any, "System the cache belongs to")
+    assoc = Param.Int(Parent.assoc, "Associativity of the cache")
+    default_partition = Param.Unsigned(0,
+        "Partition of the requestors that have not been mapped")
+
+    _requestor_partitions = None
+
+    def setRequestorPartition(self, requestor, partition):
+        """Map a requestor, given as a SimObject or as a requestor name
+        (e.g., "cpu0.data"), to a partition. All the requestors owned by a
+        SimObject are mapped."""
+        if not self._requestor_partitions:
+            self._requestor_partitions = []
+
+        self._requestor_partitions.append([requestor, partition])
+
+    def init(self):
+        if not self._requestor_partitions:
+            return
+
+        for requestor, partition in self._requestor_partitions:
+            if isinstance(requestor, str):
+                self.getCCObject().initRequestorName(
+                    requestor, int(partition))
+            else:
+                self.getCCObject().initRequestorObj(
+                    requestor.getCCObject(), int(partition))
+
+class WayPartitioningPolicy(BasePartitioningPolicy):
+    type = 'WayPartitioningPolicy'
+    cxx_class = 'gem5::partitioning_policy::WayPartitioning'
+    cxx_header = "mem/cache/tags/partitioning_policies/way_partitioning.hh"
+
+    way_masks = VectorParam.UInt64(
+        "Bit mask of the ways each partition may allocate into")
+
+class UtilityPartitioningPolicy(BasePartitioningPolicy):
+    type = 'UtilityPartitioningPolicy'
+    cxx_class = 'gem5::partitioning_policy::UtilityPartitioning'
+    cxx_header = \
+        "mem/cache/tags/partitioning_policies/utility_partitioning.hh"
+
+    size = Param.MemorySize(Parent.size, "Size of the cache")
+    block_size = Param.Int(Parent.cache_line_size, "Block size in bytes")
+    num_partitions = Param.Unsigned("Number of partitions")
+    num_sampled_sets = Param.Unsigned(32,
+        "Number of sets observed by the utility monitors")
+    repartition_interval = Param.Unsigned(100000,
+        "Number of accesses between two distributions of the ways")
+    min_ways = Param.Unsigned(1, "Minimum number of ways of a partition")
@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/tags/partitioning_policies/base.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/bitfield.hh"
+#include "base/logging.hh"
+#include "base/str.hh"
+#include "base/trace.hh"
+#include "debug/CachePartitioning.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
+#include "params/BasePartitioningPolicy.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+namespace partitioning_policy
+{
+
+Base::Base(const Params &p, unsigned num_partitions)
+  : SimObject(p), system(p.system), assoc(p.assoc),
+    defaultPartition(p.default_partition),
+    wayMasks(num_partitions, 0), occupancy(num_partitions, 0),
+    stats(*this)
+{
+    fatal_if(num_partitions == 0, "At least one partition is required");
+    fatal_if(defaultPartition >= num_partitions,
+             "The default partition (%d) does not exist", defaultPartition);
+    fatal_if(assoc == 0 || assoc > 64,
+             "Way partitioning supports between 1 and 64 ways");
+}
+
+Base::PartitioningStats::PartitioningStats(Base &_policy)
+  : statistics::Group(&_policy), policy(_policy),
+    ADD_STAT(accesses, statistics::units::Count::get(),
+             "Number of accesses of each partition"),
+    ADD_STAT(misses, statistics::units::Count::get(),
+             "Number of misses of each partition"),
+    ADD_STAT(missRate, statistics::units::Ratio::get(),
+             "Miss rate of each partition", misses / accesses),
+    ADD_STAT(occupancy, statistics::units::Count::get(),
+             "Number of lines allocated by each partition"),
+    ADD_STAT(allocatedWays, statistics::units::Count::get(),
+             "Number of ways each partition may allocate into")
+{
+    const unsigned num_partitions = policy.getNumPartitions();
+
+    accesses.init(num_partitions);
+    misses.init(num_partitions);
+    occupancy.init(num_partitions);
+    allocatedWays.init(num_partitions);
+}
+
+void
+Base::PartitioningStats::preDumpStats()
+{
+    statistics::Group::preDumpStats();
+
+    for (unsigned i = 0; i < policy.getNumPartitions(); i++) {
+        occupancy[i] = policy.occupancy[i];
+        allocatedWays[i] = popCount(policy.wayMasks[i]);
+    }
+}
+
+void
+Base::checkWayMask(uint64_t mask) const
+{
+    fatal_if(mask == 0, "A partition must be able to allocate into a way");
+    fatal_if(assoc < 64 && (mask >> assoc) != 0,
+             "Way mask %#x has ways beyond the associativity (%d)",
+             mask, assoc);
+}
+
+void
+Base::initRequestorName(std::string requestor, unsigned partition)
+{
+    fatal_if(partition >= getNumPartitions(),
+             "Partition %d of %s does not exist", partition, requestor);
+
+    const RequestorID id = system->lookupRequestorId(requestor);
+    panic_if(id == Request::invldRequestorId,
+             "Unable to find requestor %s\n", requestor);
+
+    DPRINTF(CachePartitioning, "Requestor %s [id %d] mapped to partition "
+            "%d\n", requestor, id, partition);
+    partitionMap[id] = partition;
+}
+
+void
+Base::initRequestorObj(const SimObject* requestor, unsigned partition)
+{
+    fatal_if(partition >= getNumPartitions(),
+             "Partition %d of %s does not exist", partition,
+             requestor->name());
+
+    // An object may own several requestors (e.g., a CPU has an instruction
+    // and a data requestor), so map all of them
+    std::string prefix = requestor->name();
+    if (startswith(prefix, system->name() + ".")) {
+        prefix = prefix.substr(system->name().size() + 1);
+    }
+
+    bool found = false;
+    for (RequestorID id = 0; id < system->maxRequestors(); id++) {
+        const std::string req_name = system->getRequestorName(id);
+        if (req_name == prefix || startswith(req_name, prefix + ".")) {
+            DPRINTF(CachePartitioning, "Requestor %s [id %d] mapped to "
+                    "partition %d\n", req_name, id, partition);
+            partitionMap[id] = partition;
+            found = true;
+        }
+    }
+    panic_if(!found, "Unable to find requestor %s\n", requestor->name());
+}
+
+unsigned
+Base::getPartition(RequestorID requestor_id) const
+{
+    const auto it = partitionMap.find(requestor_id);
+    return (it != partitionMap.end()) ? it->second : defaultPartition;
+}
+
+void
+Base::filterByPartition(std::vector<ReplaceableEntry*> &candidates,
+                        RequestorID requestor_id) const
+{
+    const uint64_t mask = wayMasks[getPartition(requestor_id)];
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+        [mask](const ReplaceableEntry* entry) {
+            return !bits(mask, entry->getWay());
+        }), candidates.end());
+
+    // The masks only contain existing ways, so there is always a candidate
+    assert(!candidates.empty());
+}
+
+void
+Base::notifyAccess(const PacketPtr pkt, bool hit)
+{
+    const unsigned partition = getPartition(pkt->req->requestorId());
+    stats.accesses[partition]++;
+    if (!hit) {
+        stats.misses[partition]++;
+    }
+}
+
+void
+Base::notifyAcquire(RequestorID requestor_id)
+{
+    occupancy[getPartition(requestor_id)]++;
+}
+
+void
+Base::notifyRelease(RequestorID requestor_id)
+{
+    const unsigned partition = getPartition(requestor_id);
+    assert(occupancy[partition] > 0);
+    occupancy[partition]--;
+}
+
+} // namespace partitioning_policy
+} // namespace gem5
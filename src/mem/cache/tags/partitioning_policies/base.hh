@@ -0,0 +1,187 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the base class of the cache partitioning policies, which
+ * restrict the ways a requestor may allocate into, in the spirit of
+ * Intel's Cache Allocation Technology (CAT).
+ *
+ * Requestors are mapped to partitions, and each partition is given a mask
+ * of the ways from which its victims can be chosen. Lookups are never
+ * restricted, so a partition can still hit on lines allocated in other
+ * partitions' ways. Requestors that are not mapped belong to the default
+ * partition.
+ */
+
+#ifndef __MEM_CACHE_TAGS_PARTITIONING_POLICIES_BASE_HH__
+#define __MEM_CACHE_TAGS_PARTITIONING_POLICIES_BASE_HH__
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+class ReplaceableEntry;
+class System;
+struct BasePartitioningPolicyParams;
+
+namespace partitioning_policy
+{
+
+class Base : public SimObject
+{
+  protected:
+    /** The system the cache belongs to, used to look up requestors. */
+    System *system;
+
+    /** Associativity of the cache. */
+    const unsigned assoc;
+
+    /** Partition of the requestors that have not been mapped. */
+    const unsigned defaultPartition;
+
+    /** Partition of each mapped requestor. */
+    std::unordered_map<RequestorID, unsigned> partitionMap;
+
+    /** Ways each partition may allocate into, as bit masks. */
+    std::vector<uint64_t> wayMasks;
+
+    /** Number of lines currently allocated by each partition. */
+    std::vector<uint64_t> occupancy;
+
+    struct PartitioningStats : public statistics::Group
+    {
+        PartitioningStats(Base &policy);
+
+        void preDumpStats() override;
+
+        const Base &policy;
+
+        /** Number of accesses of each partition. */
+        statistics::Vector accesses;
+        /** Number of misses of each partition. */
+        statistics::Vector misses;
+        /** Miss rate of each partition. */
+        statistics::Formula missRate;
+        /** Number of lines allocated by each partition. */
+        statistics::Vector occupancy;
+        /** Number of ways each partition may allocate into. */
+        statistics::Vector allocatedWays;
+    } stats;
+
+    /**
+     * Check that a mask of ways can be used by a partition.
+     *
+     * @param mask The way mask.
+     */
+    void checkWayMask(uint64_t mask) const;
+
+  public:
+    typedef BasePartitioningPolicyParams Params;
+
+    /**
+     * @param p The parameters.
+     * @param num_partitions The number of partitions.
+     */
+    Base(const Params &p, unsigned num_partitions);
+    virtual ~Base() = default;
+
+    /** Number of partitions. */
+    unsigned getNumPartitions() const { return wayMasks.size(); }
+
+    /**
+     * Map a requestor to a partition, given its name.
+     *
+     * @param requestor The name of the requestor.
+     * @param partition The partition.
+     */
+    void initRequestorName(std::string requestor, unsigned partition);
+
+    /**
+     * Map a requestor to a partition, given its SimObject.
+     *
+     * @param requestor The requestor.
+     * @param partition The partition.
+     */
+    void initRequestorObj(const SimObject* requestor, unsigned partition);
+
+    /**
+     * Get the partition of a requestor.
+     *
+     * @param requestor_id The ID of the requestor.
+     * @return The partition it belongs to.
+     */
+    unsigned getPartition(RequestorID requestor_id) const;
+
+    /**
+     * Remove from the replacement candidates the entries which are
+     * outside of the ways of a requestor's partition.
+     *
+     * @param candidates The replacement candidates.
+     * @param requestor_id The ID of the requestor allocating a line.
+     */
+    void filterByPartition(std::vector<ReplaceableEntry*> &candidates,
+                           RequestorID requestor_id) const;
+
+    /**
+     * Notify the policy of a lookup in the cache.
+     *
+     * @param pkt The packet of the access.
+     * @param hit Whether the access hit.
+     */
+    virtual void notifyAccess(const PacketPtr pkt, bool hit);
+
+    /**
+     * Notify the policy that a requestor allocated a line.
+     *
+     * @param requestor_id The ID of the requestor that brought the line.
+     */
+    void notifyAcquire(RequestorID requestor_id);
+
+    /**
+     * Notify the policy that a line was invalidated.
+     *
+     * @param requestor_id The ID of the requestor that brought the line.
+     */
+    void notifyRelease(RequestorID requestor_id);
+};
+
+} // namespace partitioning_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_PARTITIONING_POLICIES_BASE_HH__
@@ -0,0 +1,200 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/tags/partitioning_policies/utility_partitioning.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/CachePartitioning.hh"
+#include "params/UtilityPartitioningPolicy.hh"
+
+namespace gem5
+{
+
+namespace partitioning_policy
+{
+
+UtilityPartitioning::UtilityPartitioning(const Params &p)
+  : Base(p, p.num_partitions), blkBits(floorLog2(p.block_size)),
+    numSets(p.size / (uint64_t(p.assoc) * p.block_size)),
+    stride(std::max(1u, numSets / std::max(1u, p.num_sampled_sets))),
+    repartitionInterval(p.repartition_interval), minWays(p.min_ways),
+    accessesSinceRepartition(0),
+    shadowTags(p.num_partitions,
+               std::vector<std::vector<Addr>>(divCeil(numSets, stride))),
+    wayHits(p.num_partitions, std::vector<uint64_t>(p.assoc, 0)),
+    utilityStats(this)
+{
+    fatal_if(numSets == 0, "The cache must have at least one set");
+    fatal_if(repartitionInterval == 0,
+             "The repartition interval must be positive");
+    fatal_if(minWays == 0, "Every partition must have at least one way");
+    fatal_if(p.num_partitions * minWays > assoc,
+             "Not enough ways to give %d to each of the %d partitions",
+             minWays, p.num_partitions);
+
+    // Start with an even distribution of the ways
+    std::vector<unsigned> allocation(p.num_partitions,
+                                     assoc / p.num_partitions);
+    for (unsigned i = 0; i < assoc % p.num_partitions; i++) {
+        allocation[i]++;
+    }
+    setWayMasks(allocation);
+}
+
+UtilityPartitioning::UtilityStats::UtilityStats(statistics::Group *parent)
+  : statistics::Group(parent),
+    ADD_STAT(repartitions, statistics::units::Count::get(),
+             "Number of times the ways were distributed"),
+    ADD_STAT(allocationChanges, statistics::units::Count::get(),
+             "Number of times the distribution of ways changed")
+{
+}
+
+void
+UtilityPartitioning::updateMonitor(unsigned partition, Addr addr)
+{
+    const unsigned set = (addr >> blkBits) % numSets;
+    if (set % stride != 0) {
+        return;
+    }
+
+    std::vector<Addr> &stack = shadowTags[partition][set / stride];
+    const Addr blk_addr = addr >> blkBits;
+    auto it = std::find(stack.begin(), stack.end(), blk_addr);
+    if (it != stack.end()) {
+        // A hit on the i-th most recently used line would have been a hit
+        // if the partition had at least i + 1 ways
+        wayHits[partition][it - stack.begin()]++;
+        stack.erase(it);
+    } else if (stack.size() == assoc) {
+        stack.pop_back();
+    }
+    stack.insert(stack.begin(), blk_addr);
+}
+
+uint64_t
+UtilityPartitioning::getUtility(unsigned partition, unsigned from,
+                                unsigned to) const
+{
+    uint64_t utility = 0;
+    for (unsigned way = from; way < to; way++) {
+        utility += wayHits[partition][way];
+    }
+    return utility;
+}
+
+std::vector<unsigned>
+UtilityPartitioning::lookahead() const
+{
+    const unsigned num_partitions = getNumPartitions();
+    std::vector<unsigned> allocation(num_partitions, minWays);
+    unsigned balance = assoc - num_partitions * minWays;
+
+    while (balance > 0) {
+        // Find the partition that gets the most hits per additional way.
+        // Ties go to the partition with the fewest ways, so that ways are
+        // evenly distributed when there is no utility information
+        unsigned best_partition = 0;
+        unsigned best_ways = 1;
+        double best_utility = -1;
+        for (unsigned p = 0; p < num_partitions; p++) {
+            const unsigned max_ways = std::min(balance, assoc - allocation[p]);
+            for (unsigned k = 1; k <= max_ways; k++) {
+                const double utility = double(getUtility(p, allocation[p],
+                    allocation[p] + k)) / k;
+                if (utility > best_utility || (utility == best_utility &&
+                    allocation[p] < allocation[best_partition])) {
+                    best_partition = p;
+                    best_ways = k;
+                    best_utility = utility;
+                }
+            }
+        }
+
+        allocation[best_partition] += best_ways;
+        balance -= best_ways;
+    }
+
+    return allocation;
+}
+
+void
+UtilityPartitioning::setWayMasks(const std::vector<unsigned> &allocation)
+{
+    unsigned first_way = 0;
+    for (unsigned p = 0; p < allocation.size(); p++) {
+        const unsigned last_way = first_way + allocation[p] - 1;
+        wayMasks[p] = mask(last_way, first_way);
+        checkWayMask(wayMasks[p]);
+        DPRINTF(CachePartitioning, "Partition %d allocates into ways "
+                "[%d, %d]\n", p, first_way, last_way);
+        first_way = last_way + 1;
+    }
+    assert(first_way == assoc);
+}
+
+void
+UtilityPartitioning::repartition()
+{
+    const std::vector<uint64_t> old_masks = wayMasks;
+    setWayMasks(lookahead());
+
+    utilityStats.repartitions++;
+    if (old_masks != wayMasks) {
+        utilityStats.allocationChanges++;
+    }
+
+    // Age the utility information
+    for (auto &hits : wayHits) {
+        for (auto &way_hits : hits) {
+            way_hits /= 2;
+        }
+    }
+}
+
+void
+UtilityPartitioning::notifyAccess(const PacketPtr pkt, bool hit)
+{
+    Base::notifyAccess(pkt, hit);
+
+    updateMonitor(getPartition(pkt->req->requestorId()), pkt->getAddr());
+
+    if (++accessesSinceRepartition >= repartitionInterval) {
+        accessesSinceRepartition = 0;
+        repartition();
+    }
+}
+
+} // namespace partitioning_policy
+} // namespace gem5
@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the Utility-based Cache Partitioning (UCP) policy, as
+ * described in "Utility-Based Cache Partitioning: A Low-Overhead,
+ * High-Performance, Runtime Mechanism to Partition Shared Caches", by
+ * Qureshi and Patt.
+ *
+ * A utility monitor (UMON) keeps, for each partition, shadow LRU tags of
+ * a few sampled sets as if the partition had the whole cache for itself,
+ * and counts the hits on each LRU stack position. Periodically, the
+ * lookahead algorithm distributes the ways among the partitions according
+ * to the marginal utility of giving them more ways, and the hit counters
+ * are halved so that older behavior progressively loses weight. The ways
+ * of each partition are contiguous and do not overlap.
+ */
+
+#ifndef __MEM_CACHE_TAGS_PARTITIONING_POLICIES_UTILITY_PARTITIONING_HH__
+#define __MEM_CACHE_TAGS_PARTITIONING_POLICIES_UTILITY_PARTITIONING_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/cache/tags/partitioning_policies/base.hh"
+#include "mem/packet.hh"
+
+namespace gem5
+{
+
+struct UtilityPartitioningPolicyParams;
+
+namespace partitioning_policy
+{
+
+class UtilityPartitioning : public Base
+{
+  protected:
+    /** log2 of the block size. */
+    const unsigned blkBits;
+
+    /** Number of sets of the cache. */
+    const unsigned numSets;
+
+    /** Distance between two consecutive sampled sets. */
+    const unsigned stride;
+
+    /** Number of accesses between two repartitions. */
+    const unsigned repartitionInterval;
+
+    /** Minimum number of ways of a partition. */
+    const unsigned minWays;
+
+    /** Number of accesses since the last repartition. */
+    unsigned accessesSinceRepartition;
+
+    /**
+     * Shadow tags of the UMON, indexed by partition and sampled set. Each
+     * set is an LRU stack of block addresses, most recently used first.
+     */
+    std::vector<std::vector<std::vector<Addr>>> shadowTags;
+
+    /** Hits on each LRU stack position, per partition. */
+    std::vector<std::vector<uint64_t>> wayHits;
+
+    struct UtilityStats : public statistics::Group
+    {
+        UtilityStats(statistics::Group *parent);
+
+        /** Number of times the ways were distributed. */
+        statistics::Scalar repartitions;
+        /** Number of times the distribution of ways changed. */
+        statistics::Scalar allocationChanges;
+    } utilityStats;
+
+    /**
+     * Update the shadow tags of a partition with an access.
+     *
+     * @param partition The partition of the access.
+     * @param addr The address of the access.
+     */
+    void updateMonitor(unsigned partition, Addr addr);
+
+    /**
+     * Number of UMON hits a partition would get from ways [from, to).
+     *
+     * @param partition The partition.
+     * @param from The first way.
+     * @param to The way after the last one.
+     * @return The number of hits.
+     */
+    uint64_t getUtility(unsigned partition, unsigned from,
+                        unsigned to) const;
+
+    /**
+     * Distribute the ways among the partitions with the lookahead
+     * algorithm.
+     *
+     * @return The number of ways of each partition.
+     */
+    std::vector<unsigned> lookahead() const;
+
+    /**
+     * Assign contiguous ways to the partitions.
+     *
+     * @param allocation The number of ways of each partition.
+     */
+    void setWayMasks(const std::vector<unsigned> &allocation);
+
+    /** Redistribute the ways among the partitions. */
+    void repartition();
+
+  public:
+    typedef UtilityPartitioningPolicyParams Params;
+    UtilityPartitioning(const Params &p);
+    ~UtilityPartitioning() = default;
+
+    void notifyAccess(const PacketPtr pkt, bool hit) override;
+};
+
+} // namespace partitioning_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_PARTITIONING_POLICIES_UTILITY_PARTITIONING_HH__
@@ -274,7 +274,8 @@ SectorTags::findBlock(Addr addr, bool is_secure) const
 
 CacheBlk*
 SectorTags::findVictim(Addr addr, const bool is_secure, const std::size_t size,
-                       std::vector<CacheBlk*>& evict_blks)
+                       std::vector<CacheBlk*>& evict_blks,
+                       const RequestorID requestor_id)
 {
     // Get possible entries to be victimized
     const std::vector<ReplaceableEntry*> sector_entries =
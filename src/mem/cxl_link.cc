@@ -0,0 +1,480 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Implementation of the CXLLink class.
+ */
+
+#include "mem/cxl_link.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/CXLLink.hh"
+#include "debug/Drain.hh"
+#include "sim/core.hh"
+#include "sim/stats.hh"
+
+namespace gem5
+{
+
+CXLLink::CXLLink(const Params &p)
+    : ClockedObject(p),
+      cpuSidePort(name() + ".cpu_side_port", *this),
+      memSidePort(name() + ".mem_side_port", *this),
+      ranges(p.ranges.begin(), p.ranges.end()),
+      delay(p.delay),
+      slotBits(p.slot_size * 8),
+      slotsPerFlit(p.slots_per_flit),
+      flitSize(p.flit_size),
+      slotTicks(flitSize * 8 * sim_clock::as_float::ns /
+                (double(p.num_lanes) * p.lane_speed) / slotsPerFlit),
+      reqHeaderBits(p.req_header_bits),
+      rwdHeaderBits(p.rwd_header_bits),
+      ndrHeaderBits(p.ndr_header_bits),
+      drsHeaderBits(p.drs_header_bits),
+      reqQueueLimit(p.req_size),
+      respQueueLimit(p.resp_size),
+      reqCredits(p.req_credits),
+      rwdCredits(p.rwd_credits),
+      outstandingResponses(0),
+      retryReq(false),
+      m2sEvent([this]{ processM2SEvent(); }, name() + ".m2s"),
+      deviceSendEvent([this]{ trySendReq(); }, name() + ".deviceSend"),
+      hostSendEvent([this]{ trySendResp(); }, name() + ".hostSend"),
+      creditEvent([this]{ processCreditEvent(); }, name() + ".credit"),
+      stats(*this)
+{
+    fatal_if(slotsPerFlit == 0 || slotsPerFlit * p.slot_size > flitSize,
+             "%s: %d slots of %d bytes do not fit in a %d byte flit\n",
+             name(), slotsPerFlit, p.slot_size, flitSize);
+    fatal_if(std::max({reqHeaderBits, rwdHeaderBits, ndrHeaderBits,
+                       drsHeaderBits}) > slotBits,
+             "%s: message headers must fit in a slot\n", name());
+    fatal_if(p.req_credits == 0 || p.rwd_credits == 0,
+             "%s: the device needs Req and RwD credits\n", name());
+}
+
+Port &
+CXLLink::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "mem_side_port")
+        return memSidePort;
+    else if (if_name == "cpu_side_port")
+        return cpuSidePort;
+    else
+        return ClockedObject::getPort(if_name, idx);
+}
+
+void
+CXLLink::init()
+{
+    if (!cpuSidePort.isConnected() || !memSidePort.isConnected())
+        fatal("Both ports of a CXL link must be connected.\n");
+
+    cpuSidePort.sendRangeChange();
+}
+
+Tick
+CXLLink::sendOnChannel(Channel &ch, unsigned header_bits,
+                       unsigned data_bytes, statistics::Scalar &slot_count,
+                       statistics::Scalar &busy_ticks)
+{
+    const Tick start = std::max(curTick(), ch.freeAt);
+    unsigned slots = divCeil(data_bytes * 8, slotBits);
+
+    // A message sent back-to-back with the previous one can share its
+    // header slot, otherwise it opens a new one
+    if (curTick() <= ch.freeAt && header_bits <= ch.headerBitsLeft) {
+        ch.headerBitsLeft -= header_bits;
+    } else {
+        ++slots;
+        ch.headerBitsLeft = slotBits - header_bits;
+    }
+
+    const Tick busy = std::ceil(slots * slotTicks);
+    ch.freeAt = start + busy;
+
+    slot_count += slots;
+    busy_ticks += busy;
+
+    return ch.freeAt;
+}
+
+Tick
+CXLLink::serializationLatency(unsigned data_bytes) const
+{
+    const unsigned slots = divCeil(data_bytes * 8, slotBits) + 1;
+    return std::ceil(slots * slotTicks);
+}
+
+bool
+CXLLink::recvTimingReq(PacketPtr pkt)
+{
+    DPRINTF(CXLLink, "recvTimingReq: %s addr %#x\n",
+            pkt->cmdString(), pkt->getAddr());
+
+    // we should not see a timing request if we are already in a retry
+    assert(!retryReq);
+
+    const bool expects_response = pkt->needsResponse() &&
+        !pkt->cacheResponding();
+
+    if (hostTxQueue.size() == reqQueueLimit ||
+        (expects_response && outstandingResponses == respQueueLimit)) {
+        DPRINTF(CXLLink, "Host queues full, tx %d, outstanding %d\n",
+                hostTxQueue.size(), outstandingResponses);
+        retryReq = true;
+        return false;
+    }
+
+    if (expects_response)
+        ++outstandingResponses;
+
+    // as in the bridge, the packet has only fully reached us after the
+    // header and payload delays, so it cannot reach the device earlier
+    const Tick received = curTick() + pkt->headerDelay + pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+
+    // a non-empty queue is either being sent or waiting for credits
+    if (hostTxQueue.empty())
+        schedule(m2sEvent, std::max(curTick(), m2s.freeAt));
+    hostTxQueue.push_back({pkt, received, curTick()});
+
+    return true;
+}
+
+void
+CXLLink::processM2SEvent()
+{
+    assert(!hostTxQueue.empty());
+
+    const Transfer &tx = hostTxQueue.front();
+    PacketPtr pkt = tx.pkt;
+
+    // wait for the device to free a buffer of the right class, the
+    // credit return restarts us
+    unsigned &credits = pkt->hasData() ? rwdCredits : reqCredits;
+    if (credits == 0) {
+        DPRINTF(CXLLink, "No %s credits for addr %#x\n",
+                pkt->hasData() ? "RwD" : "Req", pkt->getAddr());
+        stats.creditStalls++;
+        return;
+    }
+    --credits;
+
+    const Tick sent = sendOnChannel(m2s, m2sHeaderBits(pkt),
+                                    pkt->hasData() ? pkt->getSize() : 0,
+                                    stats.m2sSlots, stats.m2sBusyTicks);
+    if (pkt->hasData())
+        stats.m2sDataBytes += pkt->getSize();
+
+    // the flits go out while the packet is still arriving, but its
+    // end cannot leave before it was received
+    const Tick ready = std::max(sent, tx.ready) + delay;
+    if (deviceRxQueue.empty())
+        schedule(deviceSendEvent, ready);
+    deviceRxQueue.push_back({pkt, ready, tx.entry});
+    hostTxQueue.pop_front();
+
+    if (!hostTxQueue.empty())
+        schedule(m2sEvent, std::max(curTick(), m2s.freeAt));
+
+    retryStalledReq();
+}
+
+void
+CXLLink::trySendReq()
+{
+    assert(!deviceRxQueue.empty());
+
+    const Transfer tx = deviceRxQueue.front();
+    assert(tx.ready <= curTick());
+
+    const bool is_write = tx.pkt->hasData();
+    const bool is_read = tx.pkt->isRead();
+
+    DPRINTF(CXLLink, "trySendReq addr %#x, queue size %d\n",
+            tx.pkt->getAddr(), deviceRxQueue.size());
+
+    if (!memSidePort.sendTimingReq(tx.pkt)) {
+        // wait for a retry from the memory controller
+        return;
+    }
+
+    deviceRxQueue.pop_front();
+
+    if (is_write) {
+        stats.writeReqs++;
+        stats.totWriteLat += curTick() - tx.entry;
+    } else if (is_read) {
+        stats.readReqs++;
+        stats.totReadLat += curTick() - tx.entry;
+    }
+
+    // the device buffer is free again, tell the host
+    if (creditReturns.empty())
+        schedule(creditEvent, curTick() + delay);
+    creditReturns.emplace_back(curTick() + delay, is_write);
+
+    if (!deviceRxQueue.empty()) {
+        schedule(deviceSendEvent,
+                 std::max(curTick(), deviceRxQueue.front().ready));
+    }
+}
+
+void
+CXLLink::processCreditEvent()
+{
+    while (!creditReturns.empty() &&
+           creditReturns.front().first <= curTick()) {
+        if (creditReturns.front().second)
+            ++rwdCredits;
+        else
+            ++reqCredits;
+        creditReturns.pop_front();
+    }
+
+    if (!creditReturns.empty())
+        schedule(creditEvent, creditReturns.front().first);
+
+    if (!hostTxQueue.empty() && !m2sEvent.scheduled())
+        schedule(m2sEvent, std::max(curTick(), m2s.freeAt));
+    checkDrained();
+}
+
+bool
+CXLLink::recvTimingResp(PacketPtr pkt)
+{
+    // space for the response was reserved when the request was accepted
+    DPRINTF(CXLLink, "recvTimingResp: %s addr %#x\n",
+            pkt->cmdString(), pkt->getAddr());
+
+    const Tick received = curTick() + pkt->headerDelay + pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+
+    const Tick sent = sendOnChannel(s2m, s2mHeaderBits(pkt),
+                                    pkt->hasData() ? pkt->getSize() : 0,
+                                    stats.s2mSlots, stats.s2mBusyTicks);
+    if (pkt->hasData())
+        stats.s2mDataBytes += pkt->getSize();
+
+    // the channel is serial, so responses are delivered in order
+    const Tick ready = std::max(sent, received) + delay;
+    if (hostRxQueue.empty())
+        schedule(hostSendEvent, ready);
+    hostRxQueue.push_back({pkt, ready, curTick()});
+
+    return true;
+}
+
+void
+CXLLink::trySendResp()
+{
+    assert(!hostRxQueue.empty());
+
+    const Transfer tx = hostRxQueue.front();
+    assert(tx.ready <= curTick());
+
+    const bool is_read = tx.pkt->isRead();
+
+    DPRINTF(CXLLink, "trySendResp addr %#x, outstanding %d\n",
+            tx.pkt->getAddr(), outstandingResponses);
+
+    if (!cpuSidePort.sendTimingResp(tx.pkt))
+        return;
+
+    hostRxQueue.pop_front();
+
+    if (is_read)
+        stats.totReadLat += curTick() - tx.entry;
+    else
+        stats.totWriteLat += curTick() - tx.entry;
+
+    assert(outstandingResponses != 0);
+    --outstandingResponses;
+
+    if (!hostRxQueue.empty()) {
+        schedule(hostSendEvent,
+                 std::max(curTick(), hostRxQueue.front().ready));
+    }
+
+    retryStalledReq();
+    checkDrained();
+}
+
+void
+CXLLink::retryStalledReq()
+{
+    if (retryReq && hostTxQueue.size() < reqQueueLimit) {
+        DPRINTF(CXLLink, "Request waiting for retry, now retrying\n");
+        retryReq = false;
+        cpuSidePort.sendRetryReq();
+    }
+}
+
+bool
+CXLLink::busy() const
+{
+    return !hostTxQueue.empty() || !deviceRxQueue.empty() ||
+        !hostRxQueue.empty() || !creditReturns.empty();
+}
+
+void
+CXLLink::checkDrained()
+{
+    if (drainState() == DrainState::Draining && !busy()) {
+        DPRINTF(Drain, "CXL link done draining\n");
+        signalDrainDone();
+    }
+}
+
+DrainState
+CXLLink::drain()
+{
+    if (busy()) {
+        DPRINTF(Drain, "CXL link not drained\n");
+        return DrainState::Draining;
+    } else {
+        return DrainState::Drained;
+    }
+}
+
+Tick
+CXLLink::recvAtomic(PacketPtr pkt)
+{
+    const Tick req_lat =
+        serializationLatency(pkt->hasData() ? pkt->getSize() : 0);
+    const Tick mem_lat = memSidePort.sendAtomic(pkt);
+    const Tick resp_lat = pkt->isResponse() ?
+        serializationLatency(pkt->hasData() ? pkt->getSize() : 0) : 0;
+
+    return 2 * delay + req_lat + mem_lat + resp_lat;
+}
+
+void
+CXLLink::recvFunctional(PacketPtr pkt)
+{
+    pkt->pushLabel(name());
+
+    // check the responses on their way back and the requests on their
+    // way to memory
+    for (const auto *queue : {&hostRxQueue, &hostTxQueue, &deviceRxQueue}) {
+        for (const auto &tx : *queue) {
+            if (pkt->trySatisfyFunctional(tx.pkt)) {
+                pkt->makeResponse();
+                return;
+            }
+        }
+    }
+
+    pkt->popLabel();
+
+    memSidePort.sendFunctional(pkt);
+}
+
+CXLLink::LinkStats::LinkStats(CXLLink &_link)
+    : statistics::Group(&_link),
+    link(_link),
+
+    ADD_STAT(readReqs, statistics::units::Count::get(),
+             "Number of read requests sent to the device"),
+    ADD_STAT(writeReqs, statistics::units::Count::get(),
+             "Number of write requests sent to the device"),
+
+    ADD_STAT(m2sSlots, statistics::units::Count::get(),
+             "Number of slots sent host to device"),
+    ADD_STAT(s2mSlots, statistics::units::Count::get(),
+             "Number of slots sent device to host"),
+    ADD_STAT(m2sDataBytes, statistics::units::Byte::get(),
+             "Number of data bytes sent host to device"),
+    ADD_STAT(s2mDataBytes, statistics::units::Byte::get(),
+             "Number of data bytes sent device to host"),
+    ADD_STAT(m2sBusyTicks, statistics::units::Tick::get(),
+             "Time the host to device direction was busy"),
+    ADD_STAT(s2mBusyTicks, statistics::units::Tick::get(),
+             "Time the device to host direction was busy"),
+
+    ADD_STAT(m2sFlits, statistics::units::Count::get(),
+             "Number of flits sent host to device"),
+    ADD_STAT(s2mFlits, statistics::units::Count::get(),
+             "Number of flits sent device to host"),
+    ADD_STAT(m2sUtil, statistics::units::Ratio::get(),
+             "Utilization of the host to device direction"),
+    ADD_STAT(s2mUtil, statistics::units::Ratio::get(),
+             "Utilization of the device to host direction"),
+    ADD_STAT(m2sEfficiency, statistics::units::Ratio::get(),
+             "Fraction of the host to device flit bytes carrying data"),
+    ADD_STAT(s2mEfficiency, statistics::units::Ratio::get(),
+             "Fraction of the device to host flit bytes carrying data"),
+
+    ADD_STAT(creditStalls, statistics::units::Count::get(),
+             "Number of times the host ran out of device credits"),
+
+    ADD_STAT(totReadLat, statistics::units::Tick::get(),
+             "Total latency the link added to reads"),
+    ADD_STAT(totWriteLat, statistics::units::Tick::get(),
+             "Total latency the link added to writes"),
+    ADD_STAT(avgReadLat, statistics::units::Rate<
+                statistics::units::Tick, statistics::units::Count>::get(),
+             "Average latency the link added to a read"),
+    ADD_STAT(avgWriteLat, statistics::units::Rate<
+                statistics::units::Tick, statistics::units::Count>::get(),
+             "Average latency the link added to a write")
+{
+}
+
+void
+CXLLink::LinkStats::regStats()
+{
+    using namespace statistics;
+
+    m2sFlits = m2sSlots / link.slotsPerFlit;
+    s2mFlits = s2mSlots / link.slotsPerFlit;
+
+    m2sUtil.precision(4);
+    s2mUtil.precision(4);
+    m2sUtil = m2sBusyTicks / simTicks;
+    s2mUtil = s2mBusyTicks / simTicks;
+
+    m2sEfficiency.precision(4);
+    s2mEfficiency.precision(4);
+    m2sEfficiency = m2sDataBytes / (m2sFlits * link.flitSize);
+    s2mEfficiency = s2mDataBytes / (s2mFlits * link.flitSize);
+
+    avgReadLat.precision(2);
+    avgWriteLat.precision(2);
+    avgReadLat = totReadLat / readReqs;
+    avgWriteLat = totWriteLat / writeReqs;
+}
+
+} // namespace gem5
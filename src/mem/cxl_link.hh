@@ -0,0 +1,277 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the CXLLink class, modeling the CXL.mem link between a
+ * host and a Type-3 memory expander.
+ */
+
+#ifndef __MEM_CXL_LINK_HH__
+#define __MEM_CXL_LINK_HH__
+
+#include <deque>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/port.hh"
+#include "params/CXLLink.hh"
+#include "sim/clocked_object.hh"
+
+namespace gem5
+{
+
+/**
+ * CXLLink sits between the host and the memory controller of a CXL
+ * Type-3 device. Requests travel host-to-device (M2S) as Req messages
+ * for reads and RwD messages for writes; responses travel
+ * device-to-host (S2M) as DRS messages with data for reads and NDR
+ * messages for writes. Each direction is a serial channel carrying
+ * flits of fixed size made of slots: a message takes a header slot,
+ * unless its header fits in what is left of the previous header slot
+ * of a back-to-back message, plus one slot per slot-size chunk of
+ * data. Reads therefore load the S2M direction and writes the M2S one.
+ *
+ * The host only sends a message when the device has a buffer for its
+ * class, tracked with Req and RwD credits that return one link latency
+ * after the device hands the request to its memory controller. The host
+ * reserves space for responses when it accepts a request, so S2M
+ * messages are never refused.
+ */
+class CXLLink : public ClockedObject
+{
+  protected:
+
+    /** A packet in one of the link queues. */
+    struct Transfer
+    {
+        PacketPtr pkt;
+        /**
+         * When the packet may leave the queue. In the host tx queue,
+         * when the packet has been fully received instead, as sending
+         * it may start before that.
+         */
+        Tick ready;
+        /** When the packet entered the link in its direction. */
+        Tick entry;
+    };
+
+    class CpuSidePort : public ResponsePort
+    {
+      public:
+        CpuSidePort(const std::string &_name, CXLLink &_link)
+            : ResponsePort(_name, &_link), link(_link)
+        { }
+
+      protected:
+        bool recvTimingReq(PacketPtr pkt) override
+        { return link.recvTimingReq(pkt); }
+        void recvRespRetry() override { link.trySendResp(); }
+        Tick recvAtomic(PacketPtr pkt) override
+        { return link.recvAtomic(pkt); }
+        void recvFunctional(PacketPtr pkt) override
+        { link.recvFunctional(pkt); }
+        AddrRangeList getAddrRanges() const override { return link.ranges; }
+
+      private:
+        CXLLink &link;
+    };
+
+    class MemSidePort : public RequestPort
+    {
+      public:
+        MemSidePort(const std::string &_name, CXLLink &_link)
+            : RequestPort(_name, &_link), link(_link)
+        { }
+
+      protected:
+        bool recvTimingResp(PacketPtr pkt) override
+        { return link.recvTimingResp(pkt); }
+        void recvReqRetry() override { link.trySendReq(); }
+
+      private:
+        CXLLink &link;
+    };
+
+    /** State of one direction of the link. */
+    struct Channel
+    {
+        /** When the last flit slot in flight has been serialized. */
+        Tick freeAt = 0;
+        /** Header bits still free in the last header slot. */
+        unsigned headerBitsLeft = 0;
+    };
+
+    CpuSidePort cpuSidePort;
+    MemSidePort memSidePort;
+
+    const AddrRangeList ranges;
+
+    /** One-way latency of the link and the controllers at its ends. */
+    const Tick delay;
+
+    const unsigned slotBits;
+    const unsigned slotsPerFlit;
+    const unsigned flitSize;
+
+    /** Ticks it takes to serialize one slot. */
+    const double slotTicks;
+
+    const unsigned reqHeaderBits;
+    const unsigned rwdHeaderBits;
+    const unsigned ndrHeaderBits;
+    const unsigned drsHeaderBits;
+
+    const unsigned reqQueueLimit;
+    const unsigned respQueueLimit;
+
+    unsigned reqCredits;
+    unsigned rwdCredits;
+
+    Channel m2s;
+    Channel s2m;
+
+    /** Host transmit queue, waiting for credits and the M2S channel. */
+    std::deque<Transfer> hostTxQueue;
+    /** Requests arrived at the device, waiting for the controller. */
+    std::deque<Transfer> deviceRxQueue;
+    /** Responses arrived at the host, waiting for the requestor. */
+    std::deque<Transfer> hostRxQueue;
+
+    /** Credits on their way back to the host, RwD if true. */
+    std::deque<std::pair<Tick, bool>> creditReturns;
+
+    unsigned outstandingResponses;
+    bool retryReq;
+
+    EventFunctionWrapper m2sEvent;
+    EventFunctionWrapper deviceSendEvent;
+    EventFunctionWrapper hostSendEvent;
+    EventFunctionWrapper creditEvent;
+
+    bool recvTimingReq(PacketPtr pkt);
+    bool recvTimingResp(PacketPtr pkt);
+    Tick recvAtomic(PacketPtr pkt);
+    void recvFunctional(PacketPtr pkt);
+
+    /** Put the message at the head of the host queue on the link. */
+    void processM2SEvent();
+    void processCreditEvent();
+
+    /** Hand the request at the head of the device queue to memory. */
+    void trySendReq();
+    /** Hand the response at the head of the host queue back. */
+    void trySendResp();
+
+    void retryStalledReq();
+
+    /** Are there packets or credits in flight on the link. */
+    bool busy() const;
+
+    /** Signal the end of a drain once the link is idle. */
+    void checkDrained();
+
+    /**
+     * Send a message on a channel, serializing it in flit slots.
+     *
+     * @param ch the direction the message travels in
+     * @param header_bits size of the message header
+     * @param data_bytes payload carried by the message
+     * @param slot_count stat counting the slots of the channel
+     * @param busy_ticks stat counting the busy time of the channel
+     * @return the tick at which the last slot is on the wire
+     */
+    Tick sendOnChannel(Channel &ch, unsigned header_bits,
+                       unsigned data_bytes, statistics::Scalar &slot_count,
+                       statistics::Scalar &busy_ticks);
+
+    /**
+     * Uncontended time to serialize a message with a header slot of its
+     * own, used for atomic accesses.
+     */
+    Tick serializationLatency(unsigned data_bytes) const;
+
+    /** Bits of the M2S header a request is sent with. */
+    unsigned m2sHeaderBits(PacketPtr pkt) const
+    { return pkt->hasData() ? rwdHeaderBits : reqHeaderBits; }
+
+    /** Bits of the S2M header a response is sent with. */
+    unsigned s2mHeaderBits(PacketPtr pkt) const
+    { return pkt->hasData() ? drsHeaderBits : ndrHeaderBits; }
+
+    struct LinkStats : public statistics::Group
+    {
+        LinkStats(CXLLink &link);
+
+        void regStats() override;
+
+        const CXLLink &link;
+
+        statistics::Scalar readReqs;
+        statistics::Scalar writeReqs;
+
+        statistics::Scalar m2sSlots;
+        statistics::Scalar s2mSlots;
+        statistics::Scalar m2sDataBytes;
+        statistics::Scalar s2mDataBytes;
+        statistics::Scalar m2sBusyTicks;
+        statistics::Scalar s2mBusyTicks;
+
+        statistics::Formula m2sFlits;
+        statistics::Formula s2mFlits;
+        statistics::Formula m2sUtil;
+        statistics::Formula s2mUtil;
+        statistics::Formula m2sEfficiency;
+        statistics::Formula s2mEfficiency;
+
+        statistics::Scalar creditStalls;
+
+        statistics::Scalar totReadLat;
+        statistics::Scalar totWriteLat;
+        statistics::Formula avgReadLat;
+        statistics::Formula avgWriteLat;
+    };
+
+    LinkStats stats;
+
+  public:
+
+    PARAMS(CXLLink);
+    CXLLink(const Params &p);
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+    void init() override;
+
+    DrainState drain() override;
+};
+
+} // namespace gem5
+
+#endif //__MEM_CXL_LINK_HH__
@@ -0,0 +1,295 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_DRAM_FRFCFS_HH__
+#define __MEM_DRAM_FRFCFS_HH__
+
+#include <algorithm>
+#include <list>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * The FR-FCFS selection of the DRAM interface. It only looks at the
+ * bank state and at the queued packets, indexed per bank as done by
+ * MemPacketQueue, so it does not depend on the interface itself.
+ *
+ * The ranks are accessed as ranks[i]->inRefIdleState() and
+ * ranks[i]->banks[j], and the packets need row, rank, bank, isRead()
+ * and queueSeq, which orders them by arrival. All the packets of a
+ * queue go in the same direction, as the controller keeps reads and
+ * writes in separate queues.
+ */
+namespace frfcfs
+{
+
+/** Timing of the data bus for one scheduling decision */
+struct BusState
+{
+    /** Current tick */
+    Tick now;
+    /** Tick at which a burst can issue seamlessly */
+    Tick minColAt;
+    Tick tRP;
+    /** Activate to column delay for the current bus direction */
+    Tick tRCD;
+    /** Is the bus in the read state */
+    bool readBus;
+};
+
+/**
+ * Find which are the earliest banks ready to issue an activate
+ * for the enqueued requests, and the oldest request to one of
+ * those banks that misses in the open row.
+ * Also checks if the bank is already prepped.
+ *
+ * @param bank_queues Queued requests to consider, per bank
+ * @param ranks Ranks of the channel
+ * @param banks_per_rank Number of banks of every rank
+ * @param bus Timing of the data bus
+ * @return Oldest row miss to one of the earliest banks, or nullptr
+ * @return boolean indicating the bank can be prepped without
+ *         delaying the data bus
+ */
+template <typename Pkt, typename Ranks>
+std::pair<Pkt*, bool>
+minBankPrep(const std::vector<std::list<Pkt*>>& bank_queues,
+            const Ranks& ranks, unsigned banks_per_rank,
+            const BusState& bus)
+{
+    Tick min_act_at = MaxTick;
+
+    // Oldest row miss amongst the banks found so far
+    Pkt* earliest_pkt = nullptr;
+
+    // Flag condition when burst can issue back-to-back with previous burst
+    bool found_seamless_bank = false;
+
+    // Flag condition when bank can be opened without incurring additional
+    // delay on the data bus
+    bool hidden_bank_prep = false;
+
+    // latest Tick for which ACT can occur without
+    // incurring additoinal delay on the data bus
+    const Tick hidden_act_max = std::max(bus.minColAt - bus.tRCD, bus.now);
+
+    // Find command with optimal bank timing
+    // Will prioritize commands that can issue seamlessly.
+    for (unsigned i = 0; i < ranks.size(); i++) {
+        // requests to a rank that is refreshing cannot be considered
+        if (!ranks[i]->inRefIdleState())
+            continue;
+
+        for (unsigned j = 0; j < banks_per_rank; j++) {
+            unsigned bank_id = i * banks_per_rank + j;
+            if (bank_id >= bank_queues.size())
+                break;
+
+            // if we have waiting requests for the bank, and it is
+            // amongst the first available, update the mask
+            if (!bank_queues[bank_id].empty()) {
+                const auto& bank = ranks[i]->banks[j];
+                // simplistic approximation of when the bank can issue
+                // an activate, ignoring any rank-to-rank switching
+                // cost in this calculation
+                Tick act_at = bank.openRow == bank.NO_ROW ?
+                    std::max(bank.actAllowedAt, bus.now) :
+                    std::max(bank.preAllowedAt, bus.now) + bus.tRP;
+
+                // When is the earliest the R/W burst can issue?
+                const Tick col_allowed_at = bus.readBus ?
+                    bank.rdAllowedAt : bank.wrAllowedAt;
+                Tick col_at = std::max(col_allowed_at, act_at + bus.tRCD);
+
+                // bank can issue burst back-to-back (seamlessly) with
+                // previous burst
+                bool new_seamless_bank = col_at <= bus.minColAt;
+
+                // if we found a new seamless bank or we have no
+                // seamless banks, and got a bank with an earlier
+                // activate time, it should be added to the set of
+                // earliest banks
+                if (new_seamless_bank ||
+                    (!found_seamless_bank && act_at <= min_act_at)) {
+                    // if we did not have a seamless bank before, and
+                    // we do now, forget the banks found so far, also
+                    // do so if we have not yet found a seamless bank
+                    // and the activate time is smaller than what we
+                    // have seen so far
+                    if (!found_seamless_bank &&
+                        (new_seamless_bank || act_at < min_act_at)) {
+                        earliest_pkt = nullptr;
+                    }
+
+                    found_seamless_bank |= new_seamless_bank;
+
+                    // ACT can occur 'behind the scenes'
+                    hidden_bank_prep = act_at <= hidden_act_max;
+
+                    // the oldest row miss to this bank is a candidate
+                    for (Pkt* pkt : bank_queues[bank_id]) {
+                        if (pkt->row != bank.openRow) {
+                            if (!earliest_pkt ||
+                                pkt->queueSeq < earliest_pkt->queueSeq) {
+                                earliest_pkt = pkt;
+                            }
+                            break;
+                        }
+                    }
+                    min_act_at = act_at;
+                }
+            }
+        }
+    }
+
+    return std::make_pair(earliest_pkt, hidden_bank_prep);
+}
+
+/**
+ * Select the next packet to issue. Only the oldest row hit and the
+ * oldest row miss of each bank can be selected. Amongst those, pick
+ * the oldest packet of the most preferred kind, which is the packet a
+ * walk of the whole queue would pick: seamless row hits first, then a
+ * closed row whose bank can be prepped behind the scenes, then a
+ * prepped row hit, and finally a row miss to one of the banks that
+ * can activate first.
+ *
+ * @param bank_queues Queued requests to consider, per bank, or nullptr
+ *                    if there are none
+ * @param ranks Ranks of the channel
+ * @param banks_per_rank Number of banks of every rank
+ * @param bus Timing of the data bus
+ * @return the selected packet, else nullptr
+ * @return the tick when the packet selected will issue, else MaxTick
+ */
+template <typename Pkt, typename Ranks>
+std::pair<Pkt*, Tick>
+chooseNext(const std::vector<std::list<Pkt*>>* bank_queues,
+           const Ranks& ranks, unsigned banks_per_rank, const BusState& bus)
+{
+    // oldest row hit that can issue seamlessly
+    Pkt* seamless_pkt = nullptr;
+    Tick seamless_col_at = MaxTick;
+
+    // oldest row hit, not seamless, but bank prepped and ready
+    Pkt* prepped_pkt = nullptr;
+    Tick prepped_col_at = MaxTick;
+
+    // is there any row miss that could be considered
+    bool found_row_miss = false;
+
+    for (unsigned i = 0; bank_queues && i < ranks.size(); i++) {
+        // check if rank is not doing a refresh and thus is available,
+        // if not, none of its packets can be selected
+        if (!ranks[i]->inRefIdleState())
+            continue;
+
+        for (unsigned j = 0; j < banks_per_rank; j++) {
+            unsigned bank_id = i * banks_per_rank + j;
+            if (bank_id >= bank_queues->size())
+                break;
+
+            const auto& bank = ranks[i]->banks[j];
+            Pkt* hit_pkt = nullptr;
+            for (Pkt* pkt : (*bank_queues)[bank_id]) {
+                if (bank.openRow == pkt->row) {
+                    hit_pkt = hit_pkt ? hit_pkt : pkt;
+                } else {
+                    found_row_miss = true;
+                }
+                if (hit_pkt && found_row_miss)
+                    break;
+            }
+
+            if (!hit_pkt)
+                continue;
+
+            const Tick col_allowed_at = hit_pkt->isRead() ?
+                bank.rdAllowedAt : bank.wrAllowedAt;
+
+            // no additional rank-to-rank or same bank-group
+            // delays, or we switched read/write and might as well
+            // go for the row hit
+            if (col_allowed_at <= bus.minColAt) {
+                // FCFS within the hits, giving priority to
+                // commands that can issue seamlessly, without
+                // additional delay, such as same rank accesses
+                // and/or different bank-group accesses
+                if (!seamless_pkt ||
+                    hit_pkt->queueSeq < seamless_pkt->queueSeq) {
+                    seamless_pkt = hit_pkt;
+                    seamless_col_at = col_allowed_at;
+                }
+            } else if (!prepped_pkt ||
+                       hit_pkt->queueSeq < prepped_pkt->queueSeq) {
+                prepped_pkt = hit_pkt;
+                prepped_col_at = col_allowed_at;
+            }
+        }
+    }
+
+    if (seamless_pkt)
+        return std::make_pair(seamless_pkt, seamless_col_at);
+
+    // if we have no seamless row hit, determine the oldest packet to
+    // one of the first available banks; minBankPrep will give priority
+    // to banks that can issue seamlessly
+    Pkt* earliest_pkt = nullptr;
+    bool hidden_bank_prep = false;
+    if (found_row_miss) {
+        std::tie(earliest_pkt, hidden_bank_prep) =
+            minBankPrep(*bank_queues, ranks, banks_per_rank, bus);
+    }
+
+    // give priority to packets that can issue bank commands 'behind the
+    // scenes', any additional delay if any will be due to col-to-col
+    // command requirements; otherwise prefer a prepped row hit
+    if (earliest_pkt && (hidden_bank_prep || !prepped_pkt)) {
+        const auto& bank =
+            ranks[earliest_pkt->rank]->banks[earliest_pkt->bank];
+        return std::make_pair(earliest_pkt, earliest_pkt->isRead() ?
+                              bank.rdAllowedAt : bank.wrAllowedAt);
+    }
+
+    return std::make_pair(prepped_pkt, prepped_col_at);
+}
+
+} // namespace frfcfs
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_DRAM_FRFCFS_HH__
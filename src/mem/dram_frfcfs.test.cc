@@ -0,0 +1,266 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "mem/dram_frfcfs.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+struct Bank
+{
+    static const uint32_t NO_ROW = -1;
+
+    uint32_t openRow = NO_ROW;
+    Tick rdAllowedAt = 0;
+    Tick wrAllowedAt = 0;
+    Tick preAllowedAt = 0;
+    Tick actAllowedAt = 0;
+};
+
+struct Rank
+{
+    bool refreshing = false;
+    std::vector<Bank> banks;
+
+    bool inRefIdleState() const { return !refreshing; }
+};
+
+struct Packet
+{
+    bool read;
+    uint8_t rank;
+    uint8_t bank;
+    uint32_t row;
+    uint16_t bankId;
+    uint64_t queueSeq;
+
+    bool isRead() const { return read; }
+};
+
+/**
+ * The FR-FCFS selection as a walk of the whole queue, in the way the
+ * DRAM interface used to do it before the queues were indexed per bank.
+ */
+class QueueWalk
+{
+  public:
+    QueueWalk(const std::vector<Rank*>& ranks, unsigned banks_per_rank,
+              const frfcfs::BusState& bus)
+        : ranks(ranks), banksPerRank(banks_per_rank), bus(bus)
+    {}
+
+    std::pair<Packet*, Tick>
+    chooseNext(const std::vector<Packet*>& queue) const
+    {
+        std::vector<uint32_t> earliest_banks(ranks.size(), 0);
+        bool filled_earliest_banks = false;
+        bool hidden_bank_prep = false;
+        bool found_hidden_bank = false;
+        bool found_prepped_pkt = false;
+        bool found_earliest_pkt = false;
+
+        Tick selected_col_at = MaxTick;
+        Packet* selected_pkt = nullptr;
+
+        for (Packet* pkt : queue) {
+            const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
+            const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
+                                                        bank.wrAllowedAt;
+            if (!ranks[pkt->rank]->inRefIdleState())
+                continue;
+
+            if (bank.openRow == pkt->row) {
+                if (col_allowed_at <= bus.minColAt) {
+                    selected_pkt = pkt;
+                    selected_col_at = col_allowed_at;
+                    break;
+                } else if (!found_hidden_bank && !found_prepped_pkt) {
+                    selected_pkt = pkt;
+                    selected_col_at = col_allowed_at;
+                    found_prepped_pkt = true;
+                }
+            } else if (!found_earliest_pkt) {
+                if (!filled_earliest_banks) {
+                    std::tie(earliest_banks, hidden_bank_prep) =
+                        minBankPrep(queue);
+                    filled_earliest_banks = true;
+                }
+
+                if ((earliest_banks[pkt->rank] >> pkt->bank) & 1) {
+                    found_earliest_pkt = true;
+                    found_hidden_bank = hidden_bank_prep;
+                    if (hidden_bank_prep || !found_prepped_pkt) {
+                        selected_pkt = pkt;
+                        selected_col_at = col_allowed_at;
+                    }
+                }
+            }
+        }
+
+        return std::make_pair(selected_pkt, selected_col_at);
+    }
+
+  private:
+    std::pair<std::vector<uint32_t>, bool>
+    minBankPrep(const std::vector<Packet*>& queue) const
+    {
+        Tick min_act_at = MaxTick;
+        std::vector<uint32_t> bank_mask(ranks.size(), 0);
+        bool found_seamless_bank = false;
+        bool hidden_bank_prep = false;
+
+        std::vector<bool> got_waiting(ranks.size() * banksPerRank, false);
+        for (const Packet* p : queue) {
+            if (ranks[p->rank]->inRefIdleState())
+                got_waiting[p->bankId] = true;
+        }
+
+        for (unsigned i = 0; i < ranks.size(); i++) {
+            for (unsigned j = 0; j < banksPerRank; j++) {
+                if (!got_waiting[i * banksPerRank + j])
+                    continue;
+
+                const Bank& bank = ranks[i]->banks[j];
+                Tick act_at = bank.openRow == Bank::NO_ROW ?
+                    std::max(bank.actAllowedAt, bus.now) :
+                    std::max(bank.preAllowedAt, bus.now) + bus.tRP;
+                const Tick hidden_act_max =
+                    std::max(bus.minColAt - bus.tRCD, bus.now);
+                const Tick col_allowed_at = bus.readBus ?
+                    bank.rdAllowedAt : bank.wrAllowedAt;
+                Tick col_at = std::max(col_allowed_at, act_at + bus.tRCD);
+                bool new_seamless_bank = col_at <= bus.minColAt;
+
+                if (new_seamless_bank ||
+                    (!found_seamless_bank && act_at <= min_act_at)) {
+                    if (!found_seamless_bank &&
+                        (new_seamless_bank || act_at < min_act_at)) {
+                        std::fill(bank_mask.begin(), bank_mask.end(), 0);
+                    }
+                    found_seamless_bank |= new_seamless_bank;
+                    hidden_bank_prep = act_at <= hidden_act_max;
+                    bank_mask[i] |= 1 << j;
+                    min_act_at = act_at;
+                }
+            }
+        }
+
+        return std::make_pair(bank_mask, hidden_bank_prep);
+    }
+
+    const std::vector<Rank*>& ranks;
+    const unsigned banksPerRank;
+    const frfcfs::BusState& bus;
+};
+
+} // anonymous namespace
+
+/**
+ * On random bank states and queues, the per bank selection picks the
+ * same packet, issuing at the same tick, as the walk of the whole queue.
+ */
+TEST(DRAMFRFCFSTest, MatchesQueueWalk)
+{
+    std::mt19937 rng(1);
+    auto rand = [&rng](unsigned max) {
+        return std::uniform_int_distribution<unsigned>(0, max)(rng);
+    };
+
+    const Tick now = 1000;
+    // Ticks around now, so that all the timing checks go both ways
+    auto tick = [&]() { return now - 40 + 10 * rand(8); };
+
+    for (int iter = 0; iter < 20000; iter++) {
+        const unsigned ranks_per_channel = 1 + rand(3);
+        const unsigned banks_per_rank = 1 + rand(15);
+        const unsigned num_rows = 1 + rand(3);
+
+        std::vector<Rank> rank_state(ranks_per_channel);
+        std::vector<Rank*> ranks;
+        for (auto& rank : rank_state) {
+            rank.refreshing = rand(7) == 0;
+            rank.banks.resize(banks_per_rank);
+            for (auto& bank : rank.banks) {
+                bank.openRow = rand(num_rows) == 0 ? Bank::NO_ROW :
+                                                     rand(num_rows - 1);
+                bank.rdAllowedAt = tick();
+                bank.wrAllowedAt = tick();
+                bank.preAllowedAt = tick();
+                bank.actAllowedAt = tick();
+            }
+            ranks.push_back(&rank);
+        }
+
+        const bool read_bus = rand(1);
+        const frfcfs::BusState bus{now, tick(), 10 + 10 * rand(2),
+                                   10 + 10 * rand(2), read_bus};
+
+        // Queue the packets as MemPacketQueue does, both in queue
+        // order and in the list of their bank. As in the controller,
+        // reads and writes are in different queues.
+        const bool read_queue = rand(1);
+        const unsigned num_pkts = rand(48);
+        std::vector<Packet> pkts(num_pkts);
+        std::vector<Packet*> queue;
+        std::vector<std::list<Packet*>> bank_queues;
+        for (unsigned n = 0; n < num_pkts; n++) {
+            Packet& pkt = pkts[n];
+            pkt.read = read_queue;
+            pkt.rank = rand(ranks_per_channel - 1);
+            pkt.bank = rand(banks_per_rank - 1);
+            pkt.row = rand(num_rows - 1);
+            pkt.bankId = pkt.rank * banks_per_rank + pkt.bank;
+            pkt.queueSeq = n;
+            queue.push_back(&pkt);
+            if (pkt.bankId >= bank_queues.size())
+                bank_queues.resize(pkt.bankId + 1);
+            bank_queues[pkt.bankId].push_back(&pkt);
+        }
+
+        auto expected =
+            QueueWalk(ranks, banks_per_rank, bus).chooseNext(queue);
+        auto selected = frfcfs::chooseNext(
+            num_pkts ? &bank_queues : nullptr, ranks, banks_per_rank, bus);
+
+        ASSERT_EQ(selected.first, expected.first) << "iteration " << iter;
+        if (expected.first) {
+            ASSERT_EQ(selected.second, expected.second)
+                << "iteration " << iter;
+        }
+    }
+}
@@ -46,6 +46,7 @@
 #include "debug/DRAM.hh"
 #include "debug/DRAMPower.hh"
 #include "debug/DRAMState.hh"
+#include "mem/dram_frfcfs.hh"
 #include "sim/system.hh"
 
 namespace gem5
@@ -59,116 +60,23 @@ namespace memory
 std::pair<MemPacketQueue::iterator, Tick>
 DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
 {
-    std::vector<uint32_t> earliest_banks(ranksPerChannel, 0);
-
-    // Has minBankPrep been called to populate earliest_banks?
-    bool filled_earliest_banks = false;
-    // can the PRE/ACT sequence be done without impacting utlization?
-    bool hidden_bank_prep = false;
-
-    // search for seamless row hits first, if no seamless row hit is
-    // found then determine if there are other packets that can be issued
-    // without incurring additional bus delay due to bank timing
-    // Will select closed rows first to enable more open row possibilies
-    // in future selections
-    bool found_hidden_bank = false;
-
-    // remember if we found a row hit, not seamless, but bank prepped
-    // and ready
-    bool found_prepped_pkt = false;
-
-    // if we have no row hit, prepped or not, and no seamless packet,
-    // just go for the earliest possible
-    bool found_earliest_pkt = false;
-
-    Tick selected_col_at = MaxTick;
-    auto selected_pkt_it = queue.end();
-
-    for (auto i = queue.begin(); i != queue.end() ; ++i) {
-        MemPacket* pkt = *i;
-
-        // select optimal DRAM packet in Q
-        if (pkt->isDram() && (pkt->pseudoChannel == pseudoChannel)) {
-            const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
-            const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
-                                                        bank.wrAllowedAt;
-
-            DPRINTF(DRAM, "%s checking DRAM packet in bank %d, row %d\n",
-                    __func__, pkt->bank, pkt->row);
-
-            // check if rank is not doing a refresh and thus is available,
-            // if not, jump to the next packet
-            if (burstReady(pkt)) {
-
-                DPRINTF(DRAM,
-                        "%s bank %d - Rank %d available\n", __func__,
-                        pkt->bank, pkt->rank);
-
-                // check if it is a row hit
-                if (bank.openRow == pkt->row) {
-                    // no additional rank-to-rank or same bank-group
-                    // delays, or we switched read/write and might as well
-                    // go for the row hit
-                    if (col_allowed_at <= min_col_at) {
-                        // FCFS within the hits, giving priority to
-                        // commands that can issue seamlessly, without
-                        // additional delay, such as same rank accesses
-                        // and/or different bank-group accesses
-                        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        // no need to look through the remaining queue entries
-                        break;
-                    } else if (!found_hidden_bank && !found_prepped_pkt) {
-                        // if we did not find a packet to a closed row that can
-                        // issue the bank commands without incurring delay, and
-                        // did not yet find a packet to a prepped row, remember
-                        // the current one
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        found_prepped_pkt = true;
-                        DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
-                    }
-                } else if (!found_earliest_pkt) {
-                    // if we have not initialised the bank status, do it
-                    // now, and only once per scheduling decisions
-                    if (!filled_earliest_banks) {
-                        // determine entries with earliest bank delay
-                        std::tie(earliest_banks, hidden_bank_prep) =
-                            minBankPrep(queue, min_col_at);
-                        filled_earliest_banks = true;
-                    }
+    const bool read_bus = ctrl->inReadBusState(false);
+    const frfcfs::BusState bus{curTick(), min_col_at, tRP,
+                               read_bus ? tRCD_RD : tRCD_WR, read_bus};
 
-                    // bank is amongst first available banks
-                    // minBankPrep will give priority to packets that can
-                    // issue seamlessly
-                    if (bits(earliest_banks[pkt->rank],
-                             pkt->bank, pkt->bank)) {
-                        found_earliest_pkt = true;
-                        found_hidden_bank = hidden_bank_prep;
-
-                        // give priority to packets that can issue
-                        // bank commands 'behind the scenes'
-                        // any additional delay if any will be due to
-                        // col-to-col command requirements
-                        if (hidden_bank_prep || !found_prepped_pkt) {
-                            selected_pkt_it = i;
-                            selected_col_at = col_allowed_at;
-                        }
-                    }
-                }
-            } else {
-                DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
-                        pkt->bank, pkt->rank);
-            }
-        }
-    }
+    MemPacket* pkt;
+    Tick col_at;
+    std::tie(pkt, col_at) = frfcfs::chooseNext(
+        queue.bankQueues(true, pseudoChannel), ranks, banksPerRank, bus);
 
-    if (selected_pkt_it == queue.end()) {
+    if (!pkt) {
         DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
+        return std::make_pair(queue.end(), MaxTick);
     }
 
-    return std::make_pair(selected_pkt_it, selected_col_at);
+    DPRINTF(DRAM, "%s selected bank %d, rank %d, row %d\n", __func__,
+            pkt->bank, pkt->rank, pkt->row);
+    return std::make_pair(MemPacketQueue::position(pkt), col_at);
 }
 
 void
@@ -657,6 +565,7 @@ DRAMInterface::DRAMInterface(const DRAMInterfaceParams &_p)
       maxAccessesPerRow(_p.max_accesses_per_row),
       timeStampOffset(0), activeRank(0),
       enableDRAMPowerdown(_p.enable_dram_powerdown),
+      bulkIdleRefresh(_p.bulk_idle_refresh),
       lastStatsResetTick(0),
       stats(*this)
 {
@@ -798,6 +707,9 @@ DRAMInterface::isBusy(bool read_queue_empty, bool all_writes_nvm)
 {
     int busy_ranks = 0;
     for (auto r : ranks) {
+        // the scheduler is about to look at the rank state
+        r->resumeRefresh();
+
         if (!r->inRefIdleState()) {
             if (r->pwrState != PWR_SREF) {
                 // rank is busy refreshing
@@ -919,6 +831,8 @@ DRAMInterface::decodePacket(const PacketPtr pkt, Addr pkt_addr,
 
 void DRAMInterface::setupRank(const uint8_t rank, const bool is_read)
 {
+    ranks[rank]->resumeRefresh();
+
     // increment entry count of the rank based on packet type
     if (is_read) {
         ++ranks[rank]->readEntries;
@@ -1024,101 +938,12 @@ DRAMInterface::suspend()
     }
 }
 
-std::pair<std::vector<uint32_t>, bool>
-DRAMInterface::minBankPrep(const MemPacketQueue& queue,
-                      Tick min_col_at) const
-{
-    Tick min_act_at = MaxTick;
-    std::vector<uint32_t> bank_mask(ranksPerChannel, 0);
-
-    // Flag condition when burst can issue back-to-back with previous burst
-    bool found_seamless_bank = false;
-
-    // Flag condition when bank can be opened without incurring additional
-    // delay on the data bus
-    bool hidden_bank_prep = false;
-
-    // determine if we have queued transactions targetting the
-    // bank in question
-    std::vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
-    for (const auto& p : queue) {
-        if (p->pseudoChannel != pseudoChannel)
-            continue;
-        if (p->isDram() && ranks[p->rank]->inRefIdleState())
-            got_waiting[p->bankId] = true;
-    }
-
-    // Find command with optimal bank timing
-    // Will prioritize commands that can issue seamlessly.
-    for (int i = 0; i < ranksPerChannel; i++) {
-        for (int j = 0; j < banksPerRank; j++) {
-            uint16_t bank_id = i * banksPerRank + j;
-
-            // if we have waiting requests for the bank, and it is
-            // amongst the first available, update the mask
-            if (got_waiting[bank_id]) {
-                // make sure this rank is not currently refreshing.
-                assert(ranks[i]->inRefIdleState());
-                // simplistic approximation of when the bank can issue
-                // an activate, ignoring any rank-to-rank switching
-                // cost in this calculation
-                Tick act_at = ranks[i]->banks[j].openRow == Bank::NO_ROW ?
-                    std::max(ranks[i]->banks[j].actAllowedAt, curTick()) :
-                    std::max(ranks[i]->banks[j].preAllowedAt, curTick()) + tRP;
-
-                // latest Tick for which ACT can occur without
-                // incurring additoinal delay on the data bus
-                const Tick tRCD = ctrl->inReadBusState(false) ?
-                                                 tRCD_RD : tRCD_WR;
-                const Tick hidden_act_max =
-                            std::max(min_col_at - tRCD, curTick());
-
-                // When is the earliest the R/W burst can issue?
-                const Tick col_allowed_at = ctrl->inReadBusState(false) ?
-                                              ranks[i]->banks[j].rdAllowedAt :
-                                              ranks[i]->banks[j].wrAllowedAt;
-                Tick col_at = std::max(col_allowed_at, act_at + tRCD);
-
-                // bank can issue burst back-to-back (seamlessly) with
-                // previous burst
-                bool new_seamless_bank = col_at <= min_col_at;
-
-                // if we found a new seamless bank or we have no
-                // seamless banks, and got a bank with an earlier
-                // activate time, it should be added to the bit mask
-                if (new_seamless_bank ||
-                    (!found_seamless_bank && act_at <= min_act_at)) {
-                    // if we did not have a seamless bank before, and
-                    // we do now, reset the bank mask, also reset it
-                    // if we have not yet found a seamless bank and
-                    // the activate time is smaller than what we have
-                    // seen so far
-                    if (!found_seamless_bank &&
-                        (new_seamless_bank || act_at < min_act_at)) {
-                        std::fill(bank_mask.begin(), bank_mask.end(), 0);
-                    }
-
-                    found_seamless_bank |= new_seamless_bank;
-
-                    // ACT can occur 'behind the scenes'
-                    hidden_bank_prep = act_at <= hidden_act_max;
-
-                    // set the bit corresponding to the available bank
-                    replaceBits(bank_mask[i], j, j, 1);
-                    min_act_at = act_at;
-                }
-            }
-        }
-    }
-
-    return std::make_pair(bank_mask, hidden_bank_prep);
-}
-
 DRAMInterface::Rank::Rank(const DRAMInterfaceParams &_p,
                          int _rank, DRAMInterface& _dram)
     : EventManager(&_dram), dram(_dram),
       pwrStateTrans(PWR_IDLE), pwrStatePostRefresh(PWR_IDLE),
-      pwrStateTick(0), refreshDueAt(0), pwrState(PWR_IDLE),
+      pwrStateTick(0), refreshDueAt(0), idleRefresh(false),
+      idleRefreshAt(0), pwrState(PWR_IDLE),
       refreshState(REF_IDLE), inLowPowerState(false), rank(_rank),
       readEntries(0), writeEntries(0), outstandingEvents(0),
       wakeUpAllowedAt(0), power(_p, false), banks(_p.banks_per_rank),
@@ -1167,6 +992,8 @@ DRAMInterface::Rank::startup(Tick ref_tick)
 void
 DRAMInterface::Rank::suspend()
 {
+    resumeRefresh();
+
     deschedule(refreshEvent);
 
     // Update the stats
@@ -1176,6 +1003,94 @@ DRAMInterface::Rank::suspend()
     pwrStatePostRefresh = PWR_IDLE;
 }
 
+bool
+DRAMInterface::Rank::canSkipRefresh() const
+{
+    // with power-down enabled an idle rank goes to self-refresh instead
+    return dram.bulkIdleRefresh && !dram.enableDRAMPowerdown &&
+        pwrState == PWR_IDLE && refreshState == REF_IDLE &&
+        numBanksActive == 0 && outstandingEvents == 0 &&
+        readEntries == 0 && writeEntries == 0 &&
+        refreshEvent.scheduled() && !powerEvent.scheduled() &&
+        !activateEvent.scheduled() && !prechargeEvent.scheduled() &&
+        !writeDoneEvent.scheduled() && !wakeUpEvent.scheduled() &&
+        dram.ctrl->drainState() == DrainState::Running &&
+        dram.ctrl->getTotalReadQueueSize() == 0 &&
+        dram.ctrl->getTotalWriteQueueSize() == 0 &&
+        !dram.ctrl->respondEventScheduled() &&
+        !dram.ctrl->requestEventScheduled(dram.pseudoChannel);
+}
+
+void
+DRAMInterface::Rank::resumeRefresh()
+{
+    if (!idleRefresh)
+        return;
+
+    idleRefresh = false;
+
+    // commands issued before the rank went idle come first
+    flushCmdList();
+
+    // As at the start of a refresh, issue the REF and close the energy
+    // window, so the energy is split the same way
+    auto replayRef = [this](Tick ref_at) {
+        power.powerlib.doCommand(MemCommand::REF, 0,
+                                 divCeil(ref_at, dram.tCK) -
+                                 dram.timeStampOffset);
+        updateWindowEnergy(ref_at);
+
+        DPRINTF(DRAMPower, "%llu,REF,0,%d\n",
+                divCeil(ref_at, dram.tCK) - dram.timeStampOffset, rank);
+    };
+
+    // Replay the refreshes that completed while idle. With nothing
+    // queued, each one finds the rank idle with all banks precharged,
+    // goes straight to refresh, and is back to idle after tRFC, with
+    // the next one due a tREFI later, compensated for the precharge
+    Tick ref_done_at = 0;
+    while (idleRefreshAt + dram.tRFC <= curTick()) {
+        stats.pwrStateTime[PWR_IDLE] += idleRefreshAt - pwrStateTick;
+        stats.pwrStateTime[PWR_REF] += dram.tRFC;
+        ref_done_at = idleRefreshAt + dram.tRFC;
+        pwrStateTick = ref_done_at;
+
+        replayRef(idleRefreshAt);
+
+        refreshDueAt = idleRefreshAt + dram.tREFI;
+        idleRefreshAt = refreshDueAt - dram.tRP;
+    }
+
+    if (idleRefreshAt < curTick()) {
+        // in the middle of a refresh, pick up where the refresh event
+        // loop would be, waiting for the refresh to complete
+        stats.pwrStateTime[PWR_IDLE] += idleRefreshAt - pwrStateTick;
+        pwrStateTrans = PWR_REF;
+        pwrState = PWR_REF;
+        pwrStateTick = idleRefreshAt;
+
+        ref_done_at = idleRefreshAt + dram.tRFC;
+        replayRef(idleRefreshAt);
+        refreshDueAt = idleRefreshAt + dram.tREFI;
+
+        // the refresh counts as outstanding until it completes
+        ++outstandingEvents;
+        refreshState = REF_RUN;
+        schedule(refreshEvent, ref_done_at);
+    } else {
+        schedule(refreshEvent, idleRefreshAt);
+    }
+
+    if (ref_done_at != 0) {
+        for (auto &b : banks) {
+            b.actAllowedAt = ref_done_at;
+        }
+    }
+
+    DPRINTF(DRAMState, "Rank %d resuming refresh events, next refresh "
+            "due at %llu\n", rank, refreshDueAt);
+}
+
 bool
 DRAMInterface::Rank::isQueueEmpty() const
 {
@@ -1666,8 +1581,18 @@ DRAMInterface::Rank::processPowerEvent()
                     " rank %d at %llu tick\n", rank, curTick());
         }
 
-        // completed refresh event, ensure next request is scheduled
-        if (!(dram.ctrl->requestEventScheduled(dram.pseudoChannel))) {
+        if (canSkipRefresh()) {
+            // nothing is queued in the controller, so there is no
+            // scheduler to restart, and the refreshes until the rank
+            // is used again are accounted for in bulk
+            idleRefreshAt = refreshEvent.when();
+            deschedule(refreshEvent);
+            idleRefresh = true;
+
+            DPRINTF(DRAMState, "Rank %d idle, skipping refresh events from "
+                    "%llu\n", rank, idleRefreshAt);
+        } else if (!(dram.ctrl->requestEventScheduled(dram.pseudoChannel))) {
+            // completed refresh event, ensure next request is scheduled
             DPRINTF(DRAM, "Scheduling next request after refreshing"
                            " rank %d\n", rank);
             dram.ctrl->restartScheduler(curTick(), dram.pseudoChannel);
@@ -1769,11 +1694,17 @@ DRAMInterface::Rank::updatePowerStats()
     // flush cmdList to DRAMPower
     flushCmdList();
 
+    updateWindowEnergy(curTick());
+}
+
+void
+DRAMInterface::Rank::updateWindowEnergy(Tick when)
+{
     // Call the function that calculates window energy at intermediate update
     // events like at refresh, stats dump as well as at simulation exit.
     // Window starts at the last time the calcWindowEnergy function was called
-    // and is upto current time.
-    power.powerlib.calcWindowEnergy(divCeil(curTick(), dram.tCK) -
+    // and is upto the given time.
+    power.powerlib.calcWindowEnergy(divCeil(when, dram.tCK) -
                                     dram.timeStampOffset);
 
     // Get the energy from DRAMPower
@@ -1801,7 +1732,7 @@ DRAMInterface::Rank::updatePowerStats()
     // power (mW) = ----------- * ----------
     //              time (tick)   tick_frequency
     stats.averagePower = (stats.totalEnergy.value() /
-                    (curTick() - dram.lastStatsResetTick)) *
+                    (when - dram.lastStatsResetTick)) *
                     (sim_clock::Frequency / 1000000000.0);
 }
 
@@ -1810,6 +1741,9 @@ DRAMInterface::Rank::computeStats()
 {
     DPRINTF(DRAM,"Computing stats due to a dump callback\n");
 
+    // bring the refreshes skipped while idle into account
+    resumeRefresh();
+
     // Update the stats
     updatePowerStats();
 
@@ -2014,6 +1948,9 @@ DRAMInterface::RankStats::regStats()
 void
 DRAMInterface::RankStats::resetStats()
 {
+    // refreshes skipped while idle belong to the stats being reset
+    rank.resumeRefresh();
+
     statistics::Group::resetStats();
 
     rank.resetStats();
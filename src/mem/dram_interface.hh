@@ -256,11 +256,26 @@ class DRAMInterface : public MemInterface
          */
         Tick refreshDueAt;
 
+        /**
+         * Is the refresh event loop stopped because the rank is idle,
+         * and if so, when does the next refresh it skips start
+         */
+        bool idleRefresh;
+        Tick idleRefreshAt;
+
         /**
          * Function to update Power Stats
          */
         void updatePowerStats();
 
+        /**
+         * Accumulate the energy of the DRAMPower window ending at a given
+         * tick, which is now unless refreshes are being replayed.
+         *
+         * @param when End of the window
+         */
+        void updateWindowEnergy(Tick when);
+
         /**
          * Schedule a power state transition in the future, and
          * potentially override an already scheduled transition.
@@ -365,6 +380,23 @@ class DRAMInterface : public MemInterface
          */
         void suspend();
 
+        /**
+         * Check if the rank, having just completed a refresh, and its
+         * controller are idle. If so the refresh event loop can be
+         * stopped and the refreshes until the rank is used again are
+         * accounted for in bulk.
+         *
+         * @return true if the refresh events can be skipped
+         */
+        bool canSkipRefresh() const;
+
+        /**
+         * Account for the refreshes skipped by an idle rank up to now,
+         * and restart the refresh event loop in the state it would
+         * have been in had it never stopped.
+         */
+        void resumeRefresh();
+
         /**
          * Check if there is no refresh and no preparation of refresh ongoing
          * i.e. the refresh state machine is in idle
@@ -533,6 +565,9 @@ class DRAMInterface : public MemInterface
     /** Enable or disable DRAM powerdown states. */
     bool enableDRAMPowerdown;
 
+    /** Skip the refresh events of idle ranks */
+    const bool bulkIdleRefresh;
+
     /** The time when stats were last reset used to calculate average power */
     Tick lastStatsResetTick;
 
@@ -625,19 +660,6 @@ class DRAMInterface : public MemInterface
      */
     Tick writeToReadDelay() const override { return tBURST + tWTR + tWL; }
 
-    /**
-     * Find which are the earliest banks ready to issue an activate
-     * for the enqueued requests. Assumes maximum of 32 banks per rank
-     * Also checks if the bank is already prepped.
-     *
-     * @param queue Queued requests to consider
-     * @param min_col_at time of seamless burst command
-     * @return One-hot encoded mask of bank indices
-     * @return boolean indicating burst can issue seamlessly, with no gaps
-     */
-    std::pair<std::vector<uint32_t>, bool>
-    minBankPrep(const MemPacketQueue& queue, Tick min_col_at) const;
-
     /*
      * @return time to send a burst of data without gaps
      */
@@ -746,6 +768,12 @@ class DRAMInterface : public MemInterface
         return ranks[pkt->rank]->inRefIdleState();
     }
 
+    bool
+    rowOpen(MemPacket* pkt) const override
+    {
+        return ranks[pkt->rank]->banks[pkt->bank].openRow == pkt->row;
+    }
+
     /**
      * This function checks if ranks are actively refreshing and
      * therefore busy. The function also checks if ranks are in
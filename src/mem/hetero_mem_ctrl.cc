@@ -40,15 +40,24 @@
 
 #include "mem/hetero_mem_ctrl.hh"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/DRAM.hh"
 #include "debug/Drain.hh"
 #include "debug/MemCtrl.hh"
+#include "debug/MemTiering.hh"
 #include "debug/NVM.hh"
 #include "debug/QOS.hh"
 #include "mem/dram_interface.hh"
 #include "mem/mem_interface.hh"
 #include "mem/nvm_interface.hh"
+#include "sim/serialize.hh"
 #include "sim/system.hh"
 
 namespace gem5
@@ -57,9 +66,30 @@ namespace gem5
 namespace memory
 {
 
+namespace
+{
+
+// Number of DRAM frames the clock hand inspects when looking for a page
+// to demote, bounding the work done per promotion
+const uint64_t victimScanLimit = 64;
+
+} // anonymous namespace
+
 HeteroMemCtrl::HeteroMemCtrl(const HeteroMemCtrlParams &p) :
     MemCtrl(p),
-    nvm(p.nvm)
+    nvm(p.nvm),
+    tieringPolicy(p.tiering_policy),
+    hotnessTracking(p.hotness_tracking),
+    tierPageSize(p.tier_page_size),
+    hotnessSampleInterval(p.hotness_sample_interval),
+    tieringEpoch(p.tiering_epoch),
+    migrationThreshold(p.migration_threshold),
+    maxMigrationsPerEpoch(p.max_migrations_per_epoch),
+    migrationBandwidth(p.migration_bandwidth),
+    dramBase(0), nvmBase(0), numDramFrames(0),
+    curEpoch(0), sampleCount(0), victimHand(0),
+    tieringEvent([this]{ processTieringEvent(); }, name()),
+    tieringStats(*this)
 {
     DPRINTF(MemCtrl, "Setting up controller\n");
     readQueue.resize(p.qos_priorities);
@@ -85,6 +115,61 @@ HeteroMemCtrl::HeteroMemCtrl(const HeteroMemCtrlParams &p) :
         fatal("Write buffer low threshold %d must be smaller than the "
               "high threshold %d\n", p.write_low_thresh_perc,
               p.write_high_thresh_perc);
+
+    if (tieringEnabled()) {
+        const AddrRange dram_range = dram->getAddrRange();
+        const AddrRange nvm_range = nvm->getAddrRange();
+
+        fatal_if(dram_range.interleaved() || nvm_range.interleaved(),
+                 "%s: page tiering does not support interleaved "
+                 "interfaces\n", name());
+        // A request never crosses a cache line, so a page of at
+        // least a line and a burst keeps every request and every
+        // burst within a single page
+        fatal_if(!isPowerOf2(tierPageSize) ||
+                 tierPageSize < system()->cacheLineSize() ||
+                 tierPageSize < dram->bytesPerBurst() ||
+                 tierPageSize < nvm->bytesPerBurst(),
+                 "%s: tier page size must be a power of two and at least "
+                 "one cache line and one burst\n", name());
+        fatal_if(dram_range.start() % tierPageSize ||
+                 dram_range.size() % tierPageSize ||
+                 nvm_range.start() % tierPageSize ||
+                 nvm_range.size() % tierPageSize,
+                 "%s: interface ranges must be aligned to the tier page "
+                 "size\n", name());
+        fatal_if(hotnessSampleInterval == 0,
+                 "%s: hotness sample interval must be non-zero\n", name());
+
+        dramBase = dram_range.start();
+        nvmBase = nvm_range.start();
+        numDramFrames = dram_range.size() / tierPageSize;
+        const uint64_t num_pages =
+            numDramFrames + nvm_range.size() / tierPageSize;
+        fatal_if(numDramFrames == 0, "%s: tiering needs DRAM capacity\n",
+                 name());
+        fatal_if(num_pages > std::numeric_limits<uint32_t>::max(),
+                 "%s: too many tier pages, increase tier_page_size\n",
+                 name());
+
+        // start out with every page in its home frame
+        pageToFrame.resize(num_pages);
+        std::iota(pageToFrame.begin(), pageToFrame.end(), 0);
+        frameToPage = pageToFrame;
+
+        pageHotness.assign(num_pages, 0);
+        pageEpoch.assign(num_pages, 0);
+        isCandidate.assign(num_pages, false);
+    }
+}
+
+void
+HeteroMemCtrl::startup()
+{
+    MemCtrl::startup();
+
+    if (isTimingMode && tieringEnabled() && !tieringEvent.scheduled())
+        schedule(tieringEvent, curTick() + tieringEpoch);
 }
 
 Tick
@@ -133,6 +218,15 @@ HeteroMemCtrl::recvTimingReq(PacketPtr pkt)
               pkt->print());
     }
 
+    // A migrated page is timed by the media currently holding it
+    if (tieringEnabled()) {
+        const uint32_t page = pageOf(pkt->getAddr());
+        panic_if(page != pageOf(pkt->getAddr() + pkt->getSize() - 1),
+                 "Packet %s crosses a tier page, requests must not cross "
+                 "a cache line\n", pkt->print());
+        is_dram = pageToFrame[page] < numDramFrames;
+    }
+
     // Find out how many memory packets a pkt translates to
     // If the burst size is equal or larger than the pkt size, then a pkt
     // translates to only one memory packet. Otherwise, a pkt translates to
@@ -165,6 +259,7 @@ HeteroMemCtrl::recvTimingReq(PacketPtr pkt)
             }
             stats.writeReqs++;
             stats.bytesWrittenSys += size;
+            recordAccess(pkt->getAddr(), is_dram);
         }
     } else {
         assert(pkt->isRead());
@@ -186,6 +281,7 @@ HeteroMemCtrl::recvTimingReq(PacketPtr pkt)
             }
             stats.readReqs++;
             stats.bytesReadSys += size;
+            recordAccess(pkt->getAddr(), is_dram);
         }
     }
 
@@ -194,7 +290,7 @@ HeteroMemCtrl::recvTimingReq(PacketPtr pkt)
 
 void
 HeteroMemCtrl::processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req)
 {
@@ -401,6 +497,218 @@ HeteroMemCtrl::recvFunctional(PacketPtr pkt)
     }
 }
 
+void
+HeteroMemCtrl::accessAndRespond(PacketPtr pkt, Tick static_latency,
+                                MemInterface* mem_intr)
+{
+    MemInterface* home = dram->getAddrRange().contains(pkt->getAddr()) ?
+        static_cast<MemInterface*>(dram) : nvm;
+    MemCtrl::accessAndRespond(pkt, static_latency, home);
+}
+
+uint32_t
+HeteroMemCtrl::pageOf(Addr addr) const
+{
+    if (addr >= dramBase && addr - dramBase < numDramFrames * tierPageSize)
+        return (addr - dramBase) / tierPageSize;
+    return numDramFrames + (addr - nvmBase) / tierPageSize;
+}
+
+Addr
+HeteroMemCtrl::frameAddr(uint32_t frame) const
+{
+    if (frame < numDramFrames)
+        return dramBase + Addr(frame) * tierPageSize;
+    return nvmBase + Addr(frame - numDramFrames) * tierPageSize;
+}
+
+Addr
+HeteroMemCtrl::mediaAddr(Addr addr) const
+{
+    if (!tieringEnabled())
+        return addr;
+    return frameAddr(pageToFrame[pageOf(addr)]) +
+        (addr & (tierPageSize - 1));
+}
+
+unsigned
+HeteroMemCtrl::decayedHotness(uint32_t page)
+{
+    uint16_t &hotness = pageHotness[page];
+    const uint32_t age = curEpoch - pageEpoch[page];
+    if (age) {
+        // counters halve every epoch, access bits shift one epoch along
+        hotness = age < 16 ? hotness >> age : 0;
+        pageEpoch[page] = curEpoch;
+    }
+    return hotnessTracking == enums::counters ? hotness : popCount(hotness);
+}
+
+void
+HeteroMemCtrl::recordAccess(Addr addr, bool is_dram)
+{
+    if (is_dram)
+        tieringStats.fastTierReqs++;
+    else
+        tieringStats.slowTierReqs++;
+
+    if (!tieringEnabled() || ++sampleCount < hotnessSampleInterval)
+        return;
+    sampleCount = 0;
+
+    const uint32_t page = pageOf(addr);
+    decayedHotness(page);
+    uint16_t &hotness = pageHotness[page];
+    unsigned level;
+    if (hotnessTracking == enums::counters) {
+        if (hotness < std::numeric_limits<uint16_t>::max())
+            ++hotness;
+        level = hotness;
+    } else {
+        // the top bit stands for the current epoch
+        hotness |= 1 << 15;
+        level = popCount(hotness);
+    }
+
+    if (!is_dram && !isCandidate[page] && level >= migrationThreshold) {
+        isCandidate[page] = true;
+        candidates.push_back(page);
+    }
+}
+
+uint64_t
+HeteroMemCtrl::findVictim(unsigned hotness)
+{
+    const uint64_t scan = std::min(numDramFrames, victimScanLimit);
+    for (uint64_t i = 0; i < scan; ++i) {
+        const uint64_t frame = victimHand;
+        victimHand = (victimHand + 1) % numDramFrames;
+        if (decayedHotness(frameToPage[frame]) < hotness)
+            return frame;
+    }
+    return numDramFrames;
+}
+
+void
+HeteroMemCtrl::migrate(uint32_t hot_page, uint32_t cold_page)
+{
+    const uint32_t fast_frame = pageToFrame[cold_page];
+    const uint32_t slow_frame = pageToFrame[hot_page];
+    assert(fast_frame < numDramFrames && slow_frame >= numDramFrames);
+
+    DPRINTF(MemTiering, "Promoting page %d to frame %d, demoting page %d "
+            "to frame %d\n", hot_page, fast_frame, cold_page, slow_frame);
+
+    pageToFrame[hot_page] = fast_frame;
+    pageToFrame[cold_page] = slow_frame;
+    frameToPage[fast_frame] = hot_page;
+    frameToPage[slow_frame] = cold_page;
+
+    // Both pages cross the shared bus, which is unavailable to regular
+    // bursts until the copy is done. The mapping changes right away;
+    // bursts already queued keep the media address they were decoded
+    // with, which only affects their timing.
+    const Addr bytes = 2 * tierPageSize;
+    const Tick copy_time = bytes * migrationBandwidth;
+    const Tick busy_until = std::max(curTick(), dram->nextBurstAt) +
+        copy_time;
+    dram->nextBurstAt = nvm->nextBurstAt = busy_until;
+    dram->nextReqTime = nvm->nextReqTime = busy_until -
+        dram->commandOffset();
+
+    tieringStats.promotions++;
+    tieringStats.demotions++;
+    tieringStats.migrationBytes += bytes;
+    tieringStats.migrationTicks += copy_time;
+}
+
+void
+HeteroMemCtrl::processTieringEvent()
+{
+    // Rank the candidates before the epoch advances and ages them
+    std::vector<std::pair<unsigned, uint32_t>> ranked;
+    ranked.reserve(candidates.size());
+    for (auto page : candidates) {
+        isCandidate[page] = false;
+        // skip pages that were promoted in the meantime
+        if (pageToFrame[page] >= numDramFrames)
+            ranked.emplace_back(decayedHotness(page), page);
+    }
+    candidates.clear();
+    std::sort(ranked.begin(), ranked.end(), std::greater<>());
+
+    unsigned migrations = 0;
+    for (const auto &[hotness, page] : ranked) {
+        if (migrations == maxMigrationsPerEpoch)
+            break;
+        const uint64_t frame = findVictim(hotness);
+        if (frame == numDramFrames) {
+            // the remaining candidates are colder still
+            tieringStats.noVictim++;
+            break;
+        }
+        migrate(page, frameToPage[frame]);
+        ++migrations;
+    }
+
+    ++curEpoch;
+
+    // stop while in atomic mode; startup() restarts the epochs when
+    // switching back to timing
+    if (isTimingMode)
+        schedule(tieringEvent, curTick() + tieringEpoch);
+}
+
+void
+HeteroMemCtrl::serialize(CheckpointOut &cp) const
+{
+    MemCtrl::serialize(cp);
+
+    if (tieringEnabled())
+        SERIALIZE_CONTAINER(pageToFrame);
+}
+
+void
+HeteroMemCtrl::unserialize(CheckpointIn &cp)
+{
+    MemCtrl::unserialize(cp);
+
+    if (tieringEnabled()) {
+        const size_t num_pages = pageToFrame.size();
+        UNSERIALIZE_CONTAINER(pageToFrame);
+        fatal_if(pageToFrame.size() != num_pages,
+                 "%s: checkpoint has %d tier pages, expected %d\n",
+                 name(), pageToFrame.size(), num_pages);
+        for (uint32_t page = 0; page < num_pages; ++page)
+            frameToPage[pageToFrame[page]] = page;
+    }
+}
+
+HeteroMemCtrl::TieringStats::TieringStats(HeteroMemCtrl &ctrl)
+    : statistics::Group(&ctrl, "tiering"),
+
+    ADD_STAT(fastTierReqs, statistics::units::Count::get(),
+             "Number of requests timed by the DRAM tier"),
+    ADD_STAT(slowTierReqs, statistics::units::Count::get(),
+             "Number of requests timed by the NVM tier"),
+    ADD_STAT(fastTierHitRate, statistics::units::Ratio::get(),
+             "Fraction of requests serviced by the DRAM tier",
+             fastTierReqs / (fastTierReqs + slowTierReqs)),
+
+    ADD_STAT(promotions, statistics::units::Count::get(),
+             "Number of pages migrated from NVM to DRAM"),
+    ADD_STAT(demotions, statistics::units::Count::get(),
+             "Number of pages migrated from DRAM to NVM"),
+    ADD_STAT(noVictim, statistics::units::Count::get(),
+             "Number of epochs that ran out of colder DRAM pages"),
+    ADD_STAT(migrationBytes, statistics::units::Byte::get(),
+             "Number of bytes moved by page migration"),
+    ADD_STAT(migrationTicks, statistics::units::Tick::get(),
+             "Bus time spent on page migration")
+{
+    fastTierHitRate.precision(4);
+}
+
 bool
 HeteroMemCtrl::allIntfDrained() const
 {
@@ -46,6 +46,11 @@
 #ifndef __HETERO_MEM_CTRL_HH__
 #define __HETERO_MEM_CTRL_HH__
 
+#include <vector>
+
+#include "base/statistics.hh"
+#include "enums/HotnessTracking.hh"
+#include "enums/TieringPolicy.hh"
 #include "mem/mem_ctrl.hh"
 #include "params/HeteroMemCtrl.hh"
 
@@ -94,7 +99,7 @@ class HeteroMemCtrl : public MemCtrl
     pktSizeCheck(MemPacket* mem_pkt, MemInterface* mem_intr) const override;
 
     virtual void processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req) override;
 
@@ -121,6 +126,103 @@ class HeteroMemCtrl : public MemCtrl
      */
     virtual bool nvmWriteBlock(MemInterface* mem_intr) override;
 
+    /**
+     * Respond using the interface that owns the system address of the
+     * packet, which differs from the one that timed the access once
+     * the page has been migrated.
+     */
+    void accessAndRespond(PacketPtr pkt, Tick static_latency,
+                          MemInterface* mem_intr) override;
+
+    Addr mediaAddr(Addr addr) const override;
+
+    /**
+     * Page-granularity tiering engine. Pages and frames are numbered
+     * across both interfaces, DRAM first, and the remapping table is a
+     * permutation of them; a migration swaps the frames of a hot NVM
+     * page and a colder DRAM page. Hotness decays lazily: every page
+     * remembers the epoch it was last updated in and is aged by the
+     * number of epochs since, so the engine never walks all pages.
+     */
+    const enums::TieringPolicy tieringPolicy;
+    const enums::HotnessTracking hotnessTracking;
+    const Addr tierPageSize;
+    const unsigned hotnessSampleInterval;
+    const Tick tieringEpoch;
+    const unsigned migrationThreshold;
+    const unsigned maxMigrationsPerEpoch;
+
+    /** Ticks per byte of migration traffic on the shared bus. */
+    const double migrationBandwidth;
+
+    Addr dramBase;
+    Addr nvmBase;
+    uint64_t numDramFrames;
+    std::vector<uint32_t> pageToFrame;
+    std::vector<uint32_t> frameToPage;
+
+    std::vector<uint16_t> pageHotness;
+    std::vector<uint32_t> pageEpoch;
+    std::vector<bool> isCandidate;
+
+    /** NVM resident pages that reached the threshold this epoch. */
+    std::vector<uint32_t> candidates;
+
+    uint32_t curEpoch;
+    unsigned sampleCount;
+
+    /** Clock hand over the DRAM frames used to pick demotion victims. */
+    uint64_t victimHand;
+
+    EventFunctionWrapper tieringEvent;
+
+    bool tieringEnabled() const
+    { return tieringPolicy != enums::fixed; }
+
+    uint32_t pageOf(Addr addr) const;
+    Addr frameAddr(uint32_t frame) const;
+
+    /** Age the hotness of a page to the current epoch and return it. */
+    unsigned decayedHotness(uint32_t page);
+
+    /**
+     * Account an accepted timing request to its tier and, if it is
+     * sampled, update the hotness of its page.
+     */
+    void recordAccess(Addr addr, bool is_dram);
+    void processTieringEvent();
+
+    /**
+     * Find a DRAM frame whose page is colder than the given hotness,
+     * scanning a bounded number of frames from the clock hand.
+     *
+     * @return the frame, or numDramFrames if none was found
+     */
+    uint64_t findVictim(unsigned hotness);
+
+    /**
+     * Swap the frames of two pages and charge the copy to the bus
+     * shared by both interfaces.
+     */
+    void migrate(uint32_t hot_page, uint32_t cold_page);
+
+    struct TieringStats : public statistics::Group
+    {
+        TieringStats(HeteroMemCtrl &ctrl);
+
+        statistics::Scalar fastTierReqs;
+        statistics::Scalar slowTierReqs;
+        statistics::Formula fastTierHitRate;
+
+        statistics::Scalar promotions;
+        statistics::Scalar demotions;
+        statistics::Scalar noVictim;
+        statistics::Scalar migrationBytes;
+        statistics::Scalar migrationTicks;
+    };
+
+    TieringStats tieringStats;
+
   public:
 
     HeteroMemCtrl(const HeteroMemCtrlParams &p);
@@ -128,6 +230,10 @@ class HeteroMemCtrl : public MemCtrl
     bool allIntfDrained() const override;
     DrainState drain() override;
     void drainResume() override;
+    void startup() override;
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
 
   protected:
 
@@ -40,6 +40,8 @@
 
 #include "mem/mem_ctrl.hh"
 
+#include <algorithm>
+
 #include "base/trace.hh"
 #include "debug/DRAM.hh"
 #include "debug/Drain.hh"
@@ -57,6 +59,51 @@ namespace gem5
 namespace memory
 {
 
+void
+MemPacketQueue::push_back(MemPacket* pkt)
+{
+    auto part = std::find_if(partitions.begin(), partitions.end(),
+        [pkt](const Partition& p) {
+            return p.dram == pkt->isDram() &&
+                   p.pseudoChannel == pkt->pseudoChannel;
+        });
+    if (part == partitions.end()) {
+        partitions.push_back({pkt->isDram(), pkt->pseudoChannel, {}});
+        part = partitions.end() - 1;
+    }
+    if (pkt->bankId >= part->banks.size())
+        part->banks.resize(pkt->bankId + 1);
+
+    PacketList& bank = part->banks[pkt->bankId];
+    pkt->queueSeq = nextSeq++;
+    pkt->queuePos = packets.insert(packets.end(), pkt);
+    pkt->bankPos = bank.insert(bank.end(), pkt);
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::erase(iterator pos)
+{
+    MemPacket* pkt = *pos;
+    for (auto& part : partitions) {
+        if (part.dram == pkt->isDram() &&
+            part.pseudoChannel == pkt->pseudoChannel) {
+            part.banks[pkt->bankId].erase(pkt->bankPos);
+            break;
+        }
+    }
+    return packets.erase(pos);
+}
+
+const std::vector<MemPacketQueue::PacketList>*
+MemPacketQueue::bankQueues(bool is_dram, uint8_t pseudo_channel) const
+{
+    for (const auto& part : partitions) {
+        if (part.dram == is_dram && part.pseudoChannel == pseudo_channel)
+            return &part.banks;
+    }
+    return nullptr;
+}
+
 MemCtrl::MemCtrl(const MemCtrlParams &p) :
     qos::MemCtrl(p),
     port(name() + ".port", *this), isTimingMode(false),
@@ -78,6 +125,10 @@ MemCtrl::MemCtrl(const MemCtrlParams &p) :
     backendLatency(p.static_backend_latency),
     commandWindow(p.command_window),
     prevArrival(0),
+    prefetchPolicy(p.mem_prefetch_policy),
+    prefetchBufferSize(p.prefetch_buffer_size),
+    prefetchRequestorId(Request::invldRequestorId),
+    nextPrefetchBank(0),
     stats(*this)
 {
     DPRINTF(MemCtrl, "Setting up controller\n");
@@ -87,6 +138,17 @@ MemCtrl::MemCtrl(const MemCtrlParams &p) :
 
     dram->setCtrl(this, commandWindow);
 
+    if (prefetchPolicy != MemPrefetchPolicy::none) {
+        fatal_if(!dynamic_cast<DRAMInterface*>(dram),
+                 "MemCtrl %s: memory-side prefetching needs a DRAM "
+                 "interface\n", name());
+        fatal_if(prefetchBufferSize == 0,
+                 "MemCtrl %s: prefetch buffer must hold at least one "
+                 "burst\n", name());
+        prefetchRequestorId = system()->getRequestorId(this, "prefetcher");
+        bankStreams.resize(dram->numBanks());
+    }
+
     // perform a basic check of the write thresholds
     if (p.write_low_thresh_perc >= p.write_high_thresh_perc)
         fatal("Write buffer low threshold %d must be smaller than the "
@@ -199,11 +261,17 @@ MemCtrl::addToReadQueue(PacketPtr pkt,
     // address of first packet is kept unaliged. Subsequent packets
     // are aligned to burst size boundaries. This is to ensure we accurately
     // check read packets against packets in write queue.
-    const Addr base_addr = pkt->getAddr();
+    const Addr base_addr = mediaAddr(pkt->getAddr());
     Addr addr = base_addr;
-    unsigned pktsServicedByWrQ = 0;
+    unsigned pktsServicedByCtrl = 0;
     BurstHelper* burst_helper = NULL;
 
+    // the prefetcher only tracks the DRAM interface of the controller
+    const bool prefetch = prefetchPolicy != MemPrefetchPolicy::none &&
+        mem_intr == dram;
+    // when the last prefetched burst used by this packet has its data
+    Tick pf_ready_at = 0;
+
     uint32_t burst_size = mem_intr->bytesPerBurst();
 
     for (int cnt = 0; cnt < pkt_count; ++cnt) {
@@ -229,7 +297,7 @@ MemCtrl::addToReadQueue(PacketPtr pkt,
 
                         foundInWrQ = true;
                         stats.servicedByWrQ++;
-                        pktsServicedByWrQ++;
+                        pktsServicedByCtrl++;
                         DPRINTF(MemCtrl,
                                 "Read to addr %#x with size %d serviced by "
                                 "write queue\n",
@@ -241,9 +309,30 @@ MemCtrl::addToReadQueue(PacketPtr pkt,
             }
         }
 
+        // Next check if the prefetcher already brought the burst into
+        // the controller, a hit consumes the buffered copy
+        bool foundInPfBuf = false;
+        if (!foundInWrQ && prefetch) {
+            auto pf = std::find_if(prefetchBuffer.begin(),
+                                   prefetchBuffer.end(),
+                                   [burst_addr](const PrefetchEntry& e)
+                                   { return e.addr == burst_addr; });
+            if (pf != prefetchBuffer.end()) {
+                foundInPfBuf = true;
+                stats.servicedByPfBuf++;
+                pktsServicedByCtrl++;
+                DPRINTF(MemCtrl,
+                        "Read to addr %#x with size %d serviced by "
+                        "prefetch buffer\n", addr, size);
+                pf_ready_at = std::max(pf_ready_at, pf->readyTime);
+                trainPrefetcher(burst_addr, pf->bankId, mem_intr);
+                prefetchBuffer.erase(pf);
+            }
+        }
+
         // If not found in the write q, make a memory packet and
         // push it onto the read queue
-        if (!foundInWrQ) {
+        if (!foundInWrQ && !foundInPfBuf) {
 
             // Make the burst helper for split packets
             if (pkt_count > 1 && burst_helper == NULL) {
@@ -256,6 +345,9 @@ MemCtrl::addToReadQueue(PacketPtr pkt,
             mem_pkt = mem_intr->decodePacket(pkt, addr, size, true,
                                                     mem_intr->pseudoChannel);
 
+            if (prefetch)
+                trainPrefetcher(burst_addr, mem_pkt->bankId, mem_intr);
+
             // Increment read entries of the rank (dram)
             // Increment count to trigger issue of non-deterministic read (nvm)
             mem_intr->setupRank(mem_pkt->rank, true);
@@ -282,15 +374,21 @@ MemCtrl::addToReadQueue(PacketPtr pkt,
         addr = (addr | (burst_size - 1)) + 1;
     }
 
-    // If all packets are serviced by write queue, we send the repsonse back
-    if (pktsServicedByWrQ == pkt_count) {
-        accessAndRespond(pkt, frontendLatency, mem_intr);
+    // If all packets are serviced by the write queue or the prefetch
+    // buffer, we send the repsonse back, waiting for any prefetch that
+    // is still in flight
+    if (pktsServicedByCtrl == pkt_count) {
+        Tick pf_delay = pf_ready_at > curTick() ? pf_ready_at - curTick() : 0;
+        accessAndRespond(pkt, frontendLatency + pf_delay, mem_intr);
         return true;
     }
 
-    // Update how many split packets are serviced by write queue
-    if (burst_helper != NULL)
-        burst_helper->burstsServiced = pktsServicedByWrQ;
+    // Update how many split packets are serviced by the controller,
+    // and when the prefetched ones among them are ready
+    if (burst_helper != NULL) {
+        burst_helper->burstsServiced = pktsServicedByCtrl;
+        burst_helper->pfReadyAt = pf_ready_at;
+    }
 
     // not all/any packets serviced by the write queue
     return false;
@@ -306,7 +404,7 @@ MemCtrl::addToWriteQueue(PacketPtr pkt, unsigned int pkt_count,
 
     // if the request size is larger than burst size, the pkt is split into
     // multiple packets
-    const Addr base_addr = pkt->getAddr();
+    const Addr base_addr = mediaAddr(pkt->getAddr());
     Addr addr = base_addr;
     uint32_t burst_size = mem_intr->bytesPerBurst();
 
@@ -322,6 +420,10 @@ MemCtrl::addToWriteQueue(PacketPtr pkt, unsigned int pkt_count,
         bool merged = isInWriteQueue.find(burstAlign(addr, mem_intr)) !=
             isInWriteQueue.end();
 
+        // a prefetched copy of the burst is stale from here on
+        if (prefetchPolicy != MemPrefetchPolicy::none && mem_intr == dram)
+            dropPrefetch(burstAlign(addr, mem_intr), true);
+
         // if the item was not merged we need to create a new write
         // and enqueue it
         if (!merged) {
@@ -480,7 +582,7 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
 
 void
 MemCtrl::processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req)
 {
@@ -494,16 +596,26 @@ MemCtrl::processRespondEvent(MemInterface* mem_intr,
     // DRAM only
     mem_intr->respondEvent(mem_pkt->rank);
 
-    if (mem_pkt->burstHelper) {
+    if (prefetchPolicy != MemPrefetchPolicy::none &&
+        mem_pkt->requestorId() == prefetchRequestorId) {
+        // a prefetch only fills the buffer, there is no one to respond
+        // to and the packet was created by the controller itself
+        delete mem_pkt->pkt;
+    } else if (mem_pkt->burstHelper) {
         // it is a split packet
         mem_pkt->burstHelper->burstsServiced++;
         if (mem_pkt->burstHelper->burstsServiced ==
             mem_pkt->burstHelper->burstCount) {
             // we have now serviced all children packets of a system packet
-            // so we can now respond to the requestor
+            // so we can now respond to the requestor, unless a burst
+            // served by the prefetch buffer is still in flight
             // @todo we probably want to have a different front end and back
             // end latency for split packets
-            accessAndRespond(mem_pkt->pkt, frontendLatency + backendLatency,
+            Tick pf_ready_at = mem_pkt->burstHelper->pfReadyAt;
+            Tick pf_delay = pf_ready_at > curTick() ?
+                pf_ready_at - curTick() : 0;
+            accessAndRespond(mem_pkt->pkt,
+                             frontendLatency + backendLatency + pf_delay,
                              mem_intr);
             delete mem_pkt->burstHelper;
             mem_pkt->burstHelper = NULL;
@@ -825,6 +937,124 @@ MemCtrl::doBurstAccess(MemPacket* mem_pkt, MemInterface* mem_intr)
     return cmd_at;
 }
 
+void
+MemCtrl::trainPrefetcher(Addr burst_addr, uint16_t bank_id,
+                         MemInterface* mem_intr)
+{
+    BankStream& stream = bankStreams[bank_id];
+
+    if (prefetchPolicy == MemPrefetchPolicy::next_line) {
+        stream.candidate = burst_addr + mem_intr->bytesPerBurst();
+    } else {
+        // only follow an ascending stride once it is seen twice in a
+        // row, whether the candidate is in the open row is decided
+        // when it is issued
+        Addr stride = stream.lastAddr != MaxAddr &&
+            burst_addr > stream.lastAddr ? burst_addr - stream.lastAddr : 0;
+        stream.candidate = stride != 0 && stride == stream.stride ?
+            burst_addr + stride : MaxAddr;
+        stream.stride = stride;
+    }
+    stream.lastAddr = burst_addr;
+}
+
+bool
+MemCtrl::issuePrefetch(MemInterface* mem_intr,
+                       std::deque<MemPacket*>& resp_queue,
+                       EventFunctionWrapper& resp_event)
+{
+    const uint32_t burst_size = mem_intr->bytesPerBurst();
+    const uint16_t num_banks = bankStreams.size();
+
+    // go round the banks so that a single stream does not get all the
+    // idle slots
+    for (uint16_t i = 0; i < num_banks; ++i) {
+        uint16_t bank_id = (nextPrefetchBank + i) % num_banks;
+        Addr addr = bankStreams[bank_id].candidate;
+        if (addr == MaxAddr)
+            continue;
+
+        // each candidate is only considered once
+        bankStreams[bank_id].candidate = MaxAddr;
+
+        // nothing to gain if the controller already holds the burst
+        if (!mem_intr->getAddrRange().contains(addr) ||
+            isInWriteQueue.find(addr) != isInWriteQueue.end() ||
+            std::any_of(prefetchBuffer.begin(), prefetchBuffer.end(),
+                        [addr](const PrefetchEntry& e)
+                        { return e.addr == addr; }))
+            continue;
+
+        auto req = std::make_shared<Request>(addr, burst_size, 0,
+                                             prefetchRequestorId);
+        PacketPtr pkt = new Packet(req, MemCmd::HardPFReq);
+        MemPacket* mem_pkt = mem_intr->decodePacket(pkt, addr, burst_size,
+                                                    true,
+                                                    mem_intr->pseudoChannel);
+
+        const bool row_hit = mem_intr->rowOpen(mem_pkt);
+        if (!mem_intr->burstReady(mem_pkt) ||
+            (prefetchPolicy == MemPrefetchPolicy::open_row && !row_hit)) {
+            delete mem_pkt;
+            delete pkt;
+            continue;
+        }
+
+        mem_intr->setupRank(mem_pkt->rank, true);
+        mem_pkt->readyTime = MaxTick;
+        stats.requestorReadAccesses[prefetchRequestorId]++;
+
+        doBurstAccess(mem_pkt, mem_intr);
+
+        DPRINTF(MemCtrl, "Prefetching %#x, ready at %lld.\n", addr,
+                mem_pkt->readyTime);
+
+        // the burst returns through the response queue like any other
+        // read to keep the rank state consistent
+        if (resp_queue.empty()) {
+            assert(!resp_event.scheduled());
+            schedule(resp_event, mem_pkt->readyTime);
+        } else {
+            assert(resp_queue.back()->readyTime <= mem_pkt->readyTime);
+            assert(resp_event.scheduled());
+        }
+        resp_queue.push_back(mem_pkt);
+
+        // replace the oldest burst when the buffer is full
+        if (prefetchBuffer.size() == prefetchBufferSize)
+            dropPrefetch(prefetchBuffer.front().addr);
+        prefetchBuffer.push_back({addr, mem_pkt->readyTime, mem_pkt->bankId,
+                                  !row_hit});
+
+        stats.pfIssued++;
+        stats.bytesReadPf += burst_size;
+        if (!row_hit)
+            stats.pfActivations++;
+
+        nextPrefetchBank = (bank_id + 1) % num_banks;
+        return true;
+    }
+
+    return false;
+}
+
+void
+MemCtrl::dropPrefetch(Addr burst_addr, bool invalidate)
+{
+    auto pf = std::find_if(prefetchBuffer.begin(), prefetchBuffer.end(),
+                           [burst_addr](const PrefetchEntry& e)
+                           { return e.addr == burst_addr; });
+    if (pf == prefetchBuffer.end())
+        return;
+
+    stats.pfUnused++;
+    if (invalidate)
+        stats.pfInvalidated++;
+    if (pf->activated)
+        stats.pfWastedActivations++;
+    prefetchBuffer.erase(pf);
+}
+
 bool
 MemCtrl::memBusy(MemInterface* mem_intr) {
 
@@ -870,7 +1100,7 @@ MemCtrl::nonDetermReads(MemInterface* mem_intr) {
 
 void
 MemCtrl::processNextReqEvent(MemInterface* mem_intr,
-                        MemPacketQueue& resp_queue,
+                        std::deque<MemPacket*>& resp_queue,
                         EventFunctionWrapper& resp_event,
                         EventFunctionWrapper& next_req_event,
                         bool& retry_wr_req) {
@@ -931,6 +1161,14 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
                 DPRINTF(MemCtrl,
                         "Switching to writes due to read queue empty\n");
                 switch_to_writes = true;
+            } else if (prefetchPolicy != MemPrefetchPolicy::none &&
+                       mem_intr == dram &&
+                       drainState() == DrainState::Running &&
+                       !readQueueFull(1) &&
+                       issuePrefetch(mem_intr, resp_queue, resp_event)) {
+                // the idle slot was used for a prefetch, look again
+                // once the bus is free
+                DPRINTF(MemCtrl, "Read queue empty, issued a prefetch\n");
             } else {
                 // check if we are drained
                 // not done draining until in PWR_IDLE state
@@ -1176,6 +1414,9 @@ MemCtrl::CtrlStats::CtrlStats(MemCtrl &_ctrl)
              "the write queue"),
     ADD_STAT(servicedByWrQ, statistics::units::Count::get(),
              "Number of controller read bursts serviced by the write queue"),
+    ADD_STAT(servicedByPfBuf, statistics::units::Count::get(),
+             "Number of controller read bursts serviced by the prefetch "
+             "buffer"),
     ADD_STAT(mergedWrBursts, statistics::units::Count::get(),
              "Number of controller write bursts merged with an existing one"),
 
@@ -1209,8 +1450,24 @@ MemCtrl::CtrlStats::CtrlStats(MemCtrl &_ctrl)
     ADD_STAT(wrPerTurnAround, statistics::units::Count::get(),
              "Writes before turning the bus around for reads"),
 
+    ADD_STAT(pfIssued, statistics::units::Count::get(),
+             "Number of bursts prefetched into the prefetch buffer"),
+    ADD_STAT(pfUnused, statistics::units::Count::get(),
+             "Number of prefetched bursts replaced or invalidated before "
+             "use"),
+    ADD_STAT(pfInvalidated, statistics::units::Count::get(),
+             "Number of prefetched bursts invalidated by a write"),
+    ADD_STAT(pfActivations, statistics::units::Count::get(),
+             "Number of row activations caused by prefetches"),
+    ADD_STAT(pfWastedActivations, statistics::units::Count::get(),
+             "Number of prefetch row activations for bursts never used"),
+    ADD_STAT(pfAccuracy, statistics::units::Ratio::get(),
+             "Fraction of prefetched bursts that serviced a read"),
+
     ADD_STAT(bytesReadWrQ, statistics::units::Byte::get(),
              "Total number of bytes read from write queue"),
+    ADD_STAT(bytesReadPf, statistics::units::Byte::get(),
+             "Total number of bytes prefetched from the media"),
     ADD_STAT(bytesReadSys, statistics::units::Byte::get(),
              "Total read bytes from the system interface side"),
     ADD_STAT(bytesWrittenSys, statistics::units::Byte::get(),
@@ -1222,6 +1479,8 @@ MemCtrl::CtrlStats::CtrlStats(MemCtrl &_ctrl)
     ADD_STAT(avgWrBWSys, statistics::units::Rate<
                 statistics::units::Byte, statistics::units::Second>::get(),
              "Average system write bandwidth in Byte/s"),
+    ADD_STAT(pfBWOverhead, statistics::units::Ratio::get(),
+             "Bytes prefetched from the media per byte read by the system"),
 
     ADD_STAT(totGap, statistics::units::Tick::get(),
              "Total gap between requests"),
@@ -1283,6 +1542,8 @@ MemCtrl::CtrlStats::regStats()
     avgRdBWSys.precision(8);
     avgWrBWSys.precision(8);
     avgGap.precision(2);
+    pfAccuracy.precision(4);
+    pfBWOverhead.precision(4);
 
     // per-requestor bytes read and written to memory
     requestorReadBytes
@@ -1346,6 +1607,9 @@ MemCtrl::CtrlStats::regStats()
 
     avgGap = totGap / (readReqs + writeReqs);
 
+    pfAccuracy = servicedByPfBuf / pfIssued;
+    pfBWOverhead = bytesReadPf / bytesReadSys;
+
     requestorReadRate = requestorReadBytes / simSeconds;
     requestorWriteRate = requestorWriteBytes / simSeconds;
     requestorReadAvgLat = requestorReadTotalLat / requestorReadAccesses;
@@ -47,6 +47,7 @@
 #define __MEM_CTRL_HH__
 
 #include <deque>
+#include <list>
 #include <string>
 #include <unordered_set>
 #include <utility>
@@ -54,6 +55,7 @@
 
 #include "base/callback.hh"
 #include "base/statistics.hh"
+#include "enums/MemPrefetchPolicy.hh"
 #include "enums/MemSched.hh"
 #include "mem/qos/mem_ctrl.hh"
 #include "mem/qport.hh"
@@ -86,8 +88,14 @@ class BurstHelper
     /** Number of bursts serviced so far for a system packet **/
     unsigned int burstsServiced;
 
+    /**
+     * Tick at which the bursts served from the prefetch buffer are
+     * ready, the response waits for both them and the DRAM bursts
+     */
+    Tick pfReadyAt;
+
     BurstHelper(unsigned int _burstCount)
-        : burstCount(_burstCount), burstsServiced(0)
+        : burstCount(_burstCount), burstsServiced(0), pfReadyAt(0)
     { }
 };
 
@@ -156,6 +164,15 @@ class MemPacket
      */
     uint8_t _qosValue;
 
+    /**
+     * Place of the packet in the MemPacketQueue holding it: its position
+     * in the queue and in the per bank index of the queue, and its
+     * sequence number in queue order. Maintained by MemPacketQueue.
+     */
+    std::list<MemPacket*>::iterator queuePos;
+    std::list<MemPacket*>::iterator bankPos;
+    uint64_t queueSeq;
+
     /**
      * Set the packet QoS value
      * (interface compatibility with Packet)
@@ -210,14 +227,67 @@ class MemPacket
           _requestorId(pkt->requestorId()),
           read(is_read), dram(is_dram), pseudoChannel(_channel), rank(_rank),
           bank(_bank), row(_row), bankId(bank_id), addr(_addr), size(_size),
-          burstHelper(NULL), _qosValue(_pkt->qosValue())
+          burstHelper(NULL), _qosValue(_pkt->qosValue()), queueSeq(0)
     { }
 
 };
 
-// The memory packets are store in a multiple dequeue structure,
-// based on their QoS priority
-typedef std::deque<MemPacket*> MemPacketQueue;
+/**
+ * The memory packets are stored in a multiple queue structure, based on
+ * their QoS priority. Besides keeping the packets of one priority in
+ * order of arrival, a queue indexes them per bank, so that the FR-FCFS
+ * schedulers only have to look at the oldest packets of every bank
+ * instead of walking the whole queue. The order across banks is kept
+ * with a sequence number given to every packet when it is queued.
+ */
+class MemPacketQueue
+{
+  public:
+    typedef std::list<MemPacket*> PacketList;
+    typedef PacketList::iterator iterator;
+    typedef PacketList::const_iterator const_iterator;
+
+    iterator begin() { return packets.begin(); }
+    iterator end() { return packets.end(); }
+    const_iterator begin() const { return packets.begin(); }
+    const_iterator end() const { return packets.end(); }
+
+    bool empty() const { return packets.empty(); }
+    size_t size() const { return packets.size(); }
+
+    void push_back(MemPacket* pkt);
+    iterator erase(iterator pos);
+
+    /**
+     * The queued packets of one memory interface, split per bank and
+     * indexed by MemPacket::bankId. Each list is in queue order.
+     *
+     * @param is_dram Packets to DRAM rather than NVM
+     * @param pseudo_channel Pseudo channel of the packets
+     * @return The per bank lists, or nullptr if no such packet was
+     *         ever queued
+     */
+    const std::vector<PacketList>* bankQueues(bool is_dram,
+                                              uint8_t pseudo_channel) const;
+
+    /** Position in the queue of a packet held by it */
+    static iterator position(MemPacket* pkt) { return pkt->queuePos; }
+
+  private:
+    struct Partition
+    {
+        bool dram;
+        uint8_t pseudoChannel;
+        std::vector<PacketList> banks;
+    };
+
+    PacketList packets;
+
+    /** One partition per memory interface that has queued packets */
+    std::vector<Partition> partitions;
+
+    uint64_t nextSeq = 0;
+};
 
 
 /**
@@ -297,14 +367,14 @@ class MemCtrl : public qos::MemCtrl
      * in these methods
      */
     virtual void processNextReqEvent(MemInterface* mem_intr,
-                          MemPacketQueue& resp_queue,
+                          std::deque<MemPacket*>& resp_queue,
                           EventFunctionWrapper& resp_event,
                           EventFunctionWrapper& next_req_event,
                           bool& retry_wr_req);
     EventFunctionWrapper nextReqEvent;
 
     virtual void processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req);
     EventFunctionWrapper respondEvent;
@@ -452,6 +522,17 @@ class MemCtrl : public qos::MemCtrl
      */
     virtual Addr burstAlign(Addr addr, MemInterface* mem_intr) const;
 
+    /**
+     * Translate the address of an incoming packet to the address it
+     * occupies on the media. The packet data is always accessed at
+     * its system address; only the timing model sees the media address.
+     *
+     * @param addr The system address
+     *
+     * @return The media address, identical to addr unless overridden
+     */
+    virtual Addr mediaAddr(Addr addr) const { return addr; }
+
     /**
      * Check if mem pkt's size is sane
      *
@@ -462,6 +543,38 @@ class MemCtrl : public qos::MemCtrl
     virtual bool pktSizeCheck(MemPacket* mem_pkt,
                               MemInterface* mem_intr) const;
 
+    /**
+     * Train the memory-side prefetcher on a read burst and update the
+     * prefetch candidate of the bank it maps to
+     *
+     * @param burst_addr Burst aligned address of the read
+     * @param bank_id Bank the read maps to
+     * @param mem_intr memory interface
+     */
+    void trainPrefetcher(Addr burst_addr, uint16_t bank_id,
+                         MemInterface* mem_intr);
+
+    /**
+     * Use an idle read slot to fetch one of the pending prefetch
+     * candidates into the prefetch buffer. The burst is issued like a
+     * read and is queued for response, but completes without
+     * responding to anyone.
+     *
+     * @return true if a prefetch was issued
+     */
+    bool issuePrefetch(MemInterface* mem_intr,
+                       std::deque<MemPacket*>& resp_queue,
+                       EventFunctionWrapper& resp_event);
+
+    /**
+     * Drop a burst from the prefetch buffer, accounting for it as
+     * unused if no read hit on it
+     *
+     * @param burst_addr Burst aligned address to drop
+     * @param invalidate True if a write made the buffered copy stale
+     */
+    void dropPrefetch(Addr burst_addr, bool invalidate = false);
+
     /**
      * The controller's main read and write queues,
      * with support for QoS reordering
@@ -558,6 +671,45 @@ class MemCtrl : public qos::MemCtrl
      */
     Tick nextReqTime;
 
+    /**
+     * A burst held in the prefetch buffer. The data is available from
+     * readyTime onwards, and we remember whether fetching it required
+     * a row activation to account for wasted activations.
+     */
+    struct PrefetchEntry
+    {
+        Addr addr;
+        Tick readyTime;
+        uint16_t bankId;
+        bool activated;
+    };
+
+    /**
+     * Per-bank view of the read stream used to train the prefetcher,
+     * holding the last burst read, the stride to it from the read
+     * before, and the next burst to prefetch, if any
+     */
+    struct BankStream
+    {
+        Addr lastAddr = MaxAddr;
+        Addr stride = 0;
+        Addr candidate = MaxAddr;
+    };
+
+    const MemPrefetchPolicy prefetchPolicy;
+    const uint32_t prefetchBufferSize;
+
+    /** Requestor used for the bursts issued by the prefetcher */
+    RequestorID prefetchRequestorId;
+
+    /** Buffered bursts in the order they were fetched, oldest first */
+    std::deque<PrefetchEntry> prefetchBuffer;
+
+    std::vector<BankStream> bankStreams;
+
+    /** Bank to start looking for a prefetch candidate from */
+    uint16_t nextPrefetchBank;
+
     struct CtrlStats : public statistics::Group
     {
         CtrlStats(MemCtrl &ctrl);
@@ -572,6 +724,7 @@ class MemCtrl : public qos::MemCtrl
         statistics::Scalar readBursts;
         statistics::Scalar writeBursts;
         statistics::Scalar servicedByWrQ;
+        statistics::Scalar servicedByPfBuf;
         statistics::Scalar mergedWrBursts;
         statistics::Scalar neitherReadNorWriteReqs;
         // Average queue lengths
@@ -587,12 +740,21 @@ class MemCtrl : public qos::MemCtrl
         statistics::Histogram rdPerTurnAround;
         statistics::Histogram wrPerTurnAround;
 
+        statistics::Scalar pfIssued;
+        statistics::Scalar pfUnused;
+        statistics::Scalar pfInvalidated;
+        statistics::Scalar pfActivations;
+        statistics::Scalar pfWastedActivations;
+        statistics::Formula pfAccuracy;
+
         statistics::Scalar bytesReadWrQ;
+        statistics::Scalar bytesReadPf;
         statistics::Scalar bytesReadSys;
         statistics::Scalar bytesWrittenSys;
         // Average bandwidth
         statistics::Formula avgRdBWSys;
         statistics::Formula avgWrBWSys;
+        statistics::Formula pfBWOverhead;
 
         statistics::Scalar totGap;
         statistics::Formula avgGap;
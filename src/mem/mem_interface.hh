@@ -255,6 +255,11 @@ class MemInterface : public AbstractMemory
      */
     uint32_t bytesPerBurst() const { return burstSize; }
 
+    /**
+     * @return number of banks across all ranks of this interface
+     */
+    uint32_t numBanks() const { return ranksPerChannel * banksPerRank; }
+
     /*
      * @return time to offset next command
      */
@@ -267,6 +272,15 @@ class MemInterface : public AbstractMemory
      */
     virtual bool burstReady(MemPacket* pkt) const = 0;
 
+    /**
+     * Check if the row targeted by a packet is open in its bank, i.e.
+     * whether the access can proceed without an activate
+     *
+     * @param pkt Decoded packet to check
+     * @return true if the access would be a row hit
+     */
+    virtual bool rowOpen(MemPacket* pkt) const { return false; }
+
     /**
      * Determine the required delay for an access to a different rank
      *
@@ -221,6 +221,7 @@ public:
     {
         EmulationPageTable::map(vaddr, paddr, size, flags);
 
+        // Large pages are written out as runs of base page entries.
         Final entry;
 
         for (int64_t offset = 0; offset < size; offset += _pageSize) {
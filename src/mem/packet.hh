@@ -57,9 +57,11 @@
 #include "base/compiler.hh"
 #include "base/flags.hh"
 #include "base/logging.hh"
+#include "base/object_pool.hh"
 #include "base/printable.hh"
 #include "base/types.hh"
 #include "mem/htm.hh"
+#include "mem/packet_buffer.hh"
 #include "mem/request.hh"
 #include "sim/byteswap.hh"
 
@@ -347,8 +349,9 @@ class Packet : public Printable
         /// when the packet is destroyed?
         STATIC_DATA            = 0x00001000,
         /// The data pointer points to a value that should be freed when
-        /// the packet is destroyed. The pointer is assumed to be pointing
-        /// to an array, and delete [] is consequently called
+        /// the packet is destroyed. The pointer is either into a pooled
+        /// PacketBuffer, which is released, or to an array, and delete []
+        /// is consequently called
         DYNAMIC_DATA           = 0x00002000,
 
         /// suppress the error if this packet encounters a functional
@@ -383,6 +386,14 @@ class Packet : public Printable
     */
     PacketDataPtr data;
 
+    /**
+     * The pooled buffer holding the data, if it was allocated by the
+     * packet itself rather than handed in through dataDynamic. The
+     * buffer may be shared with other packets, in which case it is
+     * copied before the data is modified.
+     */
+    PacketBufferPtr buffer;
+
     /// The address of the request.  This address could be virtual or
     /// physical, depending on the system configuration.
     Addr addr;
@@ -852,6 +863,9 @@ class Packet : public Printable
         cmd = MemCmd::ReadReq;
     }
 
+    // Every access creates at least one packet, so recycle their storage
+    GEM5_POOLED_NEW(Packet)
+
     /**
      * Constructor. Note that a Request object must be constructed
      * first, but the Requests's physical address and size fields need
@@ -1190,7 +1204,10 @@ class Packet : public Printable
     }
 
     /**
-     * get a pointer to the data ptr.
+     * get a pointer to the data ptr. The pointer may be written
+     * through, so data shared with other packets is copied first (see
+     * shareDataFrom); callers that only read the data should use
+     * getConstPtr to avoid the copy.
      */
     template <typename T>
     T*
@@ -1198,6 +1215,7 @@ class Packet : public Printable
     {
         assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA));
         assert(!isMaskedWrite());
+        unshareData(true);
         return (T*)data;
     }
 
@@ -1267,7 +1285,11 @@ class Packet : public Printable
         // we should never be copying data onto itself, which means we
         // must idenfity packets with static data, as they carry the
         // same pointer from source to destination and back
-        assert(p != getPtr<uint8_t>() || flags.isSet(STATIC_DATA));
+        assert(p != getConstPtr<uint8_t>() || flags.isSet(STATIC_DATA));
+
+        // the old contents are about to be overwritten, so there is no
+        // need to copy them if the buffer is shared
+        unshareData(false);
 
         if (p != getPtr<uint8_t>()) {
             // for packet with allocated dynamic data, we copy data from
@@ -1276,6 +1298,29 @@ class Packet : public Printable
         }
     }
 
+    /**
+     * Take the data for this packet from another packet covering it,
+     * e.g. a response being passed on to the request it satisfies. If
+     * both packets allocated their own data the other packet's buffer
+     * is shared rather than copied, and the first of the two to be
+     * modified makes a private copy. Otherwise the data is copied as
+     * with setData.
+     */
+    void
+    shareDataFrom(const Packet *src)
+    {
+        assert(src->getAddr() <= getAddr() &&
+               getAddr() + getSize() <= src->getAddr() + src->getSize());
+        const Addr offset = getAddr() - src->getAddr();
+
+        if (buffer && src->buffer) {
+            buffer = src->buffer;
+            data = src->data + offset;
+        } else {
+            setData(src->getConstPtr<uint8_t>() + offset);
+        }
+    }
+
     /**
      * Copy data into the packet from the provided block pointer,
      * which is aligned to the given block size.
@@ -1327,7 +1372,9 @@ class Packet : public Printable
     void
     deleteData()
     {
-        if (flags.isSet(DYNAMIC_DATA))
+        if (buffer)
+            buffer = nullptr;
+        else if (flags.isSet(DYNAMIC_DATA))
             delete [] data;
 
         flags.clear(STATIC_DATA|DYNAMIC_DATA);
@@ -1343,7 +1390,8 @@ class Packet : public Printable
         if (hasData() || hasRespData()) {
             assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
             flags.set(DYNAMIC_DATA);
-            data = new uint8_t[getSize()];
+            buffer = PacketBuffer::create(getSize());
+            data = buffer->data();
         }
     }
 
@@ -1357,6 +1405,26 @@ class Packet : public Printable
     template <typename T>
     void setRaw(T v);
 
+  private:
+    /**
+     * Give the packet a private copy of its data if the buffer holding
+     * it is shared with other packets.
+     *
+     * @param keep_contents Whether to copy the current contents over.
+     */
+    void
+    unshareData(bool keep_contents)
+    {
+        if (!buffer || !buffer->isShared())
+            return;
+
+        PacketBufferPtr copy = PacketBuffer::create(getSize());
+        if (keep_contents)
+            std::memcpy(copy->data(), data, getSize());
+        buffer = copy;
+        data = buffer->data();
+    }
+
   public:
     /**
      * Check a functional request against a memory value stored in
@@ -0,0 +1,196 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/packet.hh"
+#include "mem/packet_access.hh"
+#include "mem/request.hh"
+
+using namespace gem5;
+
+// Requests are stamped with the current tick
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+const Addr BlockAddr = 0x1000;
+const unsigned BlockSize = 64;
+
+/** A read whose payload is allocated, and thus pooled, by the packet. */
+std::unique_ptr<Packet>
+makeRead(Addr addr, unsigned size)
+{
+    auto req = std::make_shared<Request>(addr, size, 0, 0);
+    auto pkt = std::make_unique<Packet>(req, MemCmd::ReadReq);
+    pkt->allocate();
+    return pkt;
+}
+
+void
+fill(Packet &pkt, uint8_t value)
+{
+    std::memset(pkt.getPtr<uint8_t>(), value, pkt.getSize());
+}
+
+/** Does every byte of the packet payload hold the given value? */
+bool
+holds(const Packet &pkt, uint8_t value)
+{
+    const uint8_t *data = pkt.getConstPtr<uint8_t>();
+    for (unsigned i = 0; i < pkt.getSize(); ++i) {
+        if (data[i] != value)
+            return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+/** A shared payload is not copied until either side modifies it. */
+TEST(PacketShareTest, SharesPooledPayload)
+{
+    auto src = makeRead(BlockAddr, BlockSize);
+    auto dst = makeRead(BlockAddr, BlockSize);
+    fill(*src, 0x11);
+
+    dst->shareDataFrom(src.get());
+    EXPECT_EQ(dst->getConstPtr<uint8_t>(), src->getConstPtr<uint8_t>());
+    EXPECT_TRUE(holds(*dst, 0x11));
+}
+
+TEST(PacketShareTest, GetPtrOnEitherSide)
+{
+    auto src = makeRead(BlockAddr, BlockSize);
+    auto dst = makeRead(BlockAddr, BlockSize);
+    fill(*src, 0x11);
+    dst->shareDataFrom(src.get());
+
+    dst->getPtr<uint8_t>()[0] = 0x22;
+    EXPECT_TRUE(holds(*src, 0x11));
+    EXPECT_EQ(dst->getConstPtr<uint8_t>()[0], 0x22);
+    EXPECT_EQ(dst->getConstPtr<uint8_t>()[1], 0x11);
+
+    auto other = makeRead(BlockAddr, BlockSize);
+    other->shareDataFrom(src.get());
+    src->getPtr<uint8_t>()[BlockSize - 1] = 0x33;
+    EXPECT_TRUE(holds(*other, 0x11));
+    EXPECT_EQ(src->getConstPtr<uint8_t>()[BlockSize - 1], 0x33);
+}
+
+TEST(PacketShareTest, SetRawOnEitherSide)
+{
+    auto src = makeRead(BlockAddr, BlockSize);
+    auto dst = makeRead(BlockAddr, BlockSize);
+    fill(*src, 0x11);
+    dst->shareDataFrom(src.get());
+
+    dst->setRaw<uint64_t>(0);
+    EXPECT_TRUE(holds(*src, 0x11));
+    EXPECT_EQ(dst->getRaw<uint64_t>(), 0);
+    EXPECT_EQ(dst->getConstPtr<uint8_t>()[8], 0x11);
+
+    auto other = makeRead(BlockAddr, BlockSize);
+    other->shareDataFrom(src.get());
+    src->setRaw<uint32_t>(0xffffffff);
+    EXPECT_TRUE(holds(*other, 0x11));
+    EXPECT_EQ(src->getRaw<uint32_t>(), 0xffffffff);
+}
+
+TEST(PacketShareTest, SetDataOnEitherSide)
+{
+    auto src = makeRead(BlockAddr, BlockSize);
+    auto dst = makeRead(BlockAddr, BlockSize);
+    fill(*src, 0x11);
+    dst->shareDataFrom(src.get());
+
+    uint8_t data[BlockSize];
+    std::memset(data, 0x44, BlockSize);
+    dst->setData(data);
+    EXPECT_TRUE(holds(*src, 0x11));
+    EXPECT_TRUE(holds(*dst, 0x44));
+
+    dst->shareDataFrom(src.get());
+    std::memset(data, 0x55, BlockSize);
+    src->setData(data);
+    EXPECT_TRUE(holds(*dst, 0x11));
+    EXPECT_TRUE(holds(*src, 0x55));
+}
+
+/** A packet covering part of the source shares the matching bytes. */
+TEST(PacketShareTest, SharesPartOfPayload)
+{
+    auto src = makeRead(BlockAddr, BlockSize);
+    for (unsigned i = 0; i < BlockSize; ++i)
+        src->getPtr<uint8_t>()[i] = i;
+
+    auto dst = makeRead(BlockAddr + 8, 8);
+    dst->shareDataFrom(src.get());
+    EXPECT_EQ(dst->getConstPtr<uint8_t>(), src->getConstPtr<uint8_t>() + 8);
+
+    dst->setRaw<uint8_t>(0xff);
+    EXPECT_EQ(src->getConstPtr<uint8_t>()[8], 8);
+    EXPECT_EQ(dst->getConstPtr<uint8_t>()[0], 0xff);
+    EXPECT_EQ(dst->getConstPtr<uint8_t>()[7], 15);
+
+    src.reset();
+    EXPECT_EQ(dst->getConstPtr<uint8_t>()[1], 9);
+}
+
+/** A payload the packet did not allocate is copied rather than shared. */
+TEST(PacketShareTest, CopiesPayloadNotPooled)
+{
+    uint8_t storage[BlockSize];
+    std::memset(storage, 0x11, BlockSize);
+    auto req = std::make_shared<Request>(BlockAddr, BlockSize, 0, 0);
+    Packet src(req, MemCmd::ReadReq);
+    src.dataStatic(storage);
+
+    auto dst = makeRead(BlockAddr, BlockSize);
+    dst->shareDataFrom(&src);
+    EXPECT_NE(dst->getConstPtr<uint8_t>(), src.getConstPtr<uint8_t>());
+    EXPECT_TRUE(holds(*dst, 0x11));
+
+    std::memset(storage, 0x22, BlockSize);
+    EXPECT_TRUE(holds(*dst, 0x11));
+
+    // and the other way around, into a payload the packet doesn't own
+    auto pooled = makeRead(BlockAddr, BlockSize);
+    fill(*pooled, 0x33);
+    src.shareDataFrom(pooled.get());
+    EXPECT_EQ(src.getConstPtr<uint8_t>(), storage);
+    EXPECT_TRUE(holds(src, 0x33));
+    fill(*pooled, 0x44);
+    EXPECT_TRUE(holds(src, 0x33));
+}
@@ -62,6 +62,7 @@ Packet::setRaw(T v)
 {
     assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA));
     assert(sizeof(T) <= size);
+    unshareData(true);
     *(T*)data = v;
 }
 
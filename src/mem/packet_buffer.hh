@@ -0,0 +1,168 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Reference counted, pooled storage for packet payloads.
+ */
+
+#ifndef __MEM_PACKET_BUFFER_HH__
+#define __MEM_PACKET_BUFFER_HH__
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/refcnt.hh"
+
+namespace gem5
+{
+
+class PacketBuffer;
+typedef RefCountingPtr<PacketBuffer> PacketBufferPtr;
+
+/**
+ * Payload storage that several packets may point into at once. A fill
+ * travelling up the hierarchy, or a response forwarded to the packet
+ * that asked for it, can then hand over its data without a copy; a
+ * packet about to modify a buffer it does not own alone copies it
+ * first (see Packet::getPtr).
+ *
+ * The header and the payload are a single block, recycled through
+ * power-of-two size classes on thread local free lists. A block may be
+ * released by another thread than the one that allocated it, as the
+ * lists only ever hold blocks from the global allocator. Since buffers
+ * may keep moving in one direction between threads, each list is
+ * capped at MaxFreeBlocks and gives the excess back. The reference
+ * count is atomic since the packets sharing a buffer can end up on
+ * different event queues.
+ */
+class alignas(16) PacketBuffer
+{
+  public:
+    /** Smallest size class, in bytes. */
+    static constexpr unsigned MinPooledSize = 16;
+    /** Largest size class, in bytes. Larger buffers are not recycled. */
+    static constexpr unsigned MaxPooledSize = 4096;
+    /** Most blocks kept on the free list of a size class and thread. */
+    static constexpr std::size_t MaxFreeBlocks = 1024;
+
+    static PacketBufferPtr
+    create(unsigned size)
+    {
+        const unsigned size_class = sizeClass(size);
+        void *block = nullptr;
+        if (size_class < NumSizeClasses) {
+            auto &blocks = freeList().blocks[size_class];
+            if (!blocks.empty()) {
+                block = blocks.back();
+                blocks.pop_back();
+            } else {
+                block = ::operator new(
+                    sizeof(PacketBuffer) + (MinPooledSize << size_class));
+            }
+        } else {
+            block = ::operator new(sizeof(PacketBuffer) + size);
+        }
+        return PacketBufferPtr(new (block) PacketBuffer(size_class));
+    }
+
+    uint8_t *data() { return reinterpret_cast<uint8_t *>(this + 1); }
+
+    /** Is more than one reference to this buffer held? */
+    bool isShared() const { return count.load() > 1; }
+
+    void incref() const { count.fetch_add(1, std::memory_order_relaxed); }
+
+    void
+    decref() const
+    {
+        if (count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            release(const_cast<PacketBuffer *>(this));
+    }
+
+  private:
+    static constexpr unsigned NumSizeClasses =
+        floorLog2(MaxPooledSize / MinPooledSize) + 1;
+
+    PacketBuffer(unsigned size_class) : count(0), _sizeClass(size_class) {}
+
+    static unsigned
+    sizeClass(unsigned size)
+    {
+        if (size <= MinPooledSize)
+            return 0;
+        return ceilLog2(size) - floorLog2(MinPooledSize);
+    }
+
+    static void
+    release(PacketBuffer *buffer)
+    {
+        const unsigned size_class = buffer->_sizeClass;
+        buffer->~PacketBuffer();
+        if (size_class < NumSizeClasses) {
+            auto &blocks = freeList().blocks[size_class];
+            if (blocks.size() < MaxFreeBlocks) {
+                blocks.push_back(buffer);
+                return;
+            }
+        }
+        ::operator delete(buffer);
+    }
+
+    struct FreeList
+    {
+        std::vector<void *> blocks[NumSizeClasses];
+
+        ~FreeList()
+        {
+            for (auto &size_class : blocks) {
+                for (auto block : size_class)
+                    ::operator delete(block);
+            }
+        }
+    };
+
+    static FreeList &
+    freeList()
+    {
+        static thread_local FreeList free_list;
+        return free_list;
+    }
+
+    mutable std::atomic<int> count;
+    const unsigned _sizeClass;
+};
+
+} // namespace gem5
+
+#endif // __MEM_PACKET_BUFFER_HH__
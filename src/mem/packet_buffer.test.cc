@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "mem/packet_buffer.hh"
+
+using namespace gem5;
+
+TEST(PacketBufferTest, SharedWhileReferenced)
+{
+    PacketBufferPtr buffer = PacketBuffer::create(64);
+    EXPECT_FALSE(buffer->isShared());
+
+    std::memset(buffer->data(), 0xa5, 64);
+    {
+        PacketBufferPtr other = buffer;
+        EXPECT_TRUE(buffer->isShared());
+        EXPECT_EQ(other->data(), buffer->data());
+        EXPECT_EQ(other->data()[63], 0xa5);
+    }
+    EXPECT_FALSE(buffer->isShared());
+}
+
+TEST(PacketBufferTest, ReleasedBlocksAreRecycled)
+{
+    uint8_t *first = PacketBuffer::create(64)->data();
+
+    // Any size in the same size class reuses the released block
+    PacketBufferPtr buffer = PacketBuffer::create(40);
+    EXPECT_EQ(buffer->data(), first);
+
+    // A different size class does not
+    PacketBufferPtr small = PacketBuffer::create(16);
+    EXPECT_NE(small->data(), first);
+}
+
+TEST(PacketBufferTest, LargeBuffers)
+{
+    const unsigned size = PacketBuffer::MaxPooledSize * 2;
+    PacketBufferPtr buffer = PacketBuffer::create(size);
+    std::memset(buffer->data(), 0, size);
+    EXPECT_EQ(buffer->data()[size - 1], 0);
+}
+
+TEST(PacketBufferTest, PayloadAlignment)
+{
+    PacketBufferPtr buffer = PacketBuffer::create(8);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer->data()) % 16, 0);
+}
@@ -34,8 +34,11 @@
 #include "mem/page_table.hh"
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/compiler.hh"
+#include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/MMU.hh"
 #include "sim/faults.hh"
@@ -44,6 +47,63 @@
 namespace gem5
 {
 
+void
+EmulationPageTable::setLargePageSize(Addr size)
+{
+    fatal_if(!isPowerOf2(size) || size <= _pageSize,
+             "Large pages of %#x bytes don't fit %#x byte base pages.",
+             size, _pageSize);
+    _largePageSize = size;
+}
+
+EmulationPageTable::PTableItr
+EmulationPageTable::findPage(Addr vaddr)
+{
+    auto it = pTable.upper_bound(vaddr);
+    if (it == pTable.begin())
+        return pTable.end();
+    --it;
+    if (vaddr - it->first >= it->second.size())
+        return pTable.end();
+    return it;
+}
+
+void
+EmulationPageTable::splitPageAt(Addr vaddr)
+{
+    auto it = findPage(vaddr);
+    if (it == pTable.end() || it->first == vaddr)
+        return;
+
+    const Addr start = it->first;
+    const Entry large = it->second;
+    DPRINTF(MMU, "Splitting large page: %#x-%#x\n", start,
+            start + large.size());
+
+    pTable.erase(it);
+    const unsigned log_bytes = floorLog2(_pageSize);
+    for (Addr offset = 0; offset < large.size(); offset += _pageSize) {
+        pTable.emplace(start + offset,
+                       Entry(large.paddr + offset, large.flags, log_bytes));
+    }
+}
+
+Addr
+EmulationPageTable::erasePages(Addr vaddr, int64_t size)
+{
+    const Addr end = vaddr + roundUp(size, _pageSize);
+    splitPageAt(vaddr);
+    splitPageAt(end);
+
+    auto first = pTable.lower_bound(vaddr);
+    auto last = pTable.lower_bound(end);
+    Addr bytes = 0;
+    for (auto it = first; it != last; ++it)
+        bytes += it->second.size();
+    pTable.erase(first, last);
+    return bytes;
+}
+
 void
 EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 {
@@ -51,23 +111,31 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
     // starting address must be page aligned
     assert(pageOffset(vaddr) == 0);
 
+    unsigned log_bytes = floorLog2(_pageSize);
+    if (flags & LargePage) {
+        panic_if(!_largePageSize, "Large page mapping at %#x without "
+                 "large pages enabled.", vaddr);
+        // large pages are aligned both virtually and physically
+        assert(((vaddr | paddr | size) & (_largePageSize - 1)) == 0);
+        log_bytes = floorLog2(_largePageSize);
+    }
+    const Addr page_size = Addr(1) << log_bytes;
+
     DPRINTF(MMU, "Allocating Page: %#x-%#x\n", vaddr, vaddr + size);
 
-    while (size > 0) {
-        auto it = pTable.find(vaddr);
-        if (it != pTable.end()) {
-            // already mapped
-            panic_if(!clobber,
-                     "EmulationPageTable::allocate: addr %#x already mapped",
-                     vaddr);
-            it->second = Entry(paddr, flags);
-        } else {
-            pTable.emplace(vaddr, Entry(paddr, flags));
-        }
+    if (clobber)
+        erasePages(vaddr, size);
 
-        size -= _pageSize;
-        vaddr += _pageSize;
-        paddr += _pageSize;
+    while (size > 0) {
+        // already mapped
+        panic_if(!EmulationPageTable::isUnmapped(vaddr, page_size),
+                 "EmulationPageTable::allocate: addr %#x already mapped",
+                 vaddr);
+        pTable.emplace(vaddr, Entry(paddr, flags, log_bytes));
+
+        size -= page_size;
+        vaddr += page_size;
+        paddr += page_size;
     }
 }
 
@@ -80,24 +148,46 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
     DPRINTF(MMU, "moving pages from vaddr %08p to %08p, size = %d\n", vaddr,
             new_vaddr, size);
 
-    while (size > 0) {
-        [[maybe_unused]] auto new_it = pTable.find(new_vaddr);
-        auto old_it = pTable.find(vaddr);
-        assert(old_it != pTable.end() && new_it == pTable.end());
-
-        pTable.emplace(new_vaddr, old_it->second);
-        pTable.erase(old_it);
-        size -= _pageSize;
-        vaddr += _pageSize;
-        new_vaddr += _pageSize;
+    // Take the pages out first, the two regions may overlap.
+    const Addr end = vaddr + roundUp(size, _pageSize);
+    splitPageAt(vaddr);
+    splitPageAt(end);
+    auto first = pTable.lower_bound(vaddr);
+    auto last = pTable.lower_bound(end);
+    const std::vector<std::pair<Addr, Entry>> moved(first, last);
+    pTable.erase(first, last);
+
+    const unsigned log_bytes = floorLog2(_pageSize);
+    [[maybe_unused]] Addr moved_bytes = 0;
+    for (const auto &[old_vaddr, entry] : moved) {
+        const Addr to = new_vaddr + (old_vaddr - vaddr);
+        assert(EmulationPageTable::isUnmapped(to, entry.size()));
+        moved_bytes += entry.size();
+
+        if ((to & (entry.size() - 1)) == 0) {
+            pTable.emplace(to, entry);
+            continue;
+        }
+
+        // A large page moved off its alignment is kept as base pages.
+        for (Addr offset = 0; offset < entry.size(); offset += _pageSize) {
+            pTable.emplace(to + offset, Entry(entry.paddr + offset,
+                                              entry.flags, log_bytes));
+        }
     }
+    assert(moved_bytes == end - vaddr);
 }
 
 void
 EmulationPageTable::getMappings(std::vector<std::pair<Addr, Addr>> *addr_maps)
 {
-    for (auto &iter : pTable)
-        addr_maps->push_back(std::make_pair(iter.first, iter.second.paddr));
+    for (auto &iter : pTable) {
+        for (Addr offset = 0; offset < iter.second.size();
+                offset += _pageSize) {
+            addr_maps->push_back(std::make_pair(iter.first + offset,
+                                                iter.second.paddr + offset));
+        }
+    }
 }
 
 void
@@ -107,13 +197,8 @@ EmulationPageTable::unmap(Addr vaddr, int64_t size)
 
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
 
-    while (size > 0) {
-        auto it = pTable.find(vaddr);
-        assert(it != pTable.end());
-        pTable.erase(it);
-        size -= _pageSize;
-        vaddr += _pageSize;
-    }
+    [[maybe_unused]] Addr unmapped = erasePages(vaddr, size);
+    assert(unmapped == roundUp(size, _pageSize));
 }
 
 bool
@@ -122,18 +207,17 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
     // starting address must be page aligned
     assert(pageOffset(vaddr) == 0);
 
-    for (int64_t offset = 0; offset < size; offset += _pageSize)
-        if (pTable.find(vaddr + offset) != pTable.end())
-            return false;
+    if (findPage(vaddr) != pTable.end())
+        return false;
 
-    return true;
+    auto next = pTable.lower_bound(vaddr);
+    return next == pTable.end() || next->first >= vaddr + size;
 }
 
 const EmulationPageTable::Entry *
 EmulationPageTable::lookup(Addr vaddr)
 {
-    Addr page_addr = pageAlign(vaddr);
-    PTableItr iter = pTable.find(page_addr);
+    PTableItr iter = findPage(vaddr);
     if (iter == pTable.end())
         return nullptr;
     return &(iter->second);
@@ -147,7 +231,7 @@ EmulationPageTable::translate(Addr vaddr, Addr &paddr)
         DPRINTF(MMU, "Couldn't Translate: %#x\n", vaddr);
         return false;
     }
-    paddr = pageOffset(vaddr) + entry->paddr;
+    paddr = entry->translate(vaddr);
     DPRINTF(MMU, "Translating: %#x->%#x\n", vaddr, paddr);
     return true;
 }
@@ -195,6 +279,7 @@ EmulationPageTable::serialize(CheckpointOut &cp) const
         paramOut(cp, "vaddr", pte.first);
         paramOut(cp, "paddr", pte.second.paddr);
         paramOut(cp, "flags", pte.second.flags);
+        paramOut(cp, "log_bytes", pte.second.logBytes);
     }
     assert(count == pTable.size());
 }
@@ -215,8 +300,11 @@ EmulationPageTable::unserialize(CheckpointIn &cp)
         uint64_t flags;
         UNSERIALIZE_SCALAR(paddr);
         UNSERIALIZE_SCALAR(flags);
+        // checkpoints without large pages only hold base pages
+        unsigned log_bytes = floorLog2(_pageSize);
+        optParamIn(cp, "log_bytes", log_bytes, false);
 
-        pTable.emplace(vaddr, Entry(paddr, flags));
+        pTable.emplace(vaddr, Entry(paddr, flags, log_bytes));
     }
 }
 
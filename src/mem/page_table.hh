@@ -35,8 +35,8 @@
 #ifndef __MEM_PAGE_TABLE_HH__
 #define __MEM_PAGE_TABLE_HH__
 
+#include <map>
 #include <string>
-#include <unordered_map>
 
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
@@ -57,19 +57,41 @@ class EmulationPageTable : public Serializable
     {
         Addr paddr;
         uint64_t flags;
+        // log2 of the size of the page, base or large
+        unsigned logBytes;
 
-        Entry(Addr paddr, uint64_t flags) : paddr(paddr), flags(flags) {}
-        Entry() {}
+        Entry(Addr paddr, uint64_t flags, unsigned log_bytes) :
+            paddr(paddr), flags(flags), logBytes(log_bytes)
+        {}
+        // an unset entry stands for a 4KiB page, the smallest base page
+        Entry() : paddr(0), flags(0), logBytes(12) {}
+
+        Addr size() const { return Addr(1) << logBytes; }
+
+        /** Physical address of vaddr, which must lie within this page. */
+        Addr
+        translate(Addr vaddr) const
+        {
+            return paddr | (vaddr & mask(logBytes));
+        }
     };
 
   protected:
-    typedef std::unordered_map<Addr, Entry> PTable;
+    /**
+     * Pages ordered by their virtual address. An entry maps a naturally
+     * aligned page of either the base or the large page size, so the page
+     * holding an address is the last one starting at or below it.
+     */
+    typedef std::map<Addr, Entry> PTable;
     typedef PTable::iterator PTableItr;
     PTable pTable;
 
     const Addr _pageSize;
     const Addr offsetMask;
 
+    // size of large pages, zero when they are not used
+    Addr _largePageSize = 0;
+
     const uint64_t _pid;
     const std::string _name;
 
@@ -92,12 +114,14 @@ class EmulationPageTable : public Serializable
      * bit 0 - no-clobber | clobber
      * bit 2 - cacheable  | uncacheable
      * bit 3 - read-write | read-only
+     * bit 4 - base pages | large pages
      */
     enum MappingFlags : uint32_t
     {
         Clobber     = 1,
         Uncacheable = 4,
         ReadOnly    = 8,
+        LargePage   = 16,
     };
 
     // flag which marks the page table as shared among software threads
@@ -114,13 +138,22 @@ class EmulationPageTable : public Serializable
     // ignore that for now.
     Addr pageSize()   { return _pageSize; }
 
+    /**
+     * Enable mappings made with the LargePage flag.
+     * @param size The size of a large page, a power of two multiple of
+     *             the base page size.
+     */
+    void setLargePageSize(Addr size);
+    Addr largePageSize() const { return _largePageSize; }
+
     /**
      * Maps a virtual memory region to a physical memory region.
      * @param vaddr The starting virtual address of the region.
      * @param paddr The starting physical address where the region is mapped.
      * @param size The length of the region.
      * @param flags Generic mapping flags that can be set by or-ing values
-     *              from MappingFlags enum.
+     *              from MappingFlags enum. With LargePage set, vaddr, paddr
+     *              and size must all be multiples of the large page size.
      */
     virtual void map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags = 0);
     virtual void remap(Addr vaddr, int64_t size, Addr new_vaddr);
@@ -198,6 +231,23 @@ class EmulationPageTable : public Serializable
 
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
+
+  protected:
+    /** Find the page holding vaddr, or pTable.end() if it's unmapped. */
+    PTableItr findPage(Addr vaddr);
+
+    /**
+     * Break up a large page crossing vaddr into base pages so that a page
+     * boundary falls on vaddr.
+     */
+    void splitPageAt(Addr vaddr);
+
+    /**
+     * Remove every page within a region, splitting any large page which
+     * is only partly covered.
+     * @return The number of bytes that were mapped.
+     */
+    Addr erasePages(Addr vaddr, int64_t size);
 };
 
 } // namespace gem5
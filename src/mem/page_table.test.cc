@@ -0,0 +1,229 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+
+#include "base/gtest/serialization_fixture.hh"
+#include "mem/page_table.hh"
+#include "sim/faults.hh"
+
+using namespace gem5;
+
+namespace gem5
+{
+
+// The page table only creates page table faults, it never invokes them
+void FaultBase::invoke(ThreadContext *tc, const StaticInstPtr &inst) {}
+void
+GenericPageTableFault::invoke(ThreadContext *tc, const StaticInstPtr &inst)
+{}
+
+} // namespace gem5
+
+namespace
+{
+
+const Addr PageSize = 0x1000;
+const Addr LargeSize = 0x200000;
+
+class TestPageTable : public EmulationPageTable
+{
+  public:
+    TestPageTable() : EmulationPageTable("pt", 0, PageSize)
+    {
+        setLargePageSize(LargeSize);
+    }
+};
+
+Addr
+translated(TestPageTable &pt, Addr vaddr)
+{
+    Addr paddr = 0;
+    EXPECT_TRUE(pt.translate(vaddr, paddr));
+    return paddr;
+}
+
+} // anonymous namespace
+
+TEST(PageTableTest, DefaultEntryIsBasePage)
+{
+    EmulationPageTable::Entry entry;
+    EXPECT_EQ(entry.size(), PageSize);
+}
+
+/** Unmapping part of a large page keeps the rest as base pages. */
+TEST(PageTableTest, PartialUnmapOfLargePage)
+{
+    TestPageTable pt;
+    pt.map(LargeSize, 2 * LargeSize, LargeSize,
+           EmulationPageTable::LargePage);
+
+    const EmulationPageTable::Entry *entry = pt.lookup(LargeSize + 0x1234);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->size(), LargeSize);
+
+    pt.unmap(LargeSize + PageSize, 2 * PageSize);
+
+    EXPECT_TRUE(pt.isUnmapped(LargeSize + PageSize, 2 * PageSize));
+    EXPECT_FALSE(pt.isUnmapped(LargeSize, 2 * PageSize));
+    EXPECT_FALSE(pt.isUnmapped(LargeSize + 2 * PageSize, 2 * PageSize));
+    EXPECT_EQ(pt.lookup(LargeSize + PageSize), nullptr);
+    EXPECT_EQ(pt.lookup(LargeSize + 3 * PageSize - 1), nullptr);
+    EXPECT_FALSE(pt.translate(LargeSize + PageSize + 8));
+
+    // the pages around the hole are base pages of the same mapping
+    entry = pt.lookup(LargeSize);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->size(), PageSize);
+    entry = pt.lookup(2 * LargeSize - 1);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->size(), PageSize);
+
+    EXPECT_EQ(translated(pt, LargeSize + 0x123), 2 * LargeSize + 0x123);
+    EXPECT_EQ(translated(pt, LargeSize + 3 * PageSize + 0x10),
+              2 * LargeSize + 3 * PageSize + 0x10);
+    EXPECT_EQ(translated(pt, 2 * LargeSize - 1), 3 * LargeSize - 1);
+
+    // the region outside of the large page is untouched
+    EXPECT_TRUE(pt.isUnmapped(0, LargeSize));
+    EXPECT_TRUE(pt.isUnmapped(2 * LargeSize, LargeSize));
+}
+
+/** Moving pages onto a region they partly cover keeps every page. */
+TEST(PageTableTest, OverlappingRemap)
+{
+    TestPageTable pt;
+    const Addr vaddr = 0x10000;
+    const Addr paddr = 0x80000;
+    pt.map(vaddr, paddr, 4 * PageSize);
+
+    pt.remap(vaddr, 4 * PageSize, vaddr + 2 * PageSize);
+
+    EXPECT_TRUE(pt.isUnmapped(vaddr, 2 * PageSize));
+    for (Addr offset = 0; offset < 4 * PageSize; offset += PageSize) {
+        EXPECT_EQ(translated(pt, vaddr + 2 * PageSize + offset + 0x40),
+                  paddr + offset + 0x40);
+    }
+    EXPECT_TRUE(pt.isUnmapped(vaddr + 6 * PageSize, PageSize));
+
+    // and back down again
+    pt.remap(vaddr + 2 * PageSize, 4 * PageSize, vaddr + PageSize);
+    EXPECT_TRUE(pt.isUnmapped(vaddr, PageSize));
+    EXPECT_EQ(translated(pt, vaddr + PageSize), paddr);
+    EXPECT_EQ(translated(pt, vaddr + 5 * PageSize - 1),
+              paddr + 4 * PageSize - 1);
+    EXPECT_TRUE(pt.isUnmapped(vaddr + 5 * PageSize, PageSize));
+}
+
+/** A large page moved off its alignment is kept as base pages. */
+TEST(PageTableTest, RemapLargePage)
+{
+    TestPageTable pt;
+    pt.map(LargeSize, 2 * LargeSize, LargeSize,
+           EmulationPageTable::LargePage);
+
+    // an aligned move keeps the large page
+    pt.remap(LargeSize, LargeSize, 3 * LargeSize);
+    EXPECT_TRUE(pt.isUnmapped(LargeSize, LargeSize));
+    const EmulationPageTable::Entry *entry = pt.lookup(3 * LargeSize);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->size(), LargeSize);
+
+    // overlapping and misaligned, the large page is split
+    const Addr to = 3 * LargeSize + PageSize;
+    pt.remap(3 * LargeSize, LargeSize, to);
+    EXPECT_TRUE(pt.isUnmapped(3 * LargeSize, PageSize));
+    entry = pt.lookup(to);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->size(), PageSize);
+    EXPECT_EQ(translated(pt, to + 0x10), 2 * LargeSize + 0x10);
+    EXPECT_EQ(translated(pt, to + LargeSize - 1), 3 * LargeSize - 1);
+    EXPECT_TRUE(pt.isUnmapped(to + LargeSize, PageSize));
+}
+
+using PageTableSerializationFixture = SerializationFixture;
+
+/** Base and large pages survive a serialize round-trip. */
+TEST_F(PageTableSerializationFixture, RoundTrip)
+{
+    TestPageTable pt;
+    pt.map(LargeSize, 2 * LargeSize, LargeSize,
+           EmulationPageTable::LargePage);
+    pt.map(0x10000, 0x80000, 2 * PageSize, EmulationPageTable::ReadOnly);
+    pt.unmap(LargeSize + 4 * PageSize, PageSize);
+
+    std::ofstream cp(getCptPath());
+    {
+        Serializable::ScopedCheckpointSection scs(cp, "Section1");
+        pt.serialize(cp);
+    }
+    cp.close();
+
+    TestPageTable restored;
+    CheckpointIn cpt(getDirName());
+    {
+        Serializable::ScopedCheckpointSection scs(cpt, "Section1");
+        restored.unserialize(cpt);
+    }
+
+    EXPECT_EQ(restored.externalize(), pt.externalize());
+    for (Addr vaddr : {Addr(0x10000), Addr(0x11000), LargeSize,
+                       LargeSize + 5 * PageSize}) {
+        const EmulationPageTable::Entry *entry = pt.lookup(vaddr);
+        const EmulationPageTable::Entry *other = restored.lookup(vaddr);
+        ASSERT_NE(entry, nullptr);
+        ASSERT_NE(other, nullptr);
+        EXPECT_EQ(other->paddr, entry->paddr);
+        EXPECT_EQ(other->flags, entry->flags);
+        EXPECT_EQ(other->size(), entry->size());
+    }
+    EXPECT_EQ(restored.lookup(LargeSize + 4 * PageSize), nullptr);
+}
+
+/** Checkpoints from before large pages only hold base pages. */
+TEST_F(PageTableSerializationFixture, UnserializeWithoutPageSize)
+{
+    simulateSerialization("\n[Section1.ptable]\nsize=1\n"
+        "\n[Section1.ptable.Entry0]\nvaddr=4096\npaddr=8192\nflags=0\n");
+
+    TestPageTable pt;
+    CheckpointIn cpt(getDirName());
+    {
+        Serializable::ScopedCheckpointSection scs(cpt, "Section1");
+        pt.unserialize(cpt);
+    }
+
+    const EmulationPageTable::Entry *entry = pt.lookup(0x1000);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->size(), PageSize);
+    EXPECT_EQ(translated(pt, 0x1abc), 0x2abc);
+    EXPECT_EQ(pt.lookup(0x2000), nullptr);
+}
@@ -40,8 +40,11 @@
 
 #include "mem/ruby/common/DataBlock.hh"
 
+#include <cstring>
+
 #include "mem/ruby/common/WriteMask.hh"
 #include "mem/ruby/system/RubySystem.hh"
+#include "sim/byteswap.hh"
 
 namespace gem5
 {
@@ -49,25 +52,29 @@ namespace gem5
 namespace ruby
 {
 
-DataBlock::DataBlock(const DataBlock &cp)
+namespace
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
-    memcpy(m_data, cp.m_data, RubySystem::getBlockSizeBytes());
-    m_alloc = true;
-}
 
-void
-DataBlock::alloc()
+/**
+ * Expand the eight bits of a byte-granular write mask into a 64-bit lane
+ * mask that has byte i set to 0xff iff bit i of the mask is set.
+ */
+inline uint64_t
+spreadByteMask(uint64_t bits)
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
-    m_alloc = true;
-    clear();
+    bits = (bits | (bits << 28)) & 0x0000000F0000000FULL;
+    bits = (bits | (bits << 14)) & 0x0003000300030003ULL;
+    bits = (bits | (bits << 7)) & 0x0101010101010101ULL;
+    // Byte i of the lane mask must cover byte i of the line in memory.
+    return htole(bits * 0xFF);
 }
 
+} // anonymous namespace
+
 void
 DataBlock::clear()
 {
-    memset(m_data, 0, RubySystem::getBlockSizeBytes());
+    memset(m_data, 0, sizeof(m_data));
 }
 
 bool
@@ -79,8 +86,29 @@ DataBlock::equal(const DataBlock& obj) const
 void
 DataBlock::copyPartial(const DataBlock &dblk, const WriteMask &mask)
 {
-    for (int i = 0; i < RubySystem::getBlockSizeBytes(); i++) {
-        if (mask.getMask(i, 1)) {
+    const int size = RubySystem::getBlockSizeBytes();
+    if (mask.isFull()) {
+        memcpy(m_data, dblk.m_data, size);
+        return;
+    }
+
+    // Merge eight bytes at a time with a select on the expanded mask.
+    // The loop has no data dependent branches on the bytes themselves,
+    // so it is vectorized by the compiler where the target allows.
+    const int lanes = size / sizeof(uint64_t);
+    for (int i = 0; i < lanes; i++) {
+        uint64_t bits = (mask.getMaskWord(i / 8) >> (8 * (i % 8))) & 0xff;
+        if (!bits)
+            continue;
+        uint64_t sel = spreadByteMask(bits);
+        uint64_t dst, src;
+        memcpy(&dst, &m_data[i * sizeof(uint64_t)], sizeof(uint64_t));
+        memcpy(&src, &dblk.m_data[i * sizeof(uint64_t)], sizeof(uint64_t));
+        dst = (dst & ~sel) | (src & sel);
+        memcpy(&m_data[i * sizeof(uint64_t)], &dst, sizeof(uint64_t));
+    }
+    for (int i = lanes * sizeof(uint64_t); i < size; i++) {
+        if (mask.test(i)) {
             m_data[i] = dblk.m_data[i];
         }
     }
@@ -134,12 +162,5 @@ DataBlock::setData(PacketPtr pkt)
     pkt->writeData(&m_data[offset]);
 }
 
-DataBlock &
-DataBlock::operator=(const DataBlock & obj)
-{
-    memcpy(m_data, obj.m_data, RubySystem::getBlockSizeBytes());
-    return *this;
-}
-
 } // namespace ruby
 } // namespace gem5
@@ -57,25 +57,25 @@ namespace ruby
 
 class WriteMask;
 
+/**
+ * The data of one cache line. The storage is kept inline, sized for the
+ * largest block size the build supports (MAX_BLOCK_SIZE_BYTES), so that
+ * creating and copying the blocks carried by every data message does not
+ * go through the heap. Only the first RubySystem::getBlockSizeBytes()
+ * bytes are meaningful; the rest stays zero.
+ */
 class DataBlock
 {
   public:
-    DataBlock()
-    {
-        alloc();
-    }
+    static constexpr int maxBlockSizeBytes = MAX_BLOCK_SIZE_BYTES;
 
-    DataBlock(const DataBlock &cp);
-
-    ~DataBlock()
+    DataBlock()
     {
-        if (m_alloc)
-            delete [] m_data;
+        clear();
     }
 
-    DataBlock& operator=(const DataBlock& obj);
-
-    void assign(uint8_t *data);
+    DataBlock(const DataBlock &cp) = default;
+    DataBlock& operator=(const DataBlock& obj) = default;
 
     void clear();
     uint8_t getByte(int whichByte) const;
@@ -91,21 +91,14 @@ class DataBlock
     void print(std::ostream& out) const;
 
   private:
-    void alloc();
-    uint8_t *m_data;
-    bool m_alloc;
-};
+    static_assert(maxBlockSizeBytes % sizeof(uint64_t) == 0,
+                  "MAX_BLOCK_SIZE_BYTES must be a multiple of 8");
 
-inline void
-DataBlock::assign(uint8_t *data)
-{
-    assert(data != NULL);
-    if (m_alloc) {
-        delete [] m_data;
-    }
-    m_data = data;
-    m_alloc = false;
-}
+    // Word aligned so the masked merge can work on 64-bit lanes. Any
+    // stricter alignment would not survive the message pools, which hand
+    // out plain operator new storage.
+    alignas(uint64_t) uint8_t m_data[maxBlockSizeBytes];
+};
 
 inline uint8_t
 DataBlock::getByte(int whichByte) const
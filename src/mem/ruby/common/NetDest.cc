@@ -30,6 +30,8 @@
 
 #include <algorithm>
 
+#include "base/bitfield.hh"
+
 namespace gem5
 {
 
@@ -38,22 +40,22 @@ namespace ruby
 
 NetDest::NetDest()
 {
-  resize();
+    clear();
 }
 
 void
 NetDest::add(MachineID newElement)
 {
-    assert(bitIndex(newElement.num) < m_bits[vecIndex(newElement)].getSize());
-    m_bits[vecIndex(newElement)].add(bitIndex(newElement.num));
+    assert(newElement.num < MachineType_base_count(newElement.type));
+    int index = bitIndex(newElement);
+    m_bits[index / bitsPerWord] |= 1ULL << (index % bitsPerWord);
 }
 
 void
 NetDest::addNetDest(const NetDest& netDest)
 {
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].addSet(netDest.m_bits[i]);
+    for (int i = 0; i < numWords; i++) {
+        m_bits[i] |= netDest.m_bits[i];
     }
 }
 
@@ -63,30 +65,34 @@ NetDest::setNetDest(MachineType machine, const Set& set)
     // assure that there is only one set of destinations for this machine
     assert(MachineType_base_level((MachineType)(machine + 1)) -
            MachineType_base_level(machine) == 1);
-    m_bits[MachineType_base_level(machine)] = set;
+    for (NodeID i = 0; i < MachineType_base_count(machine); i++) {
+        MachineID mach = {machine, i};
+        if (set.isElement(i))
+            add(mach);
+        else
+            remove(mach);
+    }
 }
 
 void
 NetDest::remove(MachineID oldElement)
 {
-    m_bits[vecIndex(oldElement)].remove(bitIndex(oldElement.num));
+    int index = bitIndex(oldElement);
+    m_bits[index / bitsPerWord] &= ~(1ULL << (index % bitsPerWord));
 }
 
 void
 NetDest::removeNetDest(const NetDest& netDest)
 {
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].removeSet(netDest.m_bits[i]);
+    for (int i = 0; i < numWords; i++) {
+        m_bits[i] &= ~netDest.m_bits[i];
     }
 }
 
 void
 NetDest::clear()
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].clear();
-    }
+    m_bits.fill(0);
 }
 
 void
@@ -107,19 +113,27 @@ NetDest::broadcast(MachineType machineType)
     }
 }
 
+int
+NetDest::findNext(int index) const
+{
+    for (int i = index / bitsPerWord; i < numWords; i++) {
+        uint64_t bits = m_bits[i];
+        if (i == index / bitsPerWord)
+            bits &= ~mask(index % bitsPerWord);
+        if (bits)
+            return i * bitsPerWord + ctz64(bits);
+    }
+    return maxNodes;
+}
+
 //For Princeton Network
 std::vector<NodeID>
 NetDest::getAllDest()
 {
     std::vector<NodeID> dest;
-    dest.clear();
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                int id = MachineType_base_number((MachineType)i) + j;
-                dest.push_back((NodeID)id);
-            }
-        }
+    dest.reserve(count());
+    for (int id = findNext(0); id < maxNodes; id = findNext(id + 1)) {
+        dest.push_back((NodeID)id);
     }
     return dest;
 }
@@ -128,8 +142,8 @@ int
 NetDest::count() const
 {
     int counter = 0;
-    for (int i = 0; i < m_bits.size(); i++) {
-        counter += m_bits[i].count();
+    for (int i = 0; i < numWords; i++) {
+        counter += popCount(m_bits[i]);
     }
     return counter;
 }
@@ -137,17 +151,23 @@ NetDest::count() const
 NodeID
 NetDest::elementAt(MachineID index)
 {
-    return m_bits[vecIndex(index)].elementAt(bitIndex(index.num));
+    return test(bitIndex(index));
 }
 
 MachineID
 NetDest::smallestElement() const
 {
     assert(count() > 0);
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (NodeID j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                MachineID mach = {MachineType_from_base_level(i), j};
+    int id = findNext(0);
+    if (id < maxNodes) {
+        // Global ids are assigned in base level order, so the type of
+        // the node is the last one that starts at or before it.
+        for (int i = MachineType_base_level(MachineType_NUM) - 1;
+             i >= 0; i--) {
+            MachineType machine = MachineType_from_base_level(i);
+            int base = MachineType_base_number(machine);
+            if (base <= id && id < base + MachineType_base_count(machine)) {
+                MachineID mach = {machine, (NodeID)(id - base)};
                 return mach;
             }
         }
@@ -158,12 +178,11 @@ NetDest::smallestElement() const
 MachineID
 NetDest::smallestElement(MachineType machine) const
 {
-    int size = m_bits[MachineType_base_level(machine)].getSize();
-    for (NodeID j = 0; j < size; j++) {
-        if (m_bits[MachineType_base_level(machine)].isElement(j)) {
-            MachineID mach = {machine, j};
-            return mach;
-        }
+    int base = MachineType_base_number(machine);
+    int id = findNext(base);
+    if (id < base + MachineType_base_count(machine)) {
+        MachineID mach = {machine, (NodeID)(id - base)};
+        return mach;
     }
 
     panic("No smallest element of given MachineType.");
@@ -173,20 +192,15 @@ NetDest::smallestElement(MachineType machine) const
 bool
 NetDest::isBroadcast() const
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isBroadcast()) {
-            return false;
-        }
-    }
-    return true;
+    return count() == MachineType_base_number(MachineType_NUM);
 }
 
 // Returns true iff no bits are set
 bool
 NetDest::isEmpty() const
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isEmpty()) {
+    for (int i = 0; i < numWords; i++) {
+        if (m_bits[i]) {
             return false;
         }
     }
@@ -197,10 +211,9 @@ NetDest::isEmpty() const
 NetDest
 NetDest::OR(const NetDest& orNetDest) const
 {
-    assert(m_bits.size() == orNetDest.getSize());
     NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].OR(orNetDest.m_bits[i]);
+    for (int i = 0; i < numWords; i++) {
+        result.m_bits[i] = m_bits[i] | orNetDest.m_bits[i];
     }
     return result;
 }
@@ -209,10 +222,9 @@ NetDest::OR(const NetDest& orNetDest) const
 NetDest
 NetDest::AND(const NetDest& andNetDest) const
 {
-    assert(m_bits.size() == andNetDest.getSize());
     NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].AND(andNetDest.m_bits[i]);
+    for (int i = 0; i < numWords; i++) {
+        result.m_bits[i] = m_bits[i] & andNetDest.m_bits[i];
     }
     return result;
 }
@@ -221,22 +233,26 @@ NetDest::AND(const NetDest& andNetDest) const
 bool
 NetDest::intersectionIsNotEmpty(const NetDest& other_netDest) const
 {
-    assert(m_bits.size() == other_netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].intersectionIsEmpty(other_netDest.m_bits[i])) {
+    for (int i = 0; i < numWords; i++) {
+        if (m_bits[i] & other_netDest.m_bits[i]) {
             return true;
         }
     }
     return false;
 }
 
+// Returns true if the intersection of the two sets is empty
 bool
-NetDest::isSuperset(const NetDest& test) const
+NetDest::intersectionIsEmpty(const NetDest& other_netDest) const
 {
-    assert(m_bits.size() == test.getSize());
+    return !intersectionIsNotEmpty(other_netDest);
+}
 
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isSuperset(test.m_bits[i])) {
+bool
+NetDest::isSuperset(const NetDest& test) const
+{
+    for (int i = 0; i < numWords; i++) {
+        if (test.m_bits[i] & ~m_bits[i]) {
             return false;
         }
     }
@@ -246,28 +262,25 @@ NetDest::isSuperset(const NetDest& test) const
 bool
 NetDest::isElement(MachineID element) const
 {
-    return ((m_bits[vecIndex(element)])).isElement(bitIndex(element.num));
+    return test(bitIndex(element));
 }
 
 void
 NetDest::resize()
 {
-    m_bits.resize(MachineType_base_level(MachineType_NUM));
-    assert(m_bits.size() == MachineType_NUM);
-
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].setSize(MachineType_base_count((MachineType)i));
-    }
+    clear();
 }
 
 void
 NetDest::print(std::ostream& out) const
 {
-    out << "[NetDest (" << m_bits.size() << ") ";
+    out << "[NetDest (" << MachineType_base_level(MachineType_NUM) << ") ";
 
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            out << (bool) m_bits[i].isElement(j) << " ";
+    for (int i = 0; i < MachineType_base_level(MachineType_NUM); i++) {
+        MachineType machine = MachineType_from_base_level(i);
+        int base = MachineType_base_number(machine);
+        for (int j = 0; j < MachineType_base_count(machine); j++) {
+            out << test(base + j) << " ";
         }
         out << " - ";
     }
@@ -277,12 +290,7 @@ NetDest::print(std::ostream& out) const
 bool
 NetDest::isEqual(const NetDest& n) const
 {
-    assert(m_bits.size() == n.m_bits.size());
-    for (unsigned int i = 0; i < m_bits.size(); ++i) {
-        if (!m_bits[i].isEqual(n.m_bits[i]))
-            return false;
-    }
-    return true;
+    return m_bits == n.m_bits;
 }
 
 } // namespace ruby
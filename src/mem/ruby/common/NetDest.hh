@@ -29,6 +29,8 @@
 #ifndef __MEM_RUBY_COMMON_NETDEST_HH__
 #define __MEM_RUBY_COMMON_NETDEST_HH__
 
+#include <array>
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -42,6 +44,13 @@ namespace ruby
 {
 
 // NetDest specifies the network destination of a Message
+//
+// The destinations are kept in one flat bit vector indexed by the global
+// node id of each machine (MachineType_base_number(type) + num), the
+// same numbering the networks use. Set operations are done a 64-bit word
+// at a time and counting uses popcount, instead of walking one Set per
+// MachineType. As the global ids are only stable once all controllers
+// have been constructed, a NetDest must not be populated before that.
 class NetDest
 {
   public:
@@ -90,8 +99,11 @@ class NetDest
     MachineID smallestElement() const;
     MachineID smallestElement(MachineType machine) const;
 
+    // The layout does not depend on the number of controllers, so this
+    // only empties the set.
     void resize();
-    int getSize() const { return m_bits.size(); }
+    // Number of nodes that can be represented
+    static constexpr int getSize() { return maxNodes; }
 
     // get element for a index
     NodeID elementAt(MachineID index);
@@ -99,19 +111,29 @@ class NetDest
     void print(std::ostream& out) const;
 
   private:
-    // returns a value >= MachineType_base_level("this machine")
-    // and < MachineType_base_level("next highest machine")
-    int
-    vecIndex(MachineID m) const
+    static constexpr int bitsPerWord = 64;
+    static constexpr int maxNodes = MachineType_NUM * NUMBER_BITS_PER_SET;
+    static constexpr int numWords = (maxNodes + bitsPerWord - 1) / bitsPerWord;
+
+    // returns the global node id of m, i.e. its position in m_bits
+    static int
+    bitIndex(MachineID m)
+    {
+        int index = MachineType_base_number(m.type) + m.num;
+        assert(index < maxNodes);
+        return index;
+    }
+
+    bool
+    test(int index) const
     {
-        int vec_index = MachineType_base_level(m.type);
-        assert(vec_index < m_bits.size());
-        return vec_index;
+        return (m_bits[index / bitsPerWord] >> (index % bitsPerWord)) & 1;
     }
 
-    NodeID bitIndex(NodeID index) const { return index; }
+    // index of the first node at or after index, or maxNodes if none
+    int findNext(int index) const;
 
-    std::vector<Set> m_bits;  // a vector of bit vectors - i.e. Sets
+    std::array<uint64_t, numWords> m_bits;
 };
 
 inline std::ostream&
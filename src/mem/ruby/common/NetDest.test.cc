@@ -0,0 +1,279 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "mem/ruby/common/NetDest.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+// The machine counts normally come from the generated protocol code.
+// Give every type a different count, some of them zero, so that the
+// global ids of a type straddle the 64 bit words of the set.
+
+int
+MachineType_base_count(const MachineType& obj)
+{
+    return (7 * obj + 3) % 23;
+}
+
+int
+MachineType_base_level(const MachineType& obj)
+{
+    return obj;
+}
+
+MachineType
+MachineType_from_base_level(int level)
+{
+    return MachineType(level);
+}
+
+int
+MachineType_base_number(const MachineType& obj)
+{
+    int base = 0;
+    for (int i = 0; i < obj; i++)
+        base += MachineType_base_count(MachineType(i));
+    return base;
+}
+
+MachineType&
+operator++(MachineType& e)
+{
+    assert(e < MachineType_NUM);
+    return e = MachineType(e + 1);
+}
+
+} // namespace ruby
+} // namespace gem5
+
+namespace
+{
+
+const int numNodes = MachineType_base_number(MachineType_NUM);
+
+MachineID
+machineOf(int id)
+{
+    for (int t = 0; t < MachineType_NUM; t++) {
+        MachineType type = MachineType(t);
+        int base = MachineType_base_number(type);
+        if (id < base + MachineType_base_count(type))
+            return MachineID(type, id - base);
+    }
+    assert(false);
+    return MachineID();
+}
+
+/** The global id of a machine, compared instead of the MachineID. */
+int
+idOf(MachineID machine)
+{
+    return MachineType_base_number(machine.type) + machine.num;
+}
+
+class NetDestTest : public ::testing::Test
+{
+  protected:
+    std::mt19937 rng{1};
+
+    int
+    rand(int max)
+    {
+        return std::uniform_int_distribution<int>(0, max)(rng);
+    }
+
+    /** Apply the same random adds and removes to a set and a reference. */
+    void
+    randomize(NetDest &dest, std::vector<bool> &ref)
+    {
+        // Mostly sparse sets, but also nearly full ones
+        const int density = rand(3);
+        for (int n = 0; n < numNodes; n++) {
+            int id = rand(numNodes - 1);
+            if (rand(3) < density) {
+                dest.add(machineOf(id));
+                ref[id] = true;
+            } else {
+                dest.remove(machineOf(id));
+                ref[id] = false;
+            }
+        }
+    }
+
+    /** Every query of a set agrees with the per node reference. */
+    void
+    check(NetDest &dest, const std::vector<bool> &ref)
+    {
+        int count = 0;
+        std::vector<NodeID> all;
+        for (int id = 0; id < numNodes; id++) {
+            ASSERT_EQ(dest.isElement(machineOf(id)), ref[id]) << id;
+            if (ref[id]) {
+                count++;
+                all.push_back(id);
+            }
+        }
+        ASSERT_EQ(dest.count(), count);
+        ASSERT_EQ(dest.isEmpty(), count == 0);
+        ASSERT_EQ(dest.isBroadcast(), count == numNodes);
+        ASSERT_EQ(dest.getAllDest(), all);
+        if (count) {
+            ASSERT_EQ(idOf(dest.smallestElement()), all.front());
+        }
+
+        for (int t = 0; t < MachineType_NUM; t++) {
+            MachineType type = MachineType(t);
+            int base = MachineType_base_number(type);
+            for (int i = 0; i < MachineType_base_count(type); i++) {
+                if (ref[base + i]) {
+                    ASSERT_EQ(idOf(dest.smallestElement(type)), base + i);
+                    break;
+                }
+            }
+        }
+    }
+};
+
+} // anonymous namespace
+
+/** The ids used by the test cross more than one word of the set. */
+TEST_F(NetDestTest, LayoutSpansWords)
+{
+    ASSERT_GT(numNodes, 128);
+    ASSERT_LE(numNodes, NetDest::getSize());
+}
+
+/** Adding and removing nodes matches a per node reference. */
+TEST_F(NetDestTest, AddRemoveMatchesReference)
+{
+    for (int iter = 0; iter < 1000; iter++) {
+        NetDest dest;
+        std::vector<bool> ref(numNodes, false);
+        randomize(dest, ref);
+        check(dest, ref);
+    }
+}
+
+/** Broadcasting sets exactly the nodes of the machine types. */
+TEST_F(NetDestTest, Broadcast)
+{
+    NetDest all;
+    all.broadcast();
+    check(all, std::vector<bool>(numNodes, true));
+
+    for (int t = 0; t < MachineType_NUM; t++) {
+        MachineType type = MachineType(t);
+        NetDest dest;
+        std::vector<bool> ref(numNodes, false);
+        dest.broadcast(type);
+        int base = MachineType_base_number(type);
+        for (int i = 0; i < MachineType_base_count(type); i++)
+            ref[base + i] = true;
+        check(dest, ref);
+    }
+}
+
+/** setNetDest replaces the nodes of one type and leaves the others. */
+TEST_F(NetDestTest, SetNetDest)
+{
+    for (int iter = 0; iter < 1000; iter++) {
+        NetDest dest;
+        std::vector<bool> ref(numNodes, false);
+        randomize(dest, ref);
+
+        MachineType type = MachineType(rand(MachineType_NUM - 1));
+        int base = MachineType_base_number(type);
+        Set set(MachineType_base_count(type));
+        for (int i = 0; i < MachineType_base_count(type); i++) {
+            bool in = rand(1);
+            if (in)
+                set.add(i);
+            ref[base + i] = in;
+        }
+        dest.setNetDest(type, set);
+        check(dest, ref);
+    }
+}
+
+/** The operations on two sets match the per node operations. */
+TEST_F(NetDestTest, TwoSetOperations)
+{
+    for (int iter = 0; iter < 1000; iter++) {
+        NetDest a, b;
+        std::vector<bool> ref_a(numNodes, false), ref_b(numNodes, false);
+        randomize(a, ref_a);
+        randomize(b, ref_b);
+        if (iter % 10 == 0) {
+            b = a;
+            ref_b = ref_a;
+        }
+
+        bool overlap = false, superset = true;
+        for (int id = 0; id < numNodes; id++) {
+            overlap |= ref_a[id] && ref_b[id];
+            superset &= ref_a[id] || !ref_b[id];
+        }
+        ASSERT_EQ(a.intersectionIsNotEmpty(b), overlap);
+        ASSERT_EQ(a.intersectionIsEmpty(b), !overlap);
+        ASSERT_EQ(a.isSuperset(b), superset);
+        ASSERT_EQ(b.isSubset(a), superset);
+        ASSERT_EQ(a.isEqual(b), ref_a == ref_b);
+
+        std::vector<bool> ref(numNodes);
+        for (int id = 0; id < numNodes; id++)
+            ref[id] = ref_a[id] || ref_b[id];
+        NetDest or_dest = a.OR(b);
+        check(or_dest, ref);
+        NetDest added = a;
+        added.addNetDest(b);
+        check(added, ref);
+
+        for (int id = 0; id < numNodes; id++)
+            ref[id] = ref_a[id] && ref_b[id];
+        NetDest and_dest = a.AND(b);
+        check(and_dest, ref);
+
+        for (int id = 0; id < numNodes; id++)
+            ref[id] = ref_a[id] && !ref_b[id];
+        NetDest removed = a;
+        removed.removeNetDest(b);
+        check(removed, ref);
+    }
+}
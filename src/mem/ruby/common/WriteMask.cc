@@ -39,16 +39,17 @@ namespace ruby
 {
 
 WriteMask::WriteMask()
-    : mSize(RubySystem::getBlockSizeBytes()), mMask(mSize, false),
-      mAtomic(false)
-{}
+    : mSize(RubySystem::getBlockSizeBytes()), mMask{}, mAtomic(false)
+{
+    assert(mSize <= maxWords * bitsPerWord);
+}
 
 void
 WriteMask::print(std::ostream& out) const
 {
     std::string str(mSize,'0');
     for (int i = 0; i < mSize; i++) {
-        str[i] = mMask[i] ? ('1') : ('0');
+        str[i] = test(i) ? ('1') : ('0');
     }
     out << "dirty mask="
         << str
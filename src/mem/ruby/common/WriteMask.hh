@@ -41,12 +41,15 @@
 #ifndef __MEM_RUBY_COMMON_WRITEMASK_HH__
 #define __MEM_RUBY_COMMON_WRITEMASK_HH__
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <iomanip>
 #include <iostream>
 #include <vector>
 
 #include "base/amo.hh"
+#include "base/bitfield.hh"
 #include "mem/ruby/common/DataBlock.hh"
 #include "mem/ruby/common/TypeDefines.hh"
 
@@ -56,24 +59,40 @@ namespace gem5
 namespace ruby
 {
 
+/**
+ * Per byte write/valid mask of a cache line. The bits are packed into
+ * 64-bit words (bit i of word w covers byte 64 * w + i) so that the mask
+ * algebra is done a word at a time and counting and searching use the
+ * popcount/ctz instructions. Bits at and beyond mSize are always zero.
+ */
 class WriteMask
 {
   public:
     typedef std::vector<std::pair<int, AtomicOpFunctor* >> AtomicOpVector;
 
+    static constexpr int bitsPerWord = 64;
+    static constexpr int maxWords =
+        (DataBlock::maxBlockSizeBytes + bitsPerWord - 1) / bitsPerWord;
+
     WriteMask();
 
     WriteMask(int size)
-      : mSize(size), mMask(size, false), mAtomic(false)
-    {}
+      : mSize(size), mMask{}, mAtomic(false)
+    {
+        assert(mSize <= maxWords * bitsPerWord);
+    }
 
     WriteMask(int size, std::vector<bool> & mask)
-      : mSize(size), mMask(mask), mAtomic(false)
-    {}
+      : mSize(size), mMask{}, mAtomic(false)
+    {
+        setFromVector(mask);
+    }
 
     WriteMask(int size, std::vector<bool> &mask, AtomicOpVector atomicOp)
-      : mSize(size), mMask(mask), mAtomic(true), mAtomicOp(atomicOp)
-    {}
+      : mSize(size), mMask{}, mAtomic(true), mAtomicOp(atomicOp)
+    {
+        setFromVector(mask);
+    }
 
     ~WriteMask()
     {}
@@ -81,75 +100,89 @@ class WriteMask
     void
     clear()
     {
-        mMask = std::vector<bool>(mSize, false);
+        mMask.fill(0);
     }
 
     bool
     test(int offset) const
     {
         assert(offset < mSize);
-        return mMask[offset];
+        return (mMask[offset / bitsPerWord] >> (offset % bitsPerWord)) & 1;
     }
 
     void
     setMask(int offset, int len, bool val = true)
     {
         assert(mSize >= (offset + len));
-        for (int i = 0; i < len; i++) {
-            mMask[offset + i] = val;
+        for (int w = offset / bitsPerWord; w < numWords(); w++) {
+            uint64_t bits = rangeBits(w, offset, offset + len);
+            if (!bits)
+                break;
+            if (val)
+                mMask[w] |= bits;
+            else
+                mMask[w] &= ~bits;
         }
     }
     void
     fillMask()
     {
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = true;
+        for (int w = 0; w < numWords(); w++) {
+            mMask[w] = rangeBits(w, 0, mSize);
         }
     }
 
     bool
     getMask(int offset, int len) const
     {
-        bool tmp = true;
         assert(mSize >= (offset + len));
-        for (int i = 0; i < len; i++) {
-            tmp = tmp & mMask.at(offset + i);
+        for (int w = offset / bitsPerWord; w < numWords(); w++) {
+            uint64_t bits = rangeBits(w, offset, offset + len);
+            if (!bits)
+                break;
+            if ((mMask[w] & bits) != bits)
+                return false;
         }
-        return tmp;
+        return true;
+    }
+
+    /**
+     * The 64 mask bits that cover bytes [64 * word, 64 * word + 64).
+     */
+    uint64_t
+    getMaskWord(int word) const
+    {
+        assert(word < maxWords);
+        return mMask[word];
     }
 
     bool
     isOverlap(const WriteMask &readMask) const
     {
-        bool tmp = false;
         assert(mSize == readMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            if (readMask.mMask.at(i)) {
-                tmp = tmp | mMask.at(i);
-            }
+        for (int w = 0; w < numWords(); w++) {
+            if (mMask[w] & readMask.mMask[w])
+                return true;
         }
-        return tmp;
+        return false;
     }
 
     bool
     containsMask(const WriteMask &readMask) const
     {
-        bool tmp = true;
         assert(mSize == readMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            if (readMask.mMask.at(i)) {
-                tmp = tmp & mMask.at(i);
-            }
+        for (int w = 0; w < numWords(); w++) {
+            if (readMask.mMask[w] & ~mMask[w])
+                return false;
         }
-        return tmp;
+        return true;
     }
 
     bool isEmpty() const
     {
-        for (int i = 0; i < mSize; i++) {
-            if (mMask.at(i)) {
+        for (int w = 0; w < numWords(); w++) {
+            if (mMask[w])
                 return false;
-            }
         }
         return true;
     }
@@ -157,10 +190,9 @@ class WriteMask
     bool
     isFull() const
     {
-        for (int i = 0; i < mSize; i++) {
-            if (!mMask.at(i)) {
+        for (int w = 0; w < numWords(); w++) {
+            if (mMask[w] != rangeBits(w, 0, mSize))
                 return false;
-            }
         }
         return true;
     }
@@ -169,8 +201,8 @@ class WriteMask
     andMask(const WriteMask & writeMask)
     {
         assert(mSize == writeMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = (mMask.at(i)) & (writeMask.mMask.at(i));
+        for (int w = 0; w < numWords(); w++) {
+            mMask[w] &= writeMask.mMask[w];
         }
 
         if (writeMask.mAtomic) {
@@ -183,8 +215,8 @@ class WriteMask
     orMask(const WriteMask & writeMask)
     {
         assert(mSize == writeMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = (mMask.at(i)) | (writeMask.mMask.at(i));
+        for (int w = 0; w < numWords(); w++) {
+            mMask[w] |= writeMask.mMask[w];
         }
 
         if (writeMask.mAtomic) {
@@ -197,17 +229,20 @@ class WriteMask
     setInvertedMask(const WriteMask & writeMask)
     {
         assert(mSize == writeMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = !writeMask.mMask.at(i);
+        for (int w = 0; w < numWords(); w++) {
+            mMask[w] = ~writeMask.mMask[w] & rangeBits(w, 0, mSize);
         }
     }
 
     int
     firstBitSet(bool val, int offset = 0) const
     {
-        for (int i = offset; i < mSize; ++i)
-            if (mMask[i] == val)
-                return i;
+        for (int w = offset / bitsPerWord; w < numWords(); w++) {
+            uint64_t bits = val ? mMask[w] : ~mMask[w];
+            bits &= rangeBits(w, offset, mSize);
+            if (bits)
+                return w * bitsPerWord + ctz64(bits);
+        }
         return mSize;
     }
 
@@ -215,8 +250,9 @@ class WriteMask
     count(int offset = 0) const
     {
         int count = 0;
-        for (int i = offset; i < mSize; ++i)
-            count += mMask[i];
+        for (int w = offset / bitsPerWord; w < numWords(); w++) {
+            count += popCount(mMask[w] & rangeBits(w, offset, mSize));
+        }
         return count;
     }
 
@@ -257,8 +293,34 @@ class WriteMask
     }
 
   private:
+    int numWords() const { return (mSize + bitsPerWord - 1) / bitsPerWord; }
+
+    /**
+     * The bits of word w that fall in the byte range [lo, hi).
+     */
+    static uint64_t
+    rangeBits(int w, int lo, int hi)
+    {
+        int first = std::max(lo - w * bitsPerWord, 0);
+        int last = std::min(hi - w * bitsPerWord, bitsPerWord);
+        if (first >= last)
+            return 0;
+        return mask(last - first) << first;
+    }
+
+    void
+    setFromVector(const std::vector<bool> &mask)
+    {
+        assert(mSize <= maxWords * bitsPerWord);
+        assert(mask.size() >= mSize);
+        for (int i = 0; i < mSize; i++) {
+            if (mask[i])
+                mMask[i / bitsPerWord] |= 1ULL << (i % bitsPerWord);
+        }
+    }
+
     int mSize;
-    std::vector<bool> mMask;
+    std::array<uint64_t, maxWords> mMask;
     bool mAtomic;
     AtomicOpVector mAtomicOp;
 };
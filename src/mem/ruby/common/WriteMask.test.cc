@@ -0,0 +1,254 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "mem/ruby/common/DataBlock.hh"
+#include "mem/ruby/common/WriteMask.hh"
+#include "mem/ruby/system/RubySystem.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+// The block size is only read through RubySystem, so define its state
+// here instead of building a whole RubySystem.
+bool RubySystem::m_randomization;
+uint32_t RubySystem::m_block_size_bytes = DataBlock::maxBlockSizeBytes;
+uint32_t RubySystem::m_block_size_bits;
+uint32_t RubySystem::m_memory_size_bits;
+
+namespace
+{
+
+const int maxSize = WriteMask::maxWords * WriteMask::bitsPerWord;
+
+class WriteMaskTest : public ::testing::Test
+{
+  protected:
+    std::mt19937 rng{1};
+
+    int
+    rand(int max)
+    {
+        return std::uniform_int_distribution<int>(0, max)(rng);
+    }
+
+    /**
+     * A position in [0, limit], half of the time next to a multiple of
+     * eight so that the 8 byte lanes and the 64 bit words are straddled.
+     */
+    int
+    point(int limit)
+    {
+        if (rand(1))
+            return rand(limit);
+        int p = 8 * rand(limit / 8) + rand(2) - 1;
+        return std::min(std::max(p, 0), limit);
+    }
+
+    /** Apply the same random setMask calls to a mask and its reference. */
+    void
+    randomize(WriteMask &mask, std::vector<bool> &ref, int size)
+    {
+        for (int n = rand(4); n >= 0; n--) {
+            int offset = point(size);
+            int len = point(size - offset);
+            bool val = rand(3);
+            mask.setMask(offset, len, val);
+            std::fill(ref.begin() + offset, ref.begin() + offset + len, val);
+        }
+    }
+
+    /** Every query of a mask agrees with the per byte reference. */
+    void
+    check(const WriteMask &mask, const std::vector<bool> &ref, int size)
+    {
+        for (int i = 0; i < size; i++) {
+            ASSERT_EQ(mask.test(i), ref[i]) << "byte " << i;
+        }
+        for (int w = 0; w < WriteMask::maxWords; w++) {
+            uint64_t word = 0;
+            for (int i = 0; i < WriteMask::bitsPerWord; i++) {
+                int byte = w * WriteMask::bitsPerWord + i;
+                if (byte < size && ref[byte])
+                    word |= 1ULL << i;
+            }
+            ASSERT_EQ(mask.getMaskWord(w), word) << "word " << w;
+        }
+
+        bool empty = true, full = true;
+        for (int i = 0; i < size; i++) {
+            empty &= !ref[i];
+            full &= ref[i];
+        }
+        ASSERT_EQ(mask.isEmpty(), empty);
+        ASSERT_EQ(mask.isFull(), full);
+
+        for (int n = 0; n < 8; n++) {
+            int offset = point(size);
+            int len = point(size - offset);
+            bool all = std::all_of(ref.begin() + offset,
+                                   ref.begin() + offset + len,
+                                   [](bool b) { return b; });
+            ASSERT_EQ(mask.getMask(offset, len), all)
+                << "offset " << offset << " len " << len;
+
+            int ones = std::count(ref.begin() + offset,
+                                  ref.begin() + size, true);
+            ASSERT_EQ(mask.count(offset), ones) << "offset " << offset;
+
+            for (bool val : {true, false}) {
+                int first = std::find(ref.begin() + offset,
+                                      ref.begin() + size, val) - ref.begin();
+                ASSERT_EQ(mask.firstBitSet(val, offset), first)
+                    << "offset " << offset << " val " << val;
+            }
+        }
+    }
+};
+
+} // anonymous namespace
+
+/** setMask over random ranges matches a per byte reference. */
+TEST_F(WriteMaskTest, SetMaskMatchesReference)
+{
+    for (int iter = 0; iter < 5000; iter++) {
+        const int size = 1 + rand(maxSize - 1);
+        WriteMask mask(size);
+        std::vector<bool> ref(size, false);
+        randomize(mask, ref, size);
+        check(mask, ref, size);
+    }
+}
+
+/** Ranges that end exactly on and just around the word boundaries. */
+TEST_F(WriteMaskTest, WordBoundaries)
+{
+    const int size = maxSize;
+    for (int w = 0; w <= WriteMask::maxWords; w++) {
+        for (int d : {-1, 0, 1}) {
+            int edge = w * WriteMask::bitsPerWord + d;
+            if (edge < 0 || edge > size)
+                continue;
+            for (int len : {1, 7, 8, 9, 63, 64, 65}) {
+                for (int offset : {edge, edge - len}) {
+                    if (offset < 0 || offset + len > size)
+                        continue;
+                    WriteMask mask(size);
+                    std::vector<bool> ref(size, false);
+                    mask.setMask(offset, len);
+                    std::fill(ref.begin() + offset,
+                              ref.begin() + offset + len, true);
+                    check(mask, ref, size);
+
+                    mask.fillMask();
+                    std::fill(ref.begin(), ref.end(), true);
+                    mask.setMask(offset, len, false);
+                    std::fill(ref.begin() + offset,
+                              ref.begin() + offset + len, false);
+                    check(mask, ref, size);
+                }
+            }
+        }
+    }
+}
+
+/** The operations on two masks match the per byte operations. */
+TEST_F(WriteMaskTest, TwoMaskOperations)
+{
+    for (int iter = 0; iter < 5000; iter++) {
+        const int size = 1 + rand(maxSize - 1);
+        WriteMask a(size), b(size);
+        std::vector<bool> ref_a(size, false), ref_b(size, false);
+        randomize(a, ref_a, size);
+        randomize(b, ref_b, size);
+
+        bool overlap = false, contains = true;
+        for (int i = 0; i < size; i++) {
+            overlap |= ref_a[i] && ref_b[i];
+            contains &= ref_a[i] || !ref_b[i];
+        }
+        ASSERT_EQ(a.isOverlap(b), overlap);
+        ASSERT_EQ(a.containsMask(b), contains);
+
+        std::vector<bool> ref(size);
+        WriteMask and_mask = a;
+        and_mask.andMask(b);
+        for (int i = 0; i < size; i++)
+            ref[i] = ref_a[i] && ref_b[i];
+        check(and_mask, ref, size);
+
+        WriteMask or_mask = a;
+        or_mask.orMask(b);
+        for (int i = 0; i < size; i++)
+            ref[i] = ref_a[i] || ref_b[i];
+        check(or_mask, ref, size);
+
+        WriteMask inverted(size);
+        inverted.setInvertedMask(a);
+        for (int i = 0; i < size; i++)
+            ref[i] = !ref_a[i];
+        check(inverted, ref, size);
+    }
+}
+
+/** copyPartial only takes the masked bytes, as a byte loop would. */
+TEST_F(WriteMaskTest, CopyPartialMatchesReference)
+{
+    const int size = RubySystem::getBlockSizeBytes();
+    for (int iter = 0; iter < 5000; iter++) {
+        DataBlock dst, src;
+        for (int i = 0; i < size; i++) {
+            dst.setByte(i, rand(255));
+            src.setByte(i, rand(255));
+        }
+        WriteMask mask(size);
+        std::vector<bool> ref(size, false);
+        // Also cover the full and the empty mask
+        if (iter % 100 == 0) {
+            mask.fillMask();
+            std::fill(ref.begin(), ref.end(), true);
+        } else if (iter % 100 != 1) {
+            randomize(mask, ref, size);
+        }
+
+        DataBlock expected = dst;
+        for (int i = 0; i < size; i++) {
+            if (ref[i])
+                expected.setByte(i, src.getByte(i));
+        }
+        dst.copyPartial(src, mask);
+        for (int i = 0; i < size; i++) {
+            ASSERT_EQ(dst.getByte(i), expected.getByte(i)) << "byte " << i;
+        }
+    }
+}
@@ -48,6 +48,7 @@
 #include "base/stl_helpers.hh"
 #include "debug/RubyQueue.hh"
 #include "mem/ruby/system/RubySystem.hh"
+#include "sim/eventq.hh"
 
 namespace gem5
 {
@@ -216,19 +217,18 @@ random_time()
 void
 MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
 {
-    // record current time incase we have a pop that also adjusts my size
-    if (m_time_last_time_enqueue < current_time) {
-        m_msgs_this_cycle = 0;  // first msg this cycle
-        m_time_last_time_enqueue = current_time;
-    }
-
-    m_msg_counter++;
-    m_msgs_this_cycle++;
-
     // Calculate the arrival time of the message, that is, the first
     // cycle the message can be dequeued.
     panic_if((delta == 0) && !m_allow_zero_latency,
            "Delta equals zero and allow_zero_latency is false during enqueue");
+
+    assert(m_consumer != NULL);
+    if (inParallelMode &&
+        m_consumer->getObject()->eventQueue() != curEventQueue()) {
+        handoff(message, current_time, delta);
+        return;
+    }
+
     Tick arrival_time = 0;
 
     // random delays are inserted if the RubySystem level randomization flag
@@ -266,7 +266,7 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
         m_last_arrival_time = arrival_time;
     }
 
-    // compute the delay cycles and set enqueue time
+    // compute the delay cycles
     Message* msg_ptr = message.get();
     assert(msg_ptr != NULL);
 
@@ -274,6 +274,24 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
            "ensure we aren't dequeued early");
 
     msg_ptr->updateDelayedTicks(current_time);
+
+    insert(message, current_time, arrival_time);
+}
+
+void
+MessageBuffer::insert(MsgPtr message, Tick current_time, Tick arrival_time)
+{
+    // record current time incase we have a pop that also adjusts my size
+    if (m_time_last_time_enqueue < current_time) {
+        m_msgs_this_cycle = 0;  // first msg this cycle
+        m_time_last_time_enqueue = current_time;
+    }
+
+    m_msg_counter++;
+    m_msgs_this_cycle++;
+
+    // set enqueue time
+    Message* msg_ptr = message.get();
     msg_ptr->setLastEnqueueTime(arrival_time);
     msg_ptr->setMsgCounter(m_msg_counter);
 
@@ -295,6 +313,59 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
     m_consumer->storeEventInfo(m_vnet_id);
 }
 
+void
+MessageBuffer::handoff(MsgPtr message, Tick current_time, Tick delta)
+{
+    // The consumer runs on another thread, so nothing of this buffer may be
+    // touched here. The message is carried by an event scheduled on the
+    // consumer's queue, which inserts it from there. Such events must be
+    // at least a quantum away, as the other queue may be that far ahead.
+    panic_if(m_max_size != 0, "%s: a buffer crossing event queues must be "
+             "unbounded", name());
+
+    Tick arrival_time = std::max(current_time + delta,
+                                 curTick() + simQuantum);
+
+    assert(current_time >= message->getLastEnqueueTime() &&
+           "ensure we aren't dequeued early");
+    message->updateDelayedTicks(current_time);
+
+    DPRINTF(RubyQueue, "Handing off to %s, arrival_time: %lld, "
+            "Message: %s\n", m_consumer->getObject()->eventQueue()->name(),
+            arrival_time, *message);
+
+    // The producer doesn't keep the message once enqueued and the consumer
+    // only takes it out of the handoff list under the same lock, so the
+    // reference count is never updated by both threads at once.
+    std::list<MsgPtr>::iterator pending;
+    {
+        std::lock_guard<UncontendedMutex> lock(m_handoff_lock);
+        pending = m_handoff_msgs.insert(m_handoff_msgs.end(),
+                                        std::move(message));
+    }
+
+    auto *event = new EventFunctionWrapper([this, pending]() {
+            MsgPtr message;
+            {
+                std::lock_guard<UncontendedMutex> lock(m_handoff_lock);
+                message = std::move(*pending);
+                m_handoff_msgs.erase(pending);
+            }
+
+            Tick arrival = curTick();
+            if (m_strict_fifo) {
+                // Keep the order with messages enqueued by the consumer's
+                // own thread
+                arrival = std::max(arrival, m_last_arrival_time);
+            }
+            if (!RubySystem::getWarmupEnabled()) {
+                m_last_arrival_time = arrival;
+            }
+            insert(message, curTick(), arrival);
+        }, name() + ".handoff", true);
+    m_consumer->getObject()->eventQueue()->schedule(event, arrival_time);
+}
+
 Tick
 MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
 {
@@ -544,13 +615,9 @@ MessageBuffer::functionalAccess(Packet *pkt, bool is_read, WriteMask *mask)
     // Check the priority heap and write any messages that may
     // correspond to the address in the packet.
     for (unsigned int i = 0; i < m_prio_heap.size(); ++i) {
-        Message *msg = m_prio_heap[i].get();
-        if (is_read && !mask && msg->functionalRead(pkt))
+        if (functionalAccess(m_prio_heap[i].get(), pkt, is_read, mask,
+                             num_functional_accesses))
             return 1;
-        else if (is_read && mask && msg->functionalRead(pkt, *mask))
-            num_functional_accesses++;
-        else if (!is_read && msg->functionalWrite(pkt))
-            num_functional_accesses++;
     }
 
     // Check the stall queue and write any messages that may
@@ -562,18 +629,37 @@ MessageBuffer::functionalAccess(Packet *pkt, bool is_read, WriteMask *mask)
         for (std::list<MsgPtr>::iterator it = (map_iter->second).begin();
             it != (map_iter->second).end(); ++it) {
 
-            Message *msg = (*it).get();
-            if (is_read && !mask && msg->functionalRead(pkt))
+            if (functionalAccess((*it).get(), pkt, is_read, mask,
+                                 num_functional_accesses))
                 return 1;
-            else if (is_read && mask && msg->functionalRead(pkt, *mask))
-                num_functional_accesses++;
-            else if (!is_read && msg->functionalWrite(pkt))
-                num_functional_accesses++;
         }
     }
 
+    // Check the messages still being handed off from another event queue
+    std::lock_guard<UncontendedMutex> lock(m_handoff_lock);
+    for (auto &msg : m_handoff_msgs) {
+        if (functionalAccess(msg.get(), pkt, is_read, mask,
+                             num_functional_accesses))
+            return 1;
+    }
+
     return num_functional_accesses;
 }
 
+bool
+MessageBuffer::functionalAccess(Message *msg, Packet *pkt, bool is_read,
+                                WriteMask *mask,
+                                uint32_t &num_functional_accesses)
+{
+    // Returns true only for a plain read, which a single message satisfies
+    if (is_read && !mask && msg->functionalRead(pkt))
+        return true;
+    else if (is_read && mask && msg->functionalRead(pkt, *mask))
+        num_functional_accesses++;
+    else if (!is_read && msg->functionalWrite(pkt))
+        num_functional_accesses++;
+    return false;
+}
+
 } // namespace ruby
 } // namespace gem5
@@ -50,11 +50,14 @@
 #include <cassert>
 #include <functional>
 #include <iostream>
+#include <list>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "base/trace.hh"
+#include "base/uncontended_mutex.hh"
 #include "debug/RubyQueue.hh"
 #include "mem/packet.hh"
 #include "mem/port.hh"
@@ -195,8 +198,23 @@ class MessageBuffer : public SimObject
   private:
     void reanalyzeList(std::list<MsgPtr> &, Tick);
 
+    // Puts a message in the heap, from the consumer's thread
+    void insert(MsgPtr message, Tick current_time, Tick arrival_time);
+
+    /**
+     * Enqueue from a thread other than the one of the consumer's event
+     * queue. The message is inserted by an event on the consumer's queue,
+     * no earlier than a simulation quantum from now.
+     */
+    void handoff(MsgPtr message, Tick current_time, Tick delta);
+
     uint32_t functionalAccess(Packet *pkt, bool is_read, WriteMask *mask);
 
+    /** Check a message for a functional access, see functionalAccess */
+    static bool functionalAccess(Message *msg, Packet *pkt, bool is_read,
+                                 WriteMask *mask,
+                                 uint32_t &num_functional_accesses);
+
   private:
     // Data Members (m_ prefix)
     //! Consumer to signal a wakeup(), can be NULL
@@ -224,6 +242,15 @@ class MessageBuffer : public SimObject
      */
     StallMsgMapType m_stall_msg_map;
 
+    /**
+     * Messages handed off from another event queue, waiting for the event
+     * that inserts them into m_prio_heap. They are kept here rather than in
+     * the events so that functional accesses can reach them.
+     */
+    std::list<MsgPtr> m_handoff_msgs;
+    /** Protects m_handoff_msgs, which the producer's thread appends to */
+    mutable UncontendedMutex m_handoff_lock;
+
     /**
      * A map from line addresses to corresponding vectors of messages that
      * are deferred for enqueueing. Messages in this map are waiting to be
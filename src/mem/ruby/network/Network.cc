@@ -42,6 +42,7 @@
 
 #include "base/logging.hh"
 #include "mem/ruby/common/MachineID.hh"
+#include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/network/BasicLink.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
@@ -67,6 +68,11 @@ Network::Network(const Params &p)
 
     params().ruby_system->registerNetwork(this);
 
+    fatal_if(MachineType_base_number(MachineType_NUM) > NetDest::getSize(),
+             "%s: %d controllers do not fit in a NetDest of %d nodes. "
+             "Increase NUMBER_BITS_PER_SET and recompile.\n", name(),
+             MachineType_base_number(MachineType_NUM), NetDest::getSize());
+
     // Populate localNodeVersions with the version of each MachineType in
     // this network. This will be used to compute a global to local ID.
     // Do this by looking at the ext_node for each ext_link. There is one
@@ -0,0 +1,377 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/network/analytical/AnalyticalNetwork.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "debug/RubyNetwork.hh"
+#include "mem/ruby/network/BasicLink.hh"
+#include "mem/ruby/network/BasicRouter.hh"
+#include "mem/ruby/network/MessageBuffer.hh"
+#include "mem/ruby/slicc_interface/AbstractController.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+AnalyticalNetwork::AnalyticalNetwork(const Params &p)
+    : Network(p), Consumer(this),
+      m_model_contention(p.model_contention),
+      m_next_node(0), m_blocked(false),
+      networkStats(this, m_virtual_networks)
+{
+    m_router_links.resize(p.routers.size());
+    m_router_latency.resize(p.routers.size());
+    for (auto router : p.routers) {
+        int id = router->params().router_id;
+        fatal_if(id < 0 || id >= p.routers.size(),
+                 "%s: router id %d out of range", name(), id);
+        m_router_latency[id] = cyclesToTicks(router->params().latency);
+    }
+
+    m_machines.resize(m_nodes);
+    m_local_nodes.resize(m_nodes);
+    for (auto link : p.ext_links) {
+        AbstractController *cntrl = link->params().ext_node;
+        MachineID machine = cntrl->getMachineID();
+        NodeID global_id = MachineType_base_number(machine.getType()) +
+            machine.getNum();
+        NodeID local_id = getLocalNodeID(global_id);
+        m_machines[local_id] = machine;
+        m_local_nodes[local_id] = cntrl->eventQueue() == eventQueue();
+    }
+
+    m_inject_links.resize(m_nodes,
+                          std::vector<int>(m_virtual_networks, -1));
+    m_routes.resize(m_nodes * m_nodes * m_virtual_networks);
+    m_last_arrival.resize(m_nodes * m_virtual_networks, 0);
+}
+
+void
+AnalyticalNetwork::init()
+{
+    Network::init();
+
+    // The topology pointer should have already been initialized in
+    // the parent class network constructor.
+    assert(m_topology_ptr != NULL);
+    m_topology_ptr->createLinks(this);
+
+    for (NodeID node = 0; node < m_nodes; node++) {
+        for (auto buffer : m_toNetQueues[node]) {
+            if (buffer != nullptr)
+                buffer->setConsumer(this);
+        }
+
+        // A message that found its destination queue full is retried
+        // once a message leaves any destination queue. The queues of
+        // controllers on other event queues are unbounded.
+        if (!m_local_nodes[node])
+            continue;
+        for (auto buffer : m_fromNetQueues[node]) {
+            if (buffer != nullptr) {
+                buffer->registerDequeueCallback([this]() {
+                    if (m_blocked)
+                        scheduleEventAbsolute(clockEdge(Cycles(1)));
+                });
+            }
+        }
+    }
+}
+
+int
+AnalyticalNetwork::addLink(BasicLink *link, int dst_router,
+                           const std::vector<NetDest>& routing_table_entry)
+{
+    fatal_if(link->m_bandwidth_factor <= 0,
+             "%s: link %s needs a positive bandwidth factor",
+             name(), link->name());
+
+    Link new_link;
+    new_link.latency = cyclesToTicks(link->m_latency);
+    new_link.bandwidth = link->m_bandwidth_factor;
+    new_link.weight = link->m_weight;
+    new_link.dstRouter = dst_router;
+    new_link.routing = routing_table_entry;
+    new_link.routing.resize(m_virtual_networks);
+    new_link.busyUntil = 0;
+
+    m_links.push_back(new_link);
+    return m_links.size() - 1;
+}
+
+// From a switch to an endpoint node
+void
+AnalyticalNetwork::makeExtOutLink(SwitchID src, NodeID global_dest,
+                                  BasicLink* link,
+                                  std::vector<NetDest>& routing_table_entry)
+{
+    assert(src < m_router_links.size());
+    m_router_links[src].push_back(addLink(link, -1, routing_table_entry));
+}
+
+// From an endpoint node to a switch
+void
+AnalyticalNetwork::makeExtInLink(NodeID global_src, SwitchID dest,
+                                 BasicLink* link,
+                                 std::vector<NetDest>& routing_table_entry)
+{
+    NodeID local_src = getLocalNodeID(global_src);
+    assert(local_src < m_nodes);
+
+    int id = addLink(link, dest, routing_table_entry);
+    for (int vnet = 0; vnet < m_virtual_networks; vnet++) {
+        if (link->mVnets.empty() ||
+            std::find(link->mVnets.begin(), link->mVnets.end(), vnet) !=
+            link->mVnets.end()) {
+            m_inject_links[local_src][vnet] = id;
+        }
+    }
+}
+
+// From a switch to a switch
+void
+AnalyticalNetwork::makeInternalLink(SwitchID src, SwitchID dest,
+                                    BasicLink* link,
+                                    std::vector<NetDest>& routing_table_entry,
+                                    PortDirection src_outport,
+                                    PortDirection dst_inport)
+{
+    assert(src < m_router_links.size());
+    m_router_links[src].push_back(addLink(link, dest, routing_table_entry));
+}
+
+AnalyticalNetwork::Route &
+AnalyticalNetwork::getRoute(NodeID src, NodeID dest, int vnet)
+{
+    Route &route = m_routes[(src * m_nodes + dest) * m_virtual_networks +
+                            vnet];
+    if (route.valid)
+        return route;
+
+    int link = m_inject_links[src][vnet];
+    fatal_if(link == -1, "%s: node %d has no link for vnet %d",
+             name(), src, vnet);
+    route.links.push_back(link);
+
+    // Follow the routing tables built by the topology, taking the
+    // lightest of the links on a shortest path to the destination at
+    // every router, as the weight based routing of the simple network.
+    const MachineID &machine = m_machines[dest];
+    int hops = 0;
+    for (int router = m_links[link].dstRouter; router != -1;
+         router = m_links[link].dstRouter) {
+        fatal_if(++hops > m_router_links.size(),
+                 "%s: routing loop from node %d to node %d on vnet %d",
+                 name(), src, dest, vnet);
+
+        link = -1;
+        for (int candidate : m_router_links[router]) {
+            const Link &l = m_links[candidate];
+            if (l.routing[vnet].isElement(machine) &&
+                (link == -1 || l.weight < m_links[link].weight)) {
+                link = candidate;
+            }
+        }
+        fatal_if(link == -1, "%s: no route from node %d to node %d on "
+                 "vnet %d", name(), src, dest, vnet);
+        route.links.push_back(link);
+    }
+
+    route.valid = true;
+    return route;
+}
+
+void
+AnalyticalNetwork::wakeup()
+{
+    m_blocked = false;
+
+    for (int i = 0; i < m_nodes; i++) {
+        NodeID node = (m_next_node + i) % m_nodes;
+        const std::vector<MessageBuffer *> &queues = m_toNetQueues[node];
+        for (int vnet = 0; vnet < queues.size(); vnet++) {
+            MessageBuffer *buffer = queues[vnet];
+            if (buffer == nullptr)
+                continue;
+            while (buffer->isReady(clockEdge())) {
+                if (!send(node, vnet, buffer)) {
+                    m_blocked = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    m_next_node = (m_next_node + 1) % m_nodes;
+}
+
+bool
+AnalyticalNetwork::send(NodeID src, int vnet, MessageBuffer *buffer)
+{
+    MsgPtr msg_ptr = buffer->peekMsgPtr();
+    std::vector<NodeID> destinations =
+        msg_ptr->getDestination().getAllDest();
+
+    // A message only leaves its source queue once all its destination
+    // queues have room for it.
+    for (auto &dest : destinations) {
+        dest = getLocalNodeID(dest);
+        MessageBuffer *out = vnet < m_fromNetQueues[dest].size() ?
+            m_fromNetQueues[dest][vnet] : nullptr;
+        fatal_if(out == nullptr, "%s: node %d has no queue for vnet %d",
+                 name(), dest, vnet);
+        if (!out->areNSlotsAvailable(1, curTick())) {
+            networkStats.flowControlStalls++;
+            return false;
+        }
+    }
+
+    buffer->dequeue(clockEdge());
+
+    int size = MessageSizeType_to_int(msg_ptr->getMessageSize());
+    for (int i = 0; i < destinations.size(); i++) {
+        NodeID dest = destinations[i];
+        // Every destination gets its own copy, the original goes to the
+        // last one once all copies have been made.
+        MsgPtr out_msg = i == destinations.size() - 1 ?
+            msg_ptr : msg_ptr->clone();
+        NetDest &out_dest = out_msg->getDestination();
+        out_dest.clear();
+        out_dest.add(m_machines[dest]);
+        deliver(src, dest, vnet, out_msg, size);
+    }
+
+    return true;
+}
+
+void
+AnalyticalNetwork::deliver(NodeID src, NodeID dest, int vnet,
+                           const MsgPtr &msg, int size)
+{
+    Route &route = getRoute(src, dest, vnet);
+    const Tick now = clockEdge();
+
+    // The head of the message crosses every link and router on its
+    // route, waiting on the links still busy with earlier messages. The
+    // tail follows as fast as the slowest link on the route lets it.
+    Tick time = now;
+    Tick serialization = 0;
+    Tick queueing = 0;
+    for (int i = 0; i < route.links.size(); i++) {
+        Link &link = m_links[route.links[i]];
+        if (i > 0)
+            time += m_router_latency[m_links[route.links[i - 1]].dstRouter];
+
+        Tick link_serialization = divCeil(size * clockPeriod(),
+                                          link.bandwidth);
+        if (m_model_contention) {
+            Tick start = std::max(time, link.busyUntil);
+            queueing += start - time;
+            time = start;
+            link.busyUntil = start + link_serialization;
+        }
+        serialization = std::max(serialization, link_serialization);
+        time += link.latency;
+    }
+
+    Tick arrival = clockEdge(std::max(Cycles(1),
+                                      ticksToCycles(time + serialization -
+                                                    now)));
+
+    // Without contention, or with a faster link behind a slow one, a
+    // short message could overtake a long one sent before it on the
+    // same route. Keep them in order, as a real network would.
+    arrival = std::max(arrival, route.lastArrival);
+    route.lastArrival = arrival;
+
+    // Messages from different sources may overtake each other, which an
+    // ordered queue does not allow.
+    MessageBuffer *out = m_fromNetQueues[dest][vnet];
+    if (out->getOrdered()) {
+        Tick &last_arrival = m_last_arrival[dest * m_virtual_networks + vnet];
+        arrival = std::max(arrival, last_arrival);
+        last_arrival = arrival;
+    }
+
+    DPRINTF(RubyNetwork, "Node %d to node %d vnet %d: %d hops, queued %d "
+            "ticks, arriving at %d: %s\n", src, dest, vnet,
+            route.links.size(), queueing, arrival, *msg);
+
+    out->enqueue(msg, now, arrival - now);
+
+    networkStats.msgCount[vnet]++;
+    networkStats.totalLatency += arrival - now;
+    networkStats.queueingLatency += queueing;
+    networkStats.totalHops += route.links.size();
+}
+
+void
+AnalyticalNetwork::print(std::ostream& out) const
+{
+    out << "[AnalyticalNetwork]";
+}
+
+AnalyticalNetwork::
+NetworkStats::NetworkStats(statistics::Group *parent, int vnets)
+    : statistics::Group(parent),
+      ADD_STAT(msgCount, statistics::units::Count::get(),
+               "Number of messages delivered per vnet"),
+      ADD_STAT(totalLatency, statistics::units::Tick::get(),
+               "Total network latency of the delivered messages"),
+      ADD_STAT(queueingLatency, statistics::units::Tick::get(),
+               "Total time the delivered messages waited for busy links"),
+      ADD_STAT(totalHops, statistics::units::Count::get(),
+               "Total number of links crossed by the delivered messages"),
+      ADD_STAT(flowControlStalls, statistics::units::Count::get(),
+               "Number of times a message found a destination queue full"),
+      ADD_STAT(avgLatency, statistics::units::Rate<
+                  statistics::units::Tick, statistics::units::Count>::get(),
+               "Average network latency of a message"),
+      ADD_STAT(avgQueueingLatency, statistics::units::Rate<
+                  statistics::units::Tick, statistics::units::Count>::get(),
+               "Average time a message waited for busy links"),
+      ADD_STAT(avgHops, statistics::units::Rate<
+                  statistics::units::Count, statistics::units::Count>::get(),
+               "Average number of links crossed by a message")
+{
+    msgCount.init(vnets);
+
+    avgLatency = totalLatency / sum(msgCount);
+    avgQueueingLatency = queueingLatency / sum(msgCount);
+    avgHops = totalHops / sum(msgCount);
+}
+
+} // namespace ruby
+} // namespace gem5
@@ -0,0 +1,189 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_NETWORK_ANALYTICAL_ANALYTICALNETWORK_HH__
+#define __MEM_RUBY_NETWORK_ANALYTICAL_ANALYTICALNETWORK_HH__
+
+#include <iostream>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/common/NetDest.hh"
+#include "mem/ruby/network/Network.hh"
+#include "params/AnalyticalNetwork.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+class MessageBuffer;
+
+/**
+ * A network that does not simulate routers or link buffers. A message
+ * is taken from its source queue as soon as it is ready and enqueued in
+ * the destination queue right away, with an arrival time computed from
+ * the route the topology gives it: the latency of every link and router
+ * on the way plus, when contention is modeled, the time it waits for
+ * links that are still busy serializing earlier messages.
+ *
+ * Each link only remembers until when it is busy, so the cost per
+ * message is proportional to its hop count. Messages between the same
+ * pair of nodes on the same vnet always follow the same route, and a
+ * message never arrives before the previous one on its route, so they
+ * are delivered in order even when a short message would otherwise
+ * overtake a long one.
+ * Destination queues are checked for space before a message leaves its
+ * source, which gives the protocols the same back pressure as a
+ * network with credit based flow control. Controllers simulated on
+ * another event queue must have unbounded queues.
+ */
+class AnalyticalNetwork : public Network, public Consumer
+{
+  public:
+    PARAMS(AnalyticalNetwork);
+
+    AnalyticalNetwork(const Params &p);
+    ~AnalyticalNetwork() = default;
+
+    void init() override;
+
+    void wakeup() override;
+
+    void collateStats() override {}
+    void print(std::ostream& out) const override;
+
+    // Methods used by Topology to setup the network
+    void makeExtOutLink(SwitchID src, NodeID dest, BasicLink* link,
+                        std::vector<NetDest>& routing_table_entry) override;
+    void makeExtInLink(NodeID src, SwitchID dest, BasicLink* link,
+                       std::vector<NetDest>& routing_table_entry) override;
+    void makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
+                          std::vector<NetDest>& routing_table_entry,
+                          PortDirection src_outport,
+                          PortDirection dst_inport) override;
+
+    // Messages never wait inside the network, they are either in a source
+    // or in a destination queue, which the controllers search themselves.
+    bool functionalRead(Packet *pkt) override { return false; }
+    bool
+    functionalRead(Packet *pkt, WriteMask &mask) override
+    {
+        return false;
+    }
+    uint32_t functionalWrite(Packet *pkt) override { return 0; }
+
+  private:
+    struct Link
+    {
+        Tick latency;
+        // Bytes per cycle
+        int bandwidth;
+        int weight;
+        // Router at the far end of the link, or -1 for a link ejecting
+        // into a node
+        int dstRouter;
+        // Destinations reached through this link, per vnet
+        std::vector<NetDest> routing;
+        // First tick at which the link is free to send another message
+        Tick busyUntil;
+    };
+
+    struct Route
+    {
+        bool valid = false;
+        std::vector<int> links;
+        // Arrival time of the last message sent on the route
+        Tick lastArrival = 0;
+    };
+
+    int addLink(BasicLink *link, int dst_router,
+                const std::vector<NetDest>& routing_table_entry);
+    Route &getRoute(NodeID src, NodeID dest, int vnet);
+
+    // Tries to send the message at the head of a source queue, returns
+    // false if a destination queue is full.
+    bool send(NodeID src, int vnet, MessageBuffer *buffer);
+
+    // Enqueues the message in the queue of a single destination
+    void deliver(NodeID src, NodeID dest, int vnet, const MsgPtr &msg,
+                 int size);
+
+    const bool m_model_contention;
+
+    std::vector<Link> m_links;
+    // Injection link of each node, per vnet
+    std::vector<std::vector<int>> m_inject_links;
+    // Outgoing links of each router
+    std::vector<std::vector<int>> m_router_links;
+    std::vector<Tick> m_router_latency;
+    // Route of each source, destination and vnet, computed on first use
+    std::vector<Route> m_routes;
+
+    // Machine of each node
+    std::vector<MachineID> m_machines;
+    // Whether the controller of each node is on the network's event queue
+    std::vector<bool> m_local_nodes;
+    // Arrival time of the last message of every ordered destination queue
+    std::vector<Tick> m_last_arrival;
+
+    // Round robin pointer over the source nodes
+    int m_next_node;
+    // Set while a message waits for room in a destination queue
+    bool m_blocked;
+
+    struct NetworkStats : public statistics::Group
+    {
+        NetworkStats(statistics::Group *parent, int vnets);
+
+        statistics::Vector msgCount;
+        statistics::Scalar totalLatency;
+        statistics::Scalar queueingLatency;
+        statistics::Scalar totalHops;
+        statistics::Scalar flowControlStalls;
+
+        statistics::Formula avgLatency;
+        statistics::Formula avgQueueingLatency;
+        statistics::Formula avgHops;
+    } networkStats;
+};
+
+inline std::ostream&
+operator<<(std::ostream& out, const AnalyticalNetwork& obj)
+{
+    obj.print(out);
+    out << std::flush;
+    return out;
+}
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_ANALYTICAL_ANALYTICALNETWORK_HH__
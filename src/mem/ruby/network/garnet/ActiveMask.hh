@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_NETWORK_GARNET_0_ACTIVEMASK_HH__
+#define __MEM_RUBY_NETWORK_GARNET_0_ACTIVEMASK_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "base/bitfield.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+namespace garnet
+{
+
+/*
+ * A set of small integers (port or VC ids) backed by a bitmask. The
+ * router pipeline stages use it to only visit the ports and VCs that
+ * hold flits instead of scanning all of them every cycle.
+ */
+class ActiveMask
+{
+  public:
+    ActiveMask() : m_size(0), m_count(0) {}
+
+    void
+    resize(int size)
+    {
+        m_size = size;
+        m_count = 0;
+        m_words.assign((size + 63) / 64, 0);
+    }
+
+    int size() const { return m_size; }
+    int count() const { return m_count; }
+    bool any() const { return m_count > 0; }
+
+    bool
+    test(int i) const
+    {
+        assert(i >= 0 && i < m_size);
+        return (m_words[i / 64] >> (i % 64)) & 1;
+    }
+
+    void
+    set(int i)
+    {
+        if (!test(i)) {
+            m_words[i / 64] |= (uint64_t)1 << (i % 64);
+            m_count++;
+        }
+    }
+
+    void
+    clear(int i)
+    {
+        if (test(i)) {
+            m_words[i / 64] &= ~((uint64_t)1 << (i % 64));
+            m_count--;
+        }
+    }
+
+    void
+    clearAll()
+    {
+        std::fill(m_words.begin(), m_words.end(), 0);
+        m_count = 0;
+    }
+
+    // Returns the first member greater than or equal to start, or -1
+    int
+    findNext(int start) const
+    {
+        if (start >= m_size)
+            return -1;
+
+        int word = start / 64;
+        uint64_t bits = m_words[word] & (~(uint64_t)0 << (start % 64));
+        while (bits == 0) {
+            if (++word == m_words.size())
+                return -1;
+            bits = m_words[word];
+        }
+        return word * 64 + findLsbSet(bits);
+    }
+
+    // Returns the first member in round robin order from start, i.e.,
+    // at or after start, wrapping around, or -1 if the mask is empty.
+    int
+    findNextCyclic(int start) const
+    {
+        int i = findNext(start);
+        return i != -1 ? i : findNext(0);
+    }
+
+    // Calls f on each member in round robin order, from start up to the
+    // end and then wrapping around, until f returns true. Returns
+    // whether f did. f must not modify the mask unless it returns true.
+    template <class F>
+    bool
+    forEachFrom(int start, F f) const
+    {
+        for (int i = findNext(start); i != -1; i = findNext(i + 1)) {
+            if (f(i))
+                return true;
+        }
+        for (int i = findNext(0); i != -1 && i < start; i = findNext(i + 1)) {
+            if (f(i))
+                return true;
+        }
+        return false;
+    }
+
+  private:
+    int m_size;
+    int m_count;
+    std::vector<uint64_t> m_words;
+};
+
+} // namespace garnet
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_GARNET_0_ACTIVEMASK_HH__
@@ -54,6 +54,7 @@ void
 CrossbarSwitch::init()
 {
     switchBuffers.resize(m_router->get_num_inports());
+    m_active_inports.resize(m_router->get_num_inports());
 }
 
 /*
@@ -69,7 +70,9 @@ CrossbarSwitch::wakeup()
             "at time: %lld\n",
             m_router->get_id(), m_router->curCycle());
 
-    for (auto& switch_buffer : switchBuffers) {
+    for (int inport = m_active_inports.findNext(0); inport != -1;
+         inport = m_active_inports.findNext(inport + 1)) {
+        flitBuffer &switch_buffer = switchBuffers[inport];
         if (!switch_buffer.isReady(curTick())) {
             continue;
         }
@@ -86,6 +89,8 @@ CrossbarSwitch::wakeup()
             // in the next cycle
             m_router->getOutputUnit(outport)->insert_flit(t_flit);
             switch_buffer.getTopFlit();
+            if (switch_buffer.isEmpty())
+                m_active_inports.clear(inport);
             m_crossbar_activity++;
         }
     }
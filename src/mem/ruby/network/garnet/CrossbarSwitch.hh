@@ -36,6 +36,7 @@
 #include <vector>
 
 #include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/network/garnet/ActiveMask.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
 #include "mem/ruby/network/garnet/flitBuffer.hh"
 
@@ -63,6 +64,7 @@ class CrossbarSwitch : public Consumer
     update_sw_winner(int inport, flit *t_flit)
     {
         switchBuffers[inport].insert(t_flit);
+        m_active_inports.set(inport);
     }
 
     inline double get_crossbar_activity() { return m_crossbar_activity; }
@@ -75,6 +77,8 @@ class CrossbarSwitch : public Consumer
     int m_num_vcs;
     double m_crossbar_activity;
     std::vector<flitBuffer> switchBuffers;
+    // Input ports with a flit waiting in their switch buffer
+    ActiveMask m_active_inports;
 };
 
 } // namespace garnet
@@ -121,6 +121,21 @@ GarnetNetwork::init()
     assert(m_topology_ptr != NULL);
     m_topology_ptr->createLinks(this);
 
+    // Garnet components call into each other directly, only the message
+    // buffers to the controllers may cross event queues.
+    std::vector<ClockedObject *> components;
+    components.insert(components.end(), m_routers.begin(), m_routers.end());
+    components.insert(components.end(), m_nis.begin(), m_nis.end());
+    components.insert(components.end(), m_networklinks.begin(),
+                      m_networklinks.end());
+    components.insert(components.end(), m_creditlinks.begin(),
+                      m_creditlinks.end());
+    for (auto component : components) {
+        fatal_if(component->eventQueue() != eventQueue(), "%s: %s must be "
+                 "on the event queue of the network", name(),
+                 component->name());
+    }
+
     // Initialize topology specific parameters
     if (getNumRows() > 0) {
         // Only for Mesh topology
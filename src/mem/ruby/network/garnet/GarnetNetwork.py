@@ -34,6 +34,11 @@ from m5.objects.Network import RubyNetwork
 from m5.objects.BasicRouter import BasicRouter
 from m5.objects.ClockedObject import ClockedObject
 
+# separable: input-first separable allocator with round-robin arbiters
+# wavefront: wavefront allocator with a rotating priority diagonal
+# islip: iterative input/output round-robin matching
+class GarnetSwitchAllocator(Enum): vals = ['separable', 'wavefront', 'islip']
+
 class GarnetNetwork(RubyNetwork):
     type = 'GarnetNetwork'
     cxx_header = "mem/ruby/network/garnet/GarnetNetwork.hh"
@@ -50,6 +55,10 @@ class GarnetNetwork(RubyNetwork):
     fault_model = Param.FaultModel(NULL, "network fault model");
     garnet_deadlock_threshold = Param.UInt32(50000,
                               "network-level deadlock threshold")
+    switch_allocator = Param.GarnetSwitchAllocator('separable',
+                              "switch allocator used by the routers")
+    switch_allocator_iterations = Param.UInt32(1,
+                              "number of iterations of the islip allocator")
 
 class GarnetNetworkInterface(ClockedObject):
     type = 'GarnetNetworkInterface'
@@ -74,3 +83,8 @@ class GarnetRouter(BasicRouter):
                           "number of virtual networks")
     width = Param.UInt32(Parent.ni_flit_size,
                           "bit width supported by the router")
+    switch_allocator = Param.GarnetSwitchAllocator(Parent.switch_allocator,
+                          "switch allocator")
+    switch_allocator_iterations = Param.UInt32(
+        Parent.switch_allocator_iterations,
+        "number of iterations of the islip allocator")
@@ -37,6 +37,7 @@
 
 #include "mem/ruby/common/Consumer.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
+#include "mem/ruby/network/garnet/ActiveMask.hh"
 #include "mem/ruby/network/garnet/CreditLink.hh"
 #include "mem/ruby/network/garnet/NetworkLink.hh"
 #include "mem/ruby/network/garnet/Router.hh"
@@ -116,7 +117,17 @@ class InputUnit : public Consumer
     inline flit*
     getTopFlit(int vc)
     {
-        return virtualChannels[vc].getTopFlit();
+        flit *t_flit = virtualChannels[vc].getTopFlit();
+        if (virtualChannels[vc].isEmpty())
+            m_active_vcs.clear(vc);
+        return t_flit;
+    }
+
+    // VCs currently holding at least one flit
+    inline const ActiveMask &
+    get_active_vcs() const
+    {
+        return m_active_vcs;
     }
 
     inline bool
@@ -166,6 +177,7 @@ class InputUnit : public Consumer
 
     // Input Virtual channels
     std::vector<VirtualChannel> virtualChannels;
+    ActiveMask m_active_vcs;
 
     // Statistical variables
     std::vector<double> m_num_buffer_writes;
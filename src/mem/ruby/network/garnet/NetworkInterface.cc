@@ -97,6 +97,7 @@ NetworkInterface::addOutPort(NetworkLink *out_link,
         m_vc_per_vnet = consumerVcs;
         int m_num_vcs = consumerVcs * m_virtual_networks;
         niOutVcs.resize(m_num_vcs);
+        m_active_out_vcs.resize(m_num_vcs);
         outVcState.reserve(m_num_vcs);
         m_ni_out_vcs_enqueue_time.resize(m_num_vcs);
         // instantiating the NI flit buffers
@@ -448,6 +449,7 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
             fl->set_src_delay(curTick() - msg_ptr->getTime());
             niOutVcs[vc].insert(fl);
         }
+        m_active_out_vcs.set(vc);
 
         m_ni_out_vcs_enqueue_time[vc] = curTick();
         outVcState[vc].setState(ACTIVE_, curTick());
@@ -483,61 +485,61 @@ NetworkInterface::calculateVC(int vnet)
 void
 NetworkInterface::scheduleOutputPort(OutputPort *oPort)
 {
-   int vc = oPort->vcRoundRobin();
-
-   for (int i = 0; i < niOutVcs.size(); i++) {
-       vc++;
-       if (vc == niOutVcs.size())
-           vc = 0;
+   // Round robin over the VCs holding flits, starting after the last
+   // VC that was scheduled
+   int start = oPort->vcRoundRobin() + 1;
+   if (start == niOutVcs.size())
+       start = 0;
 
+   m_active_out_vcs.forEachFrom(start, [&](int vc) {
        int t_vnet = get_vnet(vc);
-       if (oPort->isVnetSupported(t_vnet)) {
-           // model buffer backpressure
-           if (niOutVcs[vc].isReady(curTick()) &&
-               outVcState[vc].has_credit()) {
-
-               bool is_candidate_vc = true;
-               int vc_base = t_vnet * m_vc_per_vnet;
-
-               if (m_net_ptr->isVNetOrdered(t_vnet)) {
-                   for (int vc_offset = 0; vc_offset < m_vc_per_vnet;
-                        vc_offset++) {
-                       int t_vc = vc_base + vc_offset;
-                       if (niOutVcs[t_vc].isReady(curTick())) {
-                           if (m_ni_out_vcs_enqueue_time[t_vc] <
-                               m_ni_out_vcs_enqueue_time[vc]) {
-                               is_candidate_vc = false;
-                               break;
-                           }
-                       }
+       if (!oPort->isVnetSupported(t_vnet))
+           return false;
+
+       // model buffer backpressure
+       if (!niOutVcs[vc].isReady(curTick()) ||
+           !outVcState[vc].has_credit()) {
+           return false;
+       }
+
+       int vc_base = t_vnet * m_vc_per_vnet;
+
+       if (m_net_ptr->isVNetOrdered(t_vnet)) {
+           for (int vc_offset = 0; vc_offset < m_vc_per_vnet;
+                vc_offset++) {
+               int t_vc = vc_base + vc_offset;
+               if (niOutVcs[t_vc].isReady(curTick())) {
+                   if (m_ni_out_vcs_enqueue_time[t_vc] <
+                       m_ni_out_vcs_enqueue_time[vc]) {
+                       return false;
                    }
                }
-               if (!is_candidate_vc)
-                   continue;
-
-               // Update the round robin arbiter
-               oPort->vcRoundRobin(vc);
+           }
+       }
 
-               outVcState[vc].decrement_credit();
+       // Update the round robin arbiter
+       oPort->vcRoundRobin(vc);
 
-               // Just removing the top flit
-               flit *t_flit = niOutVcs[vc].getTopFlit();
-               t_flit->set_time(clockEdge(Cycles(1)));
+       outVcState[vc].decrement_credit();
 
-               // Scheduling the flit
-               scheduleFlit(t_flit);
+       // Just removing the top flit
+       flit *t_flit = niOutVcs[vc].getTopFlit();
+       if (niOutVcs[vc].isEmpty())
+           m_active_out_vcs.clear(vc);
+       t_flit->set_time(clockEdge(Cycles(1)));
 
-               if (t_flit->get_type() == TAIL_ ||
-                  t_flit->get_type() == HEAD_TAIL_) {
-                   m_ni_out_vcs_enqueue_time[vc] = Tick(INFINITE_);
-               }
+       // Scheduling the flit
+       scheduleFlit(t_flit);
 
-               // Done with this port, continue to schedule
-               // other ports
-               return;
-           }
+       if (t_flit->get_type() == TAIL_ ||
+          t_flit->get_type() == HEAD_TAIL_) {
+           m_ni_out_vcs_enqueue_time[vc] = Tick(INFINITE_);
        }
-   }
+
+       // Done with this port, continue to schedule
+       // other ports
+       return true;
+   });
 }
 
 
@@ -635,11 +637,12 @@ NetworkInterface::checkReschedule()
         }
     }
 
-    for (auto& ni_out_vc : niOutVcs) {
-        if (ni_out_vc.isReady(clockEdge(Cycles(1)))) {
-            scheduleEvent(Cycles(1));
-            return;
-        }
+    bool out_vc_ready = m_active_out_vcs.forEachFrom(0, [&](int vc) {
+        return niOutVcs[vc].isReady(clockEdge(Cycles(1)));
+    });
+    if (out_vc_ready) {
+        scheduleEvent(Cycles(1));
+        return;
     }
 
     // Check if any input links have flits to be popped.
@@ -37,6 +37,7 @@
 #include <vector>
 
 #include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/network/garnet/ActiveMask.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
 #include "mem/ruby/network/garnet/Credit.hh"
 #include "mem/ruby/network/garnet/CreditLink.hh"
@@ -284,6 +285,8 @@ class NetworkInterface : public ClockedObject, public Consumer
     // The flit buffers which will serve the Consumer
     std::vector<flitBuffer>  niOutVcs;
     std::vector<Tick> m_ni_out_vcs_enqueue_time;
+    // Output VCs holding at least one flit
+    ActiveMask m_active_out_vcs;
 
     // The Message buffers that takes messages from the protocol
     std::vector<MessageBuffer *> inNode_ptr;
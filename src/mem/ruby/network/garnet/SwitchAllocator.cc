@@ -31,6 +31,9 @@
 
 #include "mem/ruby/network/garnet/SwitchAllocator.hh"
 
+#include <algorithm>
+
+#include "base/logging.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet/GarnetNetwork.hh"
 #include "mem/ruby/network/garnet/InputUnit.hh"
@@ -46,8 +49,11 @@ namespace ruby
 namespace garnet
 {
 
-SwitchAllocator::SwitchAllocator(Router *router)
-    : Consumer(router)
+SwitchAllocator::SwitchAllocator(Router *router,
+                                 enums::GarnetSwitchAllocator policy,
+                                 int iterations)
+    : Consumer(router), m_policy(policy), m_iterations(iterations),
+      m_wavefront_priority(0)
 {
     m_router = router;
     m_num_vcs = m_router->get_num_vcs();
@@ -55,6 +61,9 @@ SwitchAllocator::SwitchAllocator(Router *router)
 
     m_input_arbiter_activity = 0;
     m_output_arbiter_activity = 0;
+
+    fatal_if(m_iterations < 1, "Router %d: the switch allocator needs at "
+             "least one iteration", m_router->get_id());
 }
 
 void
@@ -63,19 +72,33 @@ SwitchAllocator::init()
     m_num_inports = m_router->get_num_inports();
     m_num_outports = m_router->get_num_outports();
     m_round_robin_inport.resize(m_num_outports);
+    m_round_robin_outport.resize(m_num_inports);
     m_round_robin_invc.resize(m_num_inports);
-    m_port_requests.resize(m_num_inports);
     m_vc_winners.resize(m_num_inports);
+    m_matched_outport.resize(m_num_inports);
+    m_request_vc.resize(m_num_inports * m_num_outports);
 
+    m_inport_requests.resize(m_num_inports);
+    m_grants.resize(m_num_inports);
     for (int i = 0; i < m_num_inports; i++) {
         m_round_robin_invc[i] = 0;
-        m_port_requests[i] = -1;
+        m_round_robin_outport[i] = 0;
         m_vc_winners[i] = -1;
+        m_matched_outport[i] = -1;
+        m_inport_requests[i].resize(m_num_outports);
+        m_grants[i].resize(m_num_outports);
     }
 
+    m_outport_requests.resize(m_num_outports);
     for (int i = 0; i < m_num_outports; i++) {
         m_round_robin_inport[i] = 0;
+        m_outport_requests[i].resize(m_num_inports);
     }
+
+    m_requesting_inports.resize(m_num_inports);
+    m_granted_inports.resize(m_num_inports);
+    m_requested_outports.resize(m_num_outports);
+    m_matched_outports.resize(m_num_outports);
 }
 
 /*
@@ -85,13 +108,33 @@ SwitchAllocator::init()
  * There is no separate VCAllocator stage like the one in garnet1.0.
  * At the end of this function, the router is rescheduled to wakeup
  * next cycle for peforming SA for any flits ready next cycle.
+ *
+ * The wavefront and islip allocators instead build the full matrix of
+ * input port to output port requests and compute a matching on it. The
+ * winning VC of each matched input port is then granted as above.
  */
 
 void
 SwitchAllocator::wakeup()
 {
-    arbitrate_inports(); // First stage of allocation
-    arbitrate_outports(); // Second stage of allocation
+    switch (m_policy) {
+      case enums::separable:
+        arbitrate_inports(); // First stage of allocation
+        arbitrate_outports(); // Second stage of allocation
+        break;
+      case enums::wavefront:
+        build_request_matrix();
+        match_wavefront();
+        grant_matches();
+        break;
+      case enums::islip:
+        build_request_matrix();
+        match_islip();
+        grant_matches();
+        break;
+      default:
+        panic("Unknown switch allocator %d", m_policy);
+    }
 
     clear_request_vector();
     check_for_wakeup();
@@ -112,36 +155,35 @@ SwitchAllocator::arbitrate_inports()
 {
     // Select a VC from each input in a round robin manner
     // Independent arbiter at each input port
+    // Only VCs holding flits can be in SA stage, so empty VCs are skipped
     for (int inport = 0; inport < m_num_inports; inport++) {
-        int invc = m_round_robin_invc[inport];
-
-        for (int invc_iter = 0; invc_iter < m_num_vcs; invc_iter++) {
-            auto input_unit = m_router->getInputUnit(inport);
+        auto input_unit = m_router->getInputUnit(inport);
+        const ActiveMask &active_vcs = input_unit->get_active_vcs();
+        if (!active_vcs.any())
+            continue;
 
-            if (input_unit->need_stage(invc, SA_, curTick())) {
-                // This flit is in SA stage
+        active_vcs.forEachFrom(m_round_robin_invc[inport], [&](int invc) {
+            if (!input_unit->need_stage(invc, SA_, curTick()))
+                return false;
 
-                int outport = input_unit->get_outport(invc);
-                int outvc = input_unit->get_outvc(invc);
+            // This flit is in SA stage
 
-                // check if the flit in this InputVC is allowed to be sent
-                // send_allowed conditions described in that function.
-                bool make_request =
-                    send_allowed(inport, invc, outport, outvc);
+            int outport = input_unit->get_outport(invc);
+            int outvc = input_unit->get_outvc(invc);
 
-                if (make_request) {
-                    m_input_arbiter_activity++;
-                    m_port_requests[inport] = outport;
-                    m_vc_winners[inport] = invc;
+            // check if the flit in this InputVC is allowed to be sent
+            // send_allowed conditions described in that function.
+            if (!send_allowed(inport, invc, outport, outvc))
+                return false;
 
-                    break; // got one vc winner for this port
-                }
-            }
+            m_input_arbiter_activity++;
+            m_vc_winners[inport] = invc;
+            m_requesting_inports.set(inport);
+            m_outport_requests[outport].set(inport);
+            m_requested_outports.set(outport);
 
-            invc++;
-            if (invc >= m_num_vcs)
-                invc = 0;
-        }
+            return true; // got one vc winner for this port
+        });
     }
 }
 
@@ -149,6 +191,181 @@ SwitchAllocator::arbitrate_inports()
  * SA-II (or SA-o) loops through all output ports,
  * and selects one input VC (that placed a request during SA-I)
  * as the winner for this output port in a round robin manner.
+ * The requests to each output port are kept as a mask of input ports,
+ * so the winner is the first input port of the mask at or after the
+ * round robin pointer.
+ */
+
+void
+SwitchAllocator::arbitrate_outports()
+{
+    // Now there are a set of input vc requests for output vcs.
+    // Again do round robin arbitration on these requests
+    // Independent arbiter at each output port
+    // Output ports nobody asked for are skipped
+    for (int outport = m_requested_outports.findNext(0); outport != -1;
+         outport = m_requested_outports.findNext(outport + 1)) {
+        int inport = m_outport_requests[outport].findNextCyclic(
+            m_round_robin_inport[outport]);
+        assert(inport != -1);
+
+        // grant this outport to this inport
+        grant_switch(inport, m_vc_winners[inport], outport);
+
+        // Update Round Robin pointer
+        m_round_robin_inport[outport] = inport + 1;
+        if (m_round_robin_inport[outport] >= m_num_inports)
+            m_round_robin_inport[outport] = 0;
+    }
+}
+
+/*
+ * Builds the request matrix of the wavefront and islip allocators. Each
+ * input port requests every output port that one of its VCs is allowed
+ * to send to (see send_allowed). The VCs of an input port are visited in
+ * round robin order and the first one found for an output port is the
+ * one that will be granted if the input port is matched to it.
+ */
+
+void
+SwitchAllocator::build_request_matrix()
+{
+    for (int inport = 0; inport < m_num_inports; inport++) {
+        auto input_unit = m_router->getInputUnit(inport);
+        const ActiveMask &active_vcs = input_unit->get_active_vcs();
+        if (!active_vcs.any())
+            continue;
+
+        ActiveMask &requests = m_inport_requests[inport];
+        active_vcs.forEachFrom(m_round_robin_invc[inport], [&](int invc) {
+            if (!input_unit->need_stage(invc, SA_, curTick()))
+                return false;
+
+            int outport = input_unit->get_outport(invc);
+            if (requests.test(outport))
+                return false; // an earlier VC already asks for it
+
+            int outvc = input_unit->get_outvc(invc);
+            if (!send_allowed(inport, invc, outport, outvc))
+                return false;
+
+            m_input_arbiter_activity++;
+            requests.set(outport);
+            m_request_vc[inport * m_num_outports + outport] = invc;
+            m_requesting_inports.set(inport);
+            m_outport_requests[outport].set(inport);
+            m_requested_outports.set(outport);
+
+            return false;
+        });
+    }
+}
+
+/*
+ * Wavefront allocation: the cells (inport, outport) of the request
+ * matrix are visited one diagonal at a time, starting at the priority
+ * diagonal, and a request is granted if neither its input nor its output
+ * port has been matched by an earlier diagonal. The priority diagonal
+ * rotates every cycle.
+ */
+
+void
+SwitchAllocator::match_wavefront()
+{
+    if (!m_requesting_inports.any())
+        return;
+
+    int size = std::max(m_num_inports, m_num_outports);
+    for (int d = 0; d < size; d++) {
+        int diagonal = (m_wavefront_priority + d) % size;
+        for (int inport = m_requesting_inports.findNext(0); inport != -1;
+             inport = m_requesting_inports.findNext(inport + 1)) {
+            int outport = (inport + diagonal) % size;
+            if (outport >= m_num_outports ||
+                m_matched_outport[inport] != -1 ||
+                m_matched_outports.test(outport) ||
+                !m_inport_requests[inport].test(outport)) {
+                continue;
+            }
+            m_matched_outport[inport] = outport;
+            m_matched_outports.set(outport);
+        }
+    }
+
+    m_wavefront_priority = (m_wavefront_priority + 1) % size;
+}
+
+/*
+ * iSLIP allocation: every unmatched output port grants the first
+ * requesting unmatched input port from its round robin pointer, then
+ * every input port accepts the first granting output port from its own
+ * pointer. Pointers only move past accepted grants of the first
+ * iteration, which desynchronizes the arbiters. Further iterations try to
+ * match the ports left over.
+ */
+
+void
+SwitchAllocator::match_islip()
+{
+    for (int iter = 0; iter < m_iterations; iter++) {
+        // Grant
+        for (int outport = m_requested_outports.findNext(0); outport != -1;
+             outport = m_requested_outports.findNext(outport + 1)) {
+            if (m_matched_outports.test(outport))
+                continue;
+
+            m_outport_requests[outport].forEachFrom(
+                m_round_robin_inport[outport], [&](int inport) {
+                    if (m_matched_outport[inport] != -1)
+                        return false;
+                    m_grants[inport].set(outport);
+                    m_granted_inports.set(inport);
+                    return true;
+                });
+        }
+
+        if (!m_granted_inports.any())
+            break;
+
+        // Accept
+        for (int inport = m_granted_inports.findNext(0); inport != -1;
+             inport = m_granted_inports.findNext(inport + 1)) {
+            int outport = m_grants[inport].findNextCyclic(
+                m_round_robin_outport[inport]);
+            assert(outport != -1);
+
+            m_matched_outport[inport] = outport;
+            m_matched_outports.set(outport);
+            if (iter == 0) {
+                m_round_robin_inport[outport] =
+                    (inport + 1) % m_num_inports;
+                m_round_robin_outport[inport] =
+                    (outport + 1) % m_num_outports;
+            }
+            m_grants[inport].clearAll();
+        }
+        m_granted_inports.clearAll();
+    }
+}
+
+// Grant the switch to the requests matched by the wavefront or islip
+// allocators.
+void
+SwitchAllocator::grant_matches()
+{
+    for (int inport = m_requesting_inports.findNext(0); inport != -1;
+         inport = m_requesting_inports.findNext(inport + 1)) {
+        int outport = m_matched_outport[inport];
+        if (outport == -1)
+            continue;
+        grant_switch(inport,
+                     m_request_vc[inport * m_num_outports + outport],
+                     outport);
+    }
+}
+
+/*
+ * Grants an output port to the flit at the head of an input VC.
  *      - For HEAD/HEAD_TAIL flits, performs simplified outvc allocation.
  *        (i.e., select a free VC from the output port).
  *      - For BODY/TAIL flits, decrement a credit in the output vc.
@@ -160,110 +377,78 @@ SwitchAllocator::arbitrate_inports()
  */
 
 void
-SwitchAllocator::arbitrate_outports()
+SwitchAllocator::grant_switch(int inport, int invc, int outport)
 {
-    // Now there are a set of input vc requests for output vcs.
-    // Again do round robin arbitration on these requests
-    // Independent arbiter at each output port
-    for (int outport = 0; outport < m_num_outports; outport++) {
-        int inport = m_round_robin_inport[outport];
-
-        for (int inport_iter = 0; inport_iter < m_num_inports;
-                 inport_iter++) {
-
-            // inport has a request this cycle for outport
-            if (m_port_requests[inport] == outport) {
-                auto output_unit = m_router->getOutputUnit(outport);
-                auto input_unit = m_router->getInputUnit(inport);
-
-                // grant this outport to this inport
-                int invc = m_vc_winners[inport];
-
-                int outvc = input_unit->get_outvc(invc);
-                if (outvc == -1) {
-                    // VC Allocation - select any free VC from outport
-                    outvc = vc_allocate(outport, inport, invc);
-                }
-
-                // remove flit from Input VC
-                flit *t_flit = input_unit->getTopFlit(invc);
-
-                DPRINTF(RubyNetwork, "SwitchAllocator at Router %d "
-                                     "granted outvc %d at outport %d "
-                                     "to invc %d at inport %d to flit %s at "
-                                     "cycle: %lld\n",
-                        m_router->get_id(), outvc,
-                        m_router->getPortDirectionName(
-                            output_unit->get_direction()),
-                        invc,
-                        m_router->getPortDirectionName(
-                            input_unit->get_direction()),
-                            *t_flit,
-                        m_router->curCycle());
-
-
-                // Update outport field in the flit since this is
-                // used by CrossbarSwitch code to send it out of
-                // correct outport.
-                // Note: post route compute in InputUnit,
-                // outport is updated in VC, but not in flit
-                t_flit->set_outport(outport);
-
-                // set outvc (i.e., invc for next hop) in flit
-                // (This was updated in VC by vc_allocate, but not in flit)
-                t_flit->set_vc(outvc);
-
-                // decrement credit in outvc
-                output_unit->decrement_credit(outvc);
-
-                // flit ready for Switch Traversal
-                t_flit->advance_stage(ST_, curTick());
-                m_router->grant_switch(inport, t_flit);
-                m_output_arbiter_activity++;
-
-                if ((t_flit->get_type() == TAIL_) ||
-                    t_flit->get_type() == HEAD_TAIL_) {
-
-                    // This Input VC should now be empty
-                    assert(!(input_unit->isReady(invc, curTick())));
-
-                    // Free this VC
-                    input_unit->set_vc_idle(invc, curTick());
-
-                    // Send a credit back
-                    // along with the information that this VC is now idle
-                    input_unit->increment_credit(invc, true, curTick());
-                } else {
-                    // Send a credit back
-                    // but do not indicate that the VC is idle
-                    input_unit->increment_credit(invc, false, curTick());
-                }
-
-                // remove this request
-                m_port_requests[inport] = -1;
-
-                // Update Round Robin pointer
-                m_round_robin_inport[outport] = inport + 1;
-                if (m_round_robin_inport[outport] >= m_num_inports)
-                    m_round_robin_inport[outport] = 0;
-
-                // Update Round Robin pointer to the next VC
-                // We do it here to keep it fair.
-                // Only the VC which got switch traversal
-                // is updated.
-                m_round_robin_invc[inport] = invc + 1;
-                if (m_round_robin_invc[inport] >= m_num_vcs)
-                    m_round_robin_invc[inport] = 0;
-
-
-                break; // got a input winner for this outport
-            }
+    auto output_unit = m_router->getOutputUnit(outport);
+    auto input_unit = m_router->getInputUnit(inport);
 
-            inport++;
-            if (inport >= m_num_inports)
-                inport = 0;
-        }
+    int outvc = input_unit->get_outvc(invc);
+    if (outvc == -1) {
+        // VC Allocation - select any free VC from outport
+        outvc = vc_allocate(outport, inport, invc);
+    }
+
+    // remove flit from Input VC
+    flit *t_flit = input_unit->getTopFlit(invc);
+
+    DPRINTF(RubyNetwork, "SwitchAllocator at Router %d "
+                         "granted outvc %d at outport %d "
+                         "to invc %d at inport %d to flit %s at "
+                         "cycle: %lld\n",
+            m_router->get_id(), outvc,
+            m_router->getPortDirectionName(
+                output_unit->get_direction()),
+            invc,
+            m_router->getPortDirectionName(
+                input_unit->get_direction()),
+                *t_flit,
+            m_router->curCycle());
+
+
+    // Update outport field in the flit since this is
+    // used by CrossbarSwitch code to send it out of
+    // correct outport.
+    // Note: post route compute in InputUnit,
+    // outport is updated in VC, but not in flit
+    t_flit->set_outport(outport);
+
+    // set outvc (i.e., invc for next hop) in flit
+    // (This was updated in VC by vc_allocate, but not in flit)
+    t_flit->set_vc(outvc);
+
+    // decrement credit in outvc
+    output_unit->decrement_credit(outvc);
+
+    // flit ready for Switch Traversal
+    t_flit->advance_stage(ST_, curTick());
+    m_router->grant_switch(inport, t_flit);
+    m_output_arbiter_activity++;
+
+    if ((t_flit->get_type() == TAIL_) ||
+        t_flit->get_type() == HEAD_TAIL_) {
+
+        // This Input VC should now be empty
+        assert(!(input_unit->isReady(invc, curTick())));
+
+        // Free this VC
+        input_unit->set_vc_idle(invc, curTick());
+
+        // Send a credit back
+        // along with the information that this VC is now idle
+        input_unit->increment_credit(invc, true, curTick());
+    } else {
+        // Send a credit back
+        // but do not indicate that the VC is idle
+        input_unit->increment_credit(invc, false, curTick());
     }
+
+    // Update Round Robin pointer to the next VC
+    // We do it here to keep it fair.
+    // Only the VC which got switch traversal
+    // is updated.
+    m_round_robin_invc[inport] = invc + 1;
+    if (m_round_robin_invc[inport] >= m_num_vcs)
+        m_round_robin_invc[inport] = 0;
 }
 
 /*
@@ -363,11 +548,13 @@ SwitchAllocator::check_for_wakeup()
     }
 
     for (int i = 0; i < m_num_inports; i++) {
-        for (int j = 0; j < m_num_vcs; j++) {
-            if (m_router->getInputUnit(i)->need_stage(j, SA_, nextCycle)) {
-                m_router->schedule_wakeup(Cycles(1));
-                return;
-            }
+        auto input_unit = m_router->getInputUnit(i);
+        bool need_sa = input_unit->get_active_vcs().forEachFrom(0,
+            [&](int vc) { return input_unit->need_stage(vc, SA_,
+                                                        nextCycle); });
+        if (need_sa) {
+            m_router->schedule_wakeup(Cycles(1));
+            return;
         }
     }
 }
@@ -386,7 +573,18 @@ SwitchAllocator::get_vnet(int invc)
 void
 SwitchAllocator::clear_request_vector()
 {
-    std::fill(m_port_requests.begin(), m_port_requests.end(), -1);
+    for (int outport = m_requested_outports.findNext(0); outport != -1;
+         outport = m_requested_outports.findNext(outport + 1)) {
+        m_outport_requests[outport].clearAll();
+    }
+    for (int inport = m_requesting_inports.findNext(0); inport != -1;
+         inport = m_requesting_inports.findNext(inport + 1)) {
+        m_inport_requests[inport].clearAll();
+        m_matched_outport[inport] = -1;
+    }
+    m_requested_outports.clearAll();
+    m_requesting_inports.clearAll();
+    m_matched_outports.clearAll();
 }
 
 void
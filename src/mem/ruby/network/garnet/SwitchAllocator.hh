@@ -35,7 +35,9 @@
 #include <iostream>
 #include <vector>
 
+#include "enums/GarnetSwitchAllocator.hh"
 #include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/network/garnet/ActiveMask.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
 
 namespace gem5
@@ -54,7 +56,8 @@ class OutputUnit;
 class SwitchAllocator : public Consumer
 {
   public:
-    SwitchAllocator(Router *router);
+    SwitchAllocator(Router *router, enums::GarnetSwitchAllocator policy,
+                    int iterations);
     void wakeup();
     void init();
     void clear_request_vector();
@@ -63,6 +66,11 @@ class SwitchAllocator : public Consumer
     void print(std::ostream& out) const {};
     void arbitrate_inports();
     void arbitrate_outports();
+    void build_request_matrix();
+    void match_wavefront();
+    void match_islip();
+    void grant_matches();
+    void grant_switch(int inport, int invc, int outport);
     bool send_allowed(int inport, int invc, int outport, int outvc);
     int vc_allocate(int outport, int inport, int invc);
 
@@ -85,11 +93,35 @@ class SwitchAllocator : public Consumer
 
     double m_input_arbiter_activity, m_output_arbiter_activity;
 
+    const enums::GarnetSwitchAllocator m_policy;
+    // Number of iSLIP iterations per cycle
+    const int m_iterations;
+
     Router *m_router;
     std::vector<int> m_round_robin_invc;
     std::vector<int> m_round_robin_inport;
-    std::vector<int> m_port_requests;
+    // iSLIP accept pointers, one per input port
+    std::vector<int> m_round_robin_outport;
     std::vector<int> m_vc_winners;
+    // Diagonal of the request matrix served first by the wavefront
+    int m_wavefront_priority;
+
+    // Request matrix: output ports requested by each input port and
+    // input ports requesting each output port
+    std::vector<ActiveMask> m_inport_requests;
+    std::vector<ActiveMask> m_outport_requests;
+    // VC placing the request, indexed by inport * m_num_outports + outport
+    std::vector<int> m_request_vc;
+    // Input ports with at least one request
+    ActiveMask m_requesting_inports;
+    // Output ports requested by some input port
+    ActiveMask m_requested_outports;
+
+    // Matching state of the wavefront and islip allocators
+    std::vector<int> m_matched_outport;
+    ActiveMask m_matched_outports;
+    std::vector<ActiveMask> m_grants;
+    ActiveMask m_granted_inports;
 };
 
 } // namespace garnet
@@ -56,7 +56,8 @@ namespace ruby
 AbstractController::AbstractController(const Params &p)
     : ClockedObject(p), Consumer(this), m_version(p.version),
       m_clusterID(p.cluster_id),
-      m_id(p.system->getRequestorId(this)), m_is_blocking(false),
+      m_id(p.system->getRequestorId(this)), m_functional_access_id(-1),
+      m_is_blocking(false),
       m_number_of_TBEs(p.number_of_TBEs),
       m_transitions_per_cycle(p.transitions_per_cycle),
       m_buffer_size(p.buffer_size), m_recycle_latency(p.recycle_latency),
@@ -117,6 +118,16 @@ AbstractController::init()
     }
 }
 
+FunctionalAccessIndex *
+AbstractController::registerFunctionalAccessIndex()
+{
+    RubySystem *rs = params().ruby_system;
+    FunctionalAccessIndex *index = rs->getFunctionalAccessIndex();
+    if (index)
+        m_functional_access_id = rs->registerFunctionallyIndexed(this);
+    return index;
+}
+
 void
 AbstractController::resetStats()
 {
@@ -375,7 +386,7 @@ AbstractController::recvTimingResp(PacketPtr pkt)
     assert(getMemRespQueue());
     assert(pkt->isResponse());
 
-    std::shared_ptr<MemoryMsg> msg = std::make_shared<MemoryMsg>(clockEdge());
+    RefCountingPtr<MemoryMsg> msg = new MemoryMsg(clockEdge());
     (*msg).m_addr = pkt->getAddr();
     (*msg).m_Sender = m_machineID;
 
@@ -58,6 +58,7 @@
 #include "mem/ruby/common/MachineID.hh"
 #include "mem/ruby/network/MessageBuffer.hh"
 #include "mem/ruby/protocol/AccessPermission.hh"
+#include "mem/ruby/structures/FunctionalAccessIndex.hh"
 #include "mem/ruby/system/CacheRecorder.hh"
 #include "params/RubyController.hh"
 #include "sim/clocked_object.hh"
@@ -108,6 +109,7 @@ class AbstractController : public ClockedObject, public Consumer
     virtual void regStats();
 
     virtual void recordCacheTrace(int cntrl, CacheRecorder* tr) = 0;
+
     virtual Sequencer* getCPUSequencer() const = 0;
     virtual DMASequencer* getDMASequencer() const = 0;
     virtual GPUCoalescer* getGPUCoalescer() const = 0;
@@ -332,6 +334,15 @@ class AbstractController : public ClockedObject, public Consumer
         m_outTrans.erase(iter);
     }
 
+    /**
+     * Called by controllers whose access permissions only depend on
+     * their caches and TBE tables. If the Ruby system keeps a functional
+     * access index, the controller is registered with it and the index
+     * is returned so that the caller can hook its structures to it (see
+     * m_functional_access_id). Returns nullptr otherwise.
+     */
+    FunctionalAccessIndex *registerFunctionalAccessIndex();
+
     void stallBuffer(MessageBuffer* buf, Addr addr);
     void wakeUpBuffer(MessageBuffer* buf, Addr addr);
     void wakeUpBuffers(Addr addr);
@@ -347,6 +358,9 @@ class AbstractController : public ClockedObject, public Consumer
     // RequestorID used by some components of gem5.
     const RequestorID m_id;
 
+    // Id of this controller in the functional access index, if any
+    int m_functional_access_id;
+
     Network *m_net_ptr;
     bool m_is_blocking;
     std::map<Addr, MessageBuffer*> m_block_map;
@@ -42,9 +42,10 @@
 #define __MEM_RUBY_SLICC_INTERFACE_MESSAGE_HH__
 
 #include <iostream>
-#include <memory>
 #include <stack>
 
+#include "base/object_pool.hh"
+#include "base/refcnt.hh"
 #include "mem/packet.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/common/WriteMask.hh"
@@ -57,9 +58,16 @@ namespace ruby
 {
 
 class Message;
-typedef std::shared_ptr<Message> MsgPtr;
 
-class Message
+/**
+ * Messages are reference counted intrusively. The count is not atomic:
+ * a message handed to a MessageBuffer on another event queue is only
+ * touched by the consumer after the next quantum barrier, by which time
+ * the producer has dropped its references.
+ */
+typedef RefCountingPtr<Message> MsgPtr;
+
+class Message : public RefCounted
 {
   public:
     Message(Tick curTime)
@@ -68,7 +76,29 @@ class Message
           m_DelayedTicks(0), m_msg_counter(0)
     { }
 
-    Message(const Message &other) = default;
+    // The reference count belongs to the object, not to its value, so a
+    // copy starts out unreferenced and an assignment leaves it untouched.
+    Message(const Message &other)
+        : RefCounted(),
+          m_time(other.m_time),
+          m_LastEnqueueTime(other.m_LastEnqueueTime),
+          m_DelayedTicks(other.m_DelayedTicks),
+          m_msg_counter(other.m_msg_counter),
+          incoming_link(other.incoming_link),
+          vnet(other.vnet)
+    { }
+
+    Message &
+    operator=(const Message &other)
+    {
+        m_time = other.m_time;
+        m_LastEnqueueTime = other.m_LastEnqueueTime;
+        m_DelayedTicks = other.m_DelayedTicks;
+        m_msg_counter = other.m_msg_counter;
+        incoming_link = other.incoming_link;
+        vnet = other.vnet;
+        return *this;
+    }
 
     virtual ~Message() { }
 
@@ -56,6 +56,7 @@
 #include "mem/ruby/slicc_interface/AbstractCacheEntry.hh"
 #include "mem/ruby/slicc_interface/RubySlicc_ComponentMapping.hh"
 #include "mem/ruby/structures/BankedArray.hh"
+#include "mem/ruby/structures/FunctionalAccessIndex.hh"
 #include "mem/ruby/system/CacheRecorder.hh"
 #include "params/RubyCache.hh"
 #include "sim/sim_object.hh"
@@ -110,6 +111,15 @@ class CacheMemory : public SimObject
     // Explicitly free up this address
     void deallocate(Addr address);
 
+    // Report the lines allocated in this cache to a functional access
+    // index on behalf of the controller cntrl_id
+    void
+    setFunctionalAccessIndex(FunctionalAccessIndex *index, int cntrl_id)
+    {
+        m_functional_index = index;
+        m_functional_cntrl_id = cntrl_id;
+    }
+
     // Returns with the physical address of the conflicting cache line
     Addr cacheProbe(Addr address) const;
 
@@ -163,6 +173,14 @@ class CacheMemory : public SimObject
     // convert a Address to its location in the cache
     int64_t addressToCacheSet(Addr address) const;
 
+    // Given a set and a way: returns the position of the block in the
+    // tag and entry arrays.
+    int64_t
+    getBlockIndex(int64_t cacheSet, int way) const
+    {
+        return cacheSet * m_cache_assoc + way;
+    }
+
     // Given a cache tag: returns the index of the tag in a set.
     // returns -1 if the tag is not found.
     int findTagInSet(int64_t line, Addr tag) const;
@@ -176,14 +194,22 @@ class CacheMemory : public SimObject
     // Data Members (m_prefix)
     bool m_is_instruction_only_cache;
 
-    // The first index is the # of cache lines.
-    // The second index is the the amount associativity.
-    std::unordered_map<Addr, int> m_tag_index;
-    std::vector<std::vector<AbstractCacheEntry*> > m_cache;
+    // Tag of each block, or MaxAddr if the block holds no entry. The tags
+    // of a set are contiguous, so that a lookup only searches its own set
+    // instead of going through a global hash map.
+    std::vector<Addr> m_tags;
+
+    // Entry of each block, or NULL, laid out as the tags. The index of
+    // the block of a set and a way is given by getBlockIndex().
+    std::vector<AbstractCacheEntry*> m_cache;
 
     /** We use the replacement policies from the Classic memory system. */
     replacement_policy::Base *m_replacementPolicy_ptr;
 
+    // Functional access index to keep up to date, if any
+    FunctionalAccessIndex *m_functional_index = nullptr;
+    int m_functional_cntrl_id = -1;
+
     BankedArray dataArray;
     BankedArray tagArray;
 
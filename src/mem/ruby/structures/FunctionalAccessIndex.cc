@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/structures/FunctionalAccessIndex.hh"
+
+#include <algorithm>
+#include <cassert>
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+void
+FunctionalAccessIndex::add(Addr line_addr, int cntrl_id)
+{
+    assert(line_addr == makeLineAddress(line_addr));
+    assert(cntrl_id >= 0);
+
+    std::lock_guard<UncontendedMutex> lock(m_lock);
+    auto &holders = m_lines[line_addr];
+    auto it = std::lower_bound(holders.begin(), holders.end(), cntrl_id,
+        [](const Holder &h, int id) { return h.cntrlId < id; });
+    if (it != holders.end() && it->cntrlId == cntrl_id) {
+        it->count++;
+    } else {
+        holders.insert(it, Holder{cntrl_id, 1});
+    }
+}
+
+void
+FunctionalAccessIndex::remove(Addr line_addr, int cntrl_id)
+{
+    std::lock_guard<UncontendedMutex> lock(m_lock);
+    auto line_it = m_lines.find(line_addr);
+    assert(line_it != m_lines.end());
+
+    auto &holders = line_it->second;
+    auto it = std::lower_bound(holders.begin(), holders.end(), cntrl_id,
+        [](const Holder &h, int id) { return h.cntrlId < id; });
+    assert(it != holders.end() && it->cntrlId == cntrl_id);
+
+    if (--it->count == 0) {
+        holders.erase(it);
+        if (holders.empty())
+            m_lines.erase(line_it);
+    }
+}
+
+void
+FunctionalAccessIndex::lookup(Addr line_addr,
+                              std::vector<int> &cntrl_ids) const
+{
+    std::lock_guard<UncontendedMutex> lock(m_lock);
+    auto line_it = m_lines.find(line_addr);
+    if (line_it == m_lines.end())
+        return;
+
+    for (const auto &holder : line_it->second)
+        cntrl_ids.push_back(holder.cntrlId);
+}
+
+} // namespace ruby
+} // namespace gem5
@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2025
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_STRUCTURES_FUNCTIONALACCESSINDEX_HH__
+#define __MEM_RUBY_STRUCTURES_FUNCTIONALACCESSINDEX_HH__
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "base/uncontended_mutex.hh"
+#include "mem/ruby/common/Address.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+// The FunctionalAccessIndex is a shadow directory from line addresses to
+// the controllers that currently hold some state for the line, i.e. a
+// cache entry or a TBE. It lets RubySystem service functional accesses by
+// querying only those controllers instead of asking every controller in
+// the system for its access permission.
+//
+// Controllers are identified by their position in the RubySystem list of
+// controllers, so lookups return them in the same order as a full scan.
+// The index is kept up to date by CacheMemory and TBETable; a controller
+// may hold the same line in several structures at once (e.g., a cache
+// entry and a TBE), so each holder keeps a reference count. Controllers
+// simulated by different threads update the index concurrently, so it is
+// protected by a lock.
+
+class FunctionalAccessIndex
+{
+  public:
+    // Record that a structure of controller cntrl_id now holds line_addr
+    void add(Addr line_addr, int cntrl_id);
+
+    // Record that a structure of controller cntrl_id released line_addr
+    void remove(Addr line_addr, int cntrl_id);
+
+    // Append the ids of the controllers holding line_addr to cntrl_ids,
+    // in ascending order
+    void lookup(Addr line_addr, std::vector<int> &cntrl_ids) const;
+
+    // Returns the number of lines currently tracked
+    std::size_t
+    size() const
+    {
+        std::lock_guard<UncontendedMutex> lock(m_lock);
+        return m_lines.size();
+    }
+
+  private:
+    struct Holder
+    {
+        int cntrlId;
+        int count;
+    };
+
+    // Holders of each line, sorted by controller id. Lines are seldom
+    // held by more than a handful of controllers, so a vector is both
+    // smaller and faster than a map.
+    std::unordered_map<Addr, std::vector<Holder>> m_lines;
+
+    mutable UncontendedMutex m_lock;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_STRUCTURES_FUNCTIONALACCESSINDEX_HH__
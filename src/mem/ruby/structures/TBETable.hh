@@ -45,6 +45,7 @@
 #include <unordered_map>
 
 #include "mem/ruby/common/Address.hh"
+#include "mem/ruby/structures/FunctionalAccessIndex.hh"
 
 namespace gem5
 {
@@ -73,6 +74,15 @@ class TBETable
     ENTRY *getNullEntry();
     ENTRY *lookup(Addr address);
 
+    // Report the lines allocated in this table to a functional access
+    // index on behalf of the controller cntrl_id
+    void
+    setFunctionalAccessIndex(FunctionalAccessIndex *index, int cntrl_id)
+    {
+        m_functional_index = index;
+        m_functional_cntrl_id = cntrl_id;
+    }
+
     // Print cache contents
     void print(std::ostream& out) const;
 
@@ -86,6 +96,10 @@ class TBETable
 
   private:
     int m_number_of_TBEs;
+
+    // Functional access index to keep up to date, if any
+    FunctionalAccessIndex *m_functional_index = nullptr;
+    int m_functional_cntrl_id = -1;
 };
 
 template<class ENTRY>
@@ -113,6 +127,8 @@ TBETable<ENTRY>::allocate(Addr address)
     assert(!isPresent(address));
     assert(m_map.size() < m_number_of_TBEs);
     m_map[address] = ENTRY();
+    if (m_functional_index)
+        m_functional_index->add(address, m_functional_cntrl_id);
 }
 
 template<class ENTRY>
@@ -122,6 +138,8 @@ TBETable<ENTRY>::deallocate(Addr address)
     assert(isPresent(address));
     assert(m_map.size() > 0);
     m_map.erase(address);
+    if (m_functional_index)
+        m_functional_index->remove(address, m_functional_cntrl_id);
 }
 
 template<class ENTRY>
@@ -29,6 +29,11 @@
 
 #include "mem/ruby/system/CacheRecorder.hh"
 
+#include <fcntl.h>
+
+#include <algorithm>
+#include <cstdio>
+
 #include "debug/RubyCacheTrace.hh"
 #include "mem/ruby/system/RubySystem.hh"
 #include "mem/ruby/system/Sequencer.hh"
@@ -48,22 +53,25 @@ TraceRecord::print(std::ostream& out) const
 }
 
 CacheRecorder::CacheRecorder()
-    : m_uncompressed_trace(NULL),
+    : m_trace(NULL),
       m_uncompressed_trace_size(0),
+      m_chunk_offset(0), m_bytes_read(0), m_records_read(0),
+      m_records_flushed(0),
       m_block_size_bytes(RubySystem::getBlockSizeBytes())
 {
 }
 
-CacheRecorder::CacheRecorder(uint8_t* uncompressed_trace,
+CacheRecorder::CacheRecorder(const std::string& trace_file,
                              uint64_t uncompressed_trace_size,
                              std::vector<Sequencer*>& seq_map,
                              uint64_t block_size_bytes)
-    : m_uncompressed_trace(uncompressed_trace),
+    : m_trace(NULL),
       m_uncompressed_trace_size(uncompressed_trace_size),
-      m_seq_map(seq_map),  m_bytes_read(0), m_records_read(0),
-      m_records_flushed(0), m_block_size_bytes(block_size_bytes)
+      m_chunk_offset(0), m_seq_map(seq_map),
+      m_bytes_read(0), m_records_read(0), m_records_flushed(0),
+      m_block_size_bytes(block_size_bytes)
 {
-    if (m_uncompressed_trace != NULL) {
+    if (!trace_file.empty()) {
         if (m_block_size_bytes < RubySystem::getBlockSizeBytes()) {
             // Block sizes larger than when the trace was recorded are not
             // supported, as we cannot reliably turn accesses to smaller blocks
@@ -71,15 +79,24 @@ CacheRecorder::CacheRecorder(uint8_t* uncompressed_trace,
             panic("Recorded cache block size (%d) < current block size (%d) !!",
                     m_block_size_bytes, RubySystem::getBlockSizeBytes());
         }
+
+        m_trace = gzopen(trace_file.c_str(), "rb");
+        if (m_trace == NULL) {
+            fatal("Unable to open trace file %s", trace_file);
+        }
     }
 }
 
 CacheRecorder::~CacheRecorder()
 {
-    if (m_uncompressed_trace != NULL) {
-        delete [] m_uncompressed_trace;
-        m_uncompressed_trace = NULL;
+    if (m_trace != NULL) {
+        gzclose(m_trace);
+        m_trace = NULL;
+    }
+    for (auto rec : m_records) {
+        free(rec);
     }
+    m_records.clear();
     m_seq_map.clear();
 }
 
@@ -105,52 +122,90 @@ CacheRecorder::enqueueNextFlushRequest()
     }
 }
 
+const TraceRecord*
+CacheRecorder::nextRecord()
+{
+    uint64_t record_size = sizeof(TraceRecord) + m_block_size_bytes;
+    if (m_bytes_read + record_size > m_uncompressed_trace_size) {
+        if (m_trace != NULL) {
+            if (gzclose(m_trace)) {
+                fatal("Failed to close cache trace file\n");
+            }
+            m_trace = NULL;
+        }
+        return NULL;
+    }
+
+    if (m_chunk_offset == m_chunk.size()) {
+        uint64_t chunk_size = std::min(chunkRecords * record_size,
+                                       m_uncompressed_trace_size -
+                                       m_bytes_read);
+        chunk_size -= chunk_size % record_size;
+
+        m_chunk.resize(chunk_size);
+        if (gzread(m_trace, m_chunk.data(), chunk_size) < (int)chunk_size) {
+            fatal("Unable to read complete trace from cache trace file\n");
+        }
+        m_chunk_offset = 0;
+    }
+
+    const TraceRecord* rec = (const TraceRecord*) (m_chunk.data() +
+                                                   m_chunk_offset);
+    m_chunk_offset += record_size;
+    m_bytes_read += record_size;
+    m_records_read++;
+    return rec;
+}
+
 void
 CacheRecorder::enqueueNextFetchRequest()
 {
-    if (m_bytes_read < m_uncompressed_trace_size) {
-        TraceRecord* traceRecord = (TraceRecord*) (m_uncompressed_trace +
-                                                                m_bytes_read);
+    if (const TraceRecord* rec = nextRecord()) {
+        issueFetchRequest(rec);
+    } else {
+        DPRINTF(RubyCacheTrace, "Fetched all %d records\n", m_records_read);
+    }
+}
 
-        DPRINTF(RubyCacheTrace, "Issuing %s\n", *traceRecord);
+void
+CacheRecorder::issueFetchRequest(const TraceRecord* traceRecord)
+{
+    DPRINTF(RubyCacheTrace, "Issuing %s\n", *traceRecord);
 
-        for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
-                rec_bytes_read += RubySystem::getBlockSizeBytes()) {
-            RequestPtr req;
-            MemCmd::Command requestType;
+    for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
+            rec_bytes_read += RubySystem::getBlockSizeBytes()) {
+        RequestPtr req;
+        MemCmd::Command requestType;
 
-            if (traceRecord->m_type == RubyRequestType_LD) {
-                requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
-                    traceRecord->m_data_address + rec_bytes_read,
-                    RubySystem::getBlockSizeBytes(), 0,
-                                    Request::funcRequestorId);
-            }   else if (traceRecord->m_type == RubyRequestType_IFETCH) {
-                requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
-                        traceRecord->m_data_address + rec_bytes_read,
-                        RubySystem::getBlockSizeBytes(),
-                        Request::INST_FETCH, Request::funcRequestorId);
-            }   else {
-                requestType = MemCmd::WriteReq;
-                req = std::make_shared<Request>(
-                    traceRecord->m_data_address + rec_bytes_read,
-                    RubySystem::getBlockSizeBytes(), 0,
+        if (traceRecord->m_type == RubyRequestType_LD) {
+            requestType = MemCmd::ReadReq;
+            req = std::make_shared<Request>(
+                traceRecord->m_data_address + rec_bytes_read,
+                RubySystem::getBlockSizeBytes(), 0,
                                 Request::funcRequestorId);
-            }
-
-            Packet *pkt = new Packet(req, requestType);
-            pkt->dataStatic(traceRecord->m_data + rec_bytes_read);
-
-            Sequencer* m_sequencer_ptr = m_seq_map[traceRecord->m_cntrl_id];
-            assert(m_sequencer_ptr != NULL);
-            m_sequencer_ptr->makeRequest(pkt);
+        }   else if (traceRecord->m_type == RubyRequestType_IFETCH) {
+            requestType = MemCmd::ReadReq;
+            req = std::make_shared<Request>(
+                    traceRecord->m_data_address + rec_bytes_read,
+                    RubySystem::getBlockSizeBytes(),
+                    Request::INST_FETCH, Request::funcRequestorId);
+        }   else {
+            requestType = MemCmd::WriteReq;
+            req = std::make_shared<Request>(
+                traceRecord->m_data_address + rec_bytes_read,
+                RubySystem::getBlockSizeBytes(), 0,
+                            Request::funcRequestorId);
         }
 
-        m_bytes_read += (sizeof(TraceRecord) + m_block_size_bytes);
-        m_records_read++;
-    } else {
-        DPRINTF(RubyCacheTrace, "Fetched all %d records\n", m_records_read);
+        // The packet keeps its own copy of the data, as the chunk holding
+        // the record may be replaced before the request completes.
+        Packet *pkt = new Packet(req, requestType);
+        pkt->allocate();
+        pkt->setData(traceRecord->m_data + rec_bytes_read);
+
+        Sequencer* m_sequencer_ptr = m_seq_map[traceRecord->m_cntrl_id];
+        assert(m_sequencer_ptr != NULL);
+        m_sequencer_ptr->makeRequest(pkt);
     }
 }
 
@@ -172,39 +227,38 @@ CacheRecorder::addRecord(int cntrl, Addr data_addr, Addr pc_addr,
 }
 
 uint64_t
-CacheRecorder::aggregateRecords(uint8_t **buf, uint64_t total_size)
+CacheRecorder::writeTrace(const std::string& filename)
 {
     std::sort(m_records.begin(), m_records.end(), compareTraceRecords);
 
-    int size = m_records.size();
-    uint64_t current_size = 0;
-    int record_size = sizeof(TraceRecord) + m_block_size_bytes;
-
-    for (int i = 0; i < size; ++i) {
-        // Determine if we need to expand the buffer size
-        if (current_size + record_size > total_size) {
-            uint8_t* new_buf = new (std::nothrow) uint8_t[total_size * 2];
-            if (new_buf == NULL) {
-                fatal("Unable to allocate buffer of size %s\n",
-                      total_size * 2);
-            }
-            total_size = total_size * 2;
-            uint8_t* old_buf = *buf;
-            memcpy(new_buf, old_buf, current_size);
-            *buf = new_buf;
-            delete [] old_buf;
-        }
+    int fd = creat(filename.c_str(), 0664);
+    if (fd < 0) {
+        perror("creat");
+        fatal("Can't open memory trace file '%s'\n", filename);
+    }
 
-        // Copy the current record into the buffer
-        memcpy(&((*buf)[current_size]), m_records[i], record_size);
-        current_size += record_size;
+    gzFile trace = gzdopen(fd, "wb");
+    if (trace == NULL)
+        fatal("Insufficient memory to allocate compression state for %s\n",
+              filename);
 
-        free(m_records[i]);
-        m_records[i] = NULL;
+    // The records are compressed as they are written, so the trace is
+    // never held in memory uncompressed as a whole.
+    uint64_t record_size = sizeof(TraceRecord) + m_block_size_bytes;
+    uint64_t trace_size = 0;
+    for (auto rec : m_records) {
+        if (gzwrite(trace, rec, record_size) != (int)record_size) {
+            fatal("Write failed on memory trace file '%s'\n", filename);
+        }
+        trace_size += record_size;
+        free(rec);
     }
-
     m_records.clear();
-    return current_size;
+
+    if (gzclose(trace)) {
+        fatal("Close failed on memory trace file '%s'\n", filename);
+    }
+    return trace_size;
 }
 
 } // namespace ruby
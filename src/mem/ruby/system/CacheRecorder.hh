@@ -29,12 +29,16 @@
 
 /*
  * Recording cache requests made to a ruby cache at certain ruby
- * time. Also dump the requests to a gziped file.
+ * time. Also dump the requests to a gziped file, and replay them from
+ * that file a chunk at a time.
  */
 
 #ifndef __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 #define __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 
+#include <zlib.h>
+
+#include <string>
 #include <vector>
 
 #include "base/types.hh"
@@ -76,14 +80,25 @@ class CacheRecorder
     CacheRecorder();
     ~CacheRecorder();
 
-    CacheRecorder(uint8_t* uncompressed_trace,
+    /*!
+     * Create a recorder that replays the trace in trace_file, which holds
+     * uncompressed_trace_size bytes once decompressed. An empty file name
+     * creates a recorder to record a trace into. Controller i issues its
+     * requests through SequencerMap[i].
+     */
+    CacheRecorder(const std::string& trace_file,
                   uint64_t uncompressed_trace_size,
                   std::vector<Sequencer*>& SequencerMap,
                   uint64_t block_size_bytes);
     void addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                    RubyRequestType type, Tick time, DataBlock& data);
 
-    uint64_t aggregateRecords(uint8_t **data, uint64_t size);
+    /*!
+     * Write the recorded contents of the caches to a gziped file, most
+     * recently accessed lines first, and release the records. Returns
+     * the size of the trace before compression.
+     */
+    uint64_t writeTrace(const std::string& filename);
 
     /*!
      * Function for flushing the memory contents of the caches to the
@@ -109,9 +124,24 @@ class CacheRecorder
     CacheRecorder(const CacheRecorder& obj);
     CacheRecorder& operator=(const CacheRecorder& obj);
 
+    /*!
+     * Return the next record of the trace being replayed, or NULL once
+     * all of them have been read. The record stays valid until the next
+     * call. The trace is decompressed one chunk at a time, so only a
+     * chunk is ever held in memory.
+     */
+    const TraceRecord* nextRecord();
+
+    void issueFetchRequest(const TraceRecord* rec);
+
+    // Number of records decompressed at once
+    static const uint64_t chunkRecords = 4096;
+
     std::vector<TraceRecord*> m_records;
-    uint8_t* m_uncompressed_trace;
+    gzFile m_trace;
     uint64_t m_uncompressed_trace_size;
+    std::vector<uint8_t> m_chunk;
+    uint64_t m_chunk_offset;
     std::vector<Sequencer*> m_seq_map;
     uint64_t m_bytes_read;
     uint64_t m_records_read;
@@ -45,6 +45,7 @@
 #include <cassert>
 #include <string>
 
+#include "base/object_pool.hh"
 #include "mem/ruby/common/MachineID.hh"
 #include "mem/ruby/network/MessageBuffer.hh"
 #include "mem/ruby/protocol/RequestStatus.hh"
@@ -148,6 +149,8 @@ class RubyPort : public ClockedObject
         MemResponsePort *port;
         SenderState(MemResponsePort * _port) : port(_port)
         {}
+
+        GEM5_POOLED_NEW(SenderState)
      };
 
     typedef RubyPortParams Params;
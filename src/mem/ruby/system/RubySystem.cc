@@ -40,11 +40,9 @@
 
 #include "mem/ruby/system/RubySystem.hh"
 
-#include <fcntl.h>
-#include <zlib.h>
-
-#include <cstdio>
+#include <algorithm>
 #include <list>
+#include <set>
 
 #include "base/compiler.hh"
 #include "base/intmath.hh"
@@ -52,6 +50,8 @@
 #include "debug/RubyCacheTrace.hh"
 #include "debug/RubySystem.hh"
 #include "mem/ruby/common/Address.hh"
+#include "mem/ruby/common/DataBlock.hh"
+#include "mem/ruby/network/BasicRouter.hh"
 #include "mem/ruby/network/Network.hh"
 #include "mem/ruby/system/DMASequencer.hh"
 #include "mem/ruby/system/Sequencer.hh"
@@ -70,20 +70,31 @@ bool RubySystem::m_randomization;
 uint32_t RubySystem::m_block_size_bytes;
 uint32_t RubySystem::m_block_size_bits;
 uint32_t RubySystem::m_memory_size_bits;
-bool RubySystem::m_warmup_enabled = false;
+std::atomic<bool> RubySystem::m_warmup_enabled(false);
 // To look forward to allowing multiple RubySystem instances, track the number
 // of RubySystems that need to be warmed up on checkpoint restore.
 unsigned RubySystem::m_systems_to_warmup = 0;
-bool RubySystem::m_cooldown_enabled = false;
+std::atomic<bool> RubySystem::m_cooldown_enabled(false);
 
 RubySystem::RubySystem(const Params &p)
     : ClockedObject(p), m_access_backing_store(p.access_backing_store),
+      m_check_functional_index(p.check_functional_access_index),
+      m_unindexed_cntrls_dirty(true),
       m_cache_recorder(NULL)
 {
+    if (p.functional_access_index) {
+        m_functional_index = std::make_unique<FunctionalAccessIndex>();
+    }
+
     m_randomization = p.randomization;
 
     m_block_size_bytes = p.block_size_bytes;
     assert(isPowerOf2(m_block_size_bytes));
+    fatal_if(m_block_size_bytes > DataBlock::maxBlockSizeBytes,
+             "Ruby block size (%d) exceeds MAX_BLOCK_SIZE_BYTES (%d). "
+             "Rebuild with MAX_BLOCK_SIZE_BYTES=%d or larger.\n",
+             m_block_size_bytes, DataBlock::maxBlockSizeBytes,
+             m_block_size_bytes);
     m_block_size_bits = floorLog2(m_block_size_bytes);
     m_memory_size_bits = p.memory_size_bits;
 
@@ -158,6 +169,7 @@ RubySystem::registerRequestorIDs()
         // Create helper vectors for each network to iterate over.
         netCntrls[network_id].push_back(cntrl);
     }
+    m_unindexed_cntrls_dirty = true;
 
     // Default all other requestor IDs to network 0
     for (auto id = 0; id < params().system->maxRequestors(); ++id) {
@@ -167,13 +179,102 @@ RubySystem::registerRequestorIDs()
     }
 }
 
+int
+RubySystem::registerFunctionallyIndexed(AbstractController *cntrl)
+{
+    assert(m_functional_index);
+    auto it = std::find(m_abs_cntrl_vec.begin(), m_abs_cntrl_vec.end(),
+                        cntrl);
+    assert(it != m_abs_cntrl_vec.end());
+
+    int id = it - m_abs_cntrl_vec.begin();
+    m_functionally_indexed.resize(m_abs_cntrl_vec.size(), false);
+    m_functionally_indexed[id] = true;
+    m_unindexed_cntrls_dirty = true;
+
+    DPRINTF(RubySystem, "Functional accesses to %s use the index (id %d)\n",
+            cntrl->name(), id);
+    return id;
+}
+
+void
+RubySystem::updateUnindexedControllers()
+{
+    m_functionally_indexed.resize(m_abs_cntrl_vec.size(), false);
+    m_cntrl_network.assign(m_abs_cntrl_vec.size(), -1);
+    m_unindexed_cntrls.clear();
+
+    for (int id = 0; id < m_abs_cntrl_vec.size(); ++id) {
+        auto it = machineToNetwork.find(m_abs_cntrl_vec[id]->getMachineID());
+        if (it != machineToNetwork.end())
+            m_cntrl_network[id] = it->second;
+        if (!m_functionally_indexed[id])
+            m_unindexed_cntrls.push_back(id);
+    }
+    m_unindexed_cntrls_dirty = false;
+}
+
+const std::vector<AbstractController *> &
+RubySystem::getFunctionalCandidates(Addr line_addr, int net_id)
+{
+    const auto &all_cntrls = net_id < 0 ? m_abs_cntrl_vec : netCntrls[net_id];
+    if (!m_functional_index)
+        return all_cntrls;
+
+    if (m_unindexed_cntrls_dirty)
+        updateUnindexedControllers();
+
+    // Merge the controllers that hold the line with the ones the index
+    // cannot speak for. Both lists are sorted by id, which preserves the
+    // order of a full scan.
+    m_functional_ids.clear();
+    m_functional_index->lookup(line_addr, m_functional_ids);
+
+    m_functional_candidates.clear();
+    auto indexed = m_functional_ids.begin();
+    auto unindexed = m_unindexed_cntrls.begin();
+    while (indexed != m_functional_ids.end() ||
+           unindexed != m_unindexed_cntrls.end()) {
+        int id;
+        if (unindexed == m_unindexed_cntrls.end() ||
+            (indexed != m_functional_ids.end() && *indexed < *unindexed)) {
+            id = *indexed++;
+        } else {
+            id = *unindexed++;
+        }
+        if (net_id < 0 || m_cntrl_network[id] == net_id)
+            m_functional_candidates.push_back(m_abs_cntrl_vec[id]);
+    }
+
+    if (m_check_functional_index) {
+        for (auto cntrl : all_cntrls) {
+            if (std::find(m_functional_candidates.begin(),
+                          m_functional_candidates.end(), cntrl) !=
+                m_functional_candidates.end()) {
+                continue;
+            }
+            AccessPermission perm = cntrl->getAccessPermission(line_addr);
+            panic_if(perm != AccessPermission_Invalid &&
+                     perm != AccessPermission_NotPresent,
+                     "Functional access index is missing %#x in %s (%s)",
+                     line_addr, cntrl->name(),
+                     AccessPermission_to_string(perm));
+        }
+    }
+
+    DPRINTF(RubySystem, "Functional access to %#x queries %d of %d "
+            "controllers\n", line_addr, m_functional_candidates.size(),
+            all_cntrls.size());
+    return m_functional_candidates;
+}
+
 RubySystem::~RubySystem()
 {
     delete m_profiler;
 }
 
 void
-RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
+RubySystem::makeCacheRecorder(const std::string &cache_trace_file,
                               uint64_t cache_trace_size,
                               uint64_t block_size_bytes)
 {
@@ -201,18 +302,23 @@ RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
     }
 
     // Create the CacheRecorder and record the cache trace
-    m_cache_recorder = new CacheRecorder(uncompressed_trace, cache_trace_size,
+    m_cache_recorder = new CacheRecorder(cache_trace_file, cache_trace_size,
                                          sequencer_map, block_size_bytes);
 }
 
 void
 RubySystem::memWriteback()
 {
+    // The flush is simulated by replaying a trace from this object's event
+    // queue only
+    fatal_if(m_event_queues.size() > 1, "%s: the caches cannot be written "
+             "back when Ruby is simulated on several event queues", name());
+
     m_cooldown_enabled = true;
 
     // Make the trace so we know what to write back.
     DPRINTF(RubyCacheTrace, "Recording Cache Trace\n");
-    makeCacheRecorder(NULL, 0, getBlockSizeBytes());
+    makeCacheRecorder("", 0, getBlockSizeBytes());
     for (int cntrl = 0; cntrl < m_abs_cntrl_vec.size(); cntrl++) {
         m_abs_cntrl_vec[cntrl]->recordCacheTrace(cntrl, m_cache_recorder);
     }
@@ -278,35 +384,6 @@ RubySystem::memWriteback()
     // checkpoint is immediately taken.
 }
 
-void
-RubySystem::writeCompressedTrace(uint8_t *raw_data, std::string filename,
-                                 uint64_t uncompressed_trace_size)
-{
-    // Create the checkpoint file for the memory
-    std::string thefile = CheckpointIn::dir() + "/" + filename.c_str();
-
-    int fd = creat(thefile.c_str(), 0664);
-    if (fd < 0) {
-        perror("creat");
-        fatal("Can't open memory trace file '%s'\n", filename);
-    }
-
-    gzFile compressedMemory = gzdopen(fd, "wb");
-    if (compressedMemory == NULL)
-        fatal("Insufficient memory to allocate compression state for %s\n",
-              filename);
-
-    if (gzwrite(compressedMemory, raw_data, uncompressed_trace_size) !=
-        uncompressed_trace_size) {
-        fatal("Write failed on memory trace file '%s'\n", filename);
-    }
-
-    if (gzclose(compressedMemory)) {
-        fatal("Close failed on memory trace file '%s'\n", filename);
-    }
-    delete[] raw_data;
-}
-
 void
 RubySystem::serialize(CheckpointOut &cp) const
 {
@@ -323,12 +400,10 @@ RubySystem::serialize(CheckpointOut &cp) const
         fatal("Call memWriteback() before serialize() to create ruby trace");
     }
 
-    // Aggregate the trace entries together into a single array
-    uint8_t *raw_data = new uint8_t[4096];
-    uint64_t cache_trace_size = m_cache_recorder->aggregateRecords(&raw_data,
-                                                                 4096);
+    // Stream the trace entries to the checkpoint
     std::string cache_trace_file = name() + ".cache.gz";
-    writeCompressedTrace(raw_data, cache_trace_file, cache_trace_size);
+    uint64_t cache_trace_size = m_cache_recorder->writeTrace(
+        CheckpointIn::dir() + "/" + cache_trace_file);
 
     SERIALIZE_SCALAR(cache_trace_file);
     SERIALIZE_SCALAR(cache_trace_size);
@@ -345,42 +420,9 @@ RubySystem::drainResume()
     }
 }
 
-void
-RubySystem::readCompressedTrace(std::string filename, uint8_t *&raw_data,
-                                uint64_t &uncompressed_trace_size)
-{
-    // Read the trace file
-    gzFile compressedTrace;
-
-    // trace file
-    int fd = open(filename.c_str(), O_RDONLY);
-    if (fd < 0) {
-        perror("open");
-        fatal("Unable to open trace file %s", filename);
-    }
-
-    compressedTrace = gzdopen(fd, "rb");
-    if (compressedTrace == NULL) {
-        fatal("Insufficient memory to allocate compression state for %s\n",
-              filename);
-    }
-
-    raw_data = new uint8_t[uncompressed_trace_size];
-    if (gzread(compressedTrace, raw_data, uncompressed_trace_size) <
-            uncompressed_trace_size) {
-        fatal("Unable to read complete trace from file %s\n", filename);
-    }
-
-    if (gzclose(compressedTrace)) {
-        fatal("Failed to close cache trace file '%s'\n", filename);
-    }
-}
-
 void
 RubySystem::unserialize(CheckpointIn &cp)
 {
-    uint8_t *uncompressed_trace = NULL;
-
     // This value should be set to the checkpoint-system's block-size.
     // Optional, as checkpoints without it can be run if the
     // checkpoint-system's block-size == current block-size.
@@ -394,19 +436,70 @@ RubySystem::unserialize(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(cache_trace_size);
     cache_trace_file = cp.getCptDir() + "/" + cache_trace_file;
 
-    readCompressedTrace(cache_trace_file, uncompressed_trace,
-                        cache_trace_size);
     m_warmup_enabled = true;
     m_systems_to_warmup++;
 
-    // Create the cache recorder that will hang around until startup.
-    makeCacheRecorder(uncompressed_trace, cache_trace_size, block_size_bytes);
+    // Create the cache recorder that will hang around until startup. It
+    // reads the trace a chunk at a time while replaying it.
+    makeCacheRecorder(cache_trace_file, cache_trace_size, block_size_bytes);
 }
 
 void
 RubySystem::init()
 {
     registerRequestorIDs();
+    collectEventQueues();
+
+    // The random delays are drawn from a generator shared by all threads
+    fatal_if(m_event_queues.size() > 1 && m_randomization,
+             "%s: randomization is not supported when Ruby is simulated on "
+             "several event queues", name());
+}
+
+void
+RubySystem::collectEventQueues()
+{
+    std::set<EventQueue *> queues;
+    queues.insert(eventQueue());
+    for (auto cntrl : m_abs_cntrl_vec) {
+        queues.insert(cntrl->eventQueue());
+        if (cntrl->getCPUSequencer())
+            queues.insert(cntrl->getCPUSequencer()->eventQueue());
+        if (cntrl->getDMASequencer())
+            queues.insert(cntrl->getDMASequencer()->eventQueue());
+    }
+    for (auto &network : m_networks) {
+        queues.insert(network->eventQueue());
+        for (auto router : network->params().routers)
+            queues.insert(router->eventQueue());
+        for (auto netif : network->params().netifs)
+            queues.insert(netif->eventQueue());
+    }
+
+    m_event_queues.assign(queues.begin(), queues.end());
+}
+
+RubySystem::ScopedQueuesLock::ScopedQueuesLock(
+    const std::vector<EventQueue *> &queues)
+    : m_queues(queues), m_own_queue(nullptr)
+{
+    if (!inParallelMode)
+        return;
+
+    m_own_queue = curEventQueue();
+    m_own_queue->unlock();
+    for (auto queue : m_queues)
+        queue->lock();
+}
+
+RubySystem::ScopedQueuesLock::~ScopedQueuesLock()
+{
+    if (m_own_queue == nullptr)
+        return;
+
+    for (auto it = m_queues.rbegin(); it != m_queues.rend(); ++it)
+        (*it)->unlock();
+    m_own_queue->lock();
 }
 
 void
@@ -429,7 +522,20 @@ RubySystem::startup()
     // Ruby finishes restoring the state is less than the time when the
     // state was checkpointed.
 
-    if (m_warmup_enabled) {
+    if (m_warmup_enabled && m_event_queues.size() > 1) {
+        // The warmup is simulated by replaying a trace from this object's
+        // event queue only. The caches were written back when the
+        // checkpoint was taken, so starting with cold caches is correct.
+        warn("%s: Ruby is simulated on several event queues, the caches "
+             "are not warmed up", name());
+
+        delete m_cache_recorder;
+        m_cache_recorder = NULL;
+        m_systems_to_warmup--;
+        if (m_systems_to_warmup == 0) {
+            m_warmup_enabled = false;
+        }
+    } else if (m_warmup_enabled) {
         DPRINTF(RubyCacheTrace, "Starting ruby cache warmup\n");
         // save the current tick value
         Tick curtick_original = curTick();
@@ -491,6 +597,8 @@ RubySystem::functionalRead(PacketPtr pkt)
 
     DPRINTF(RubySystem, "Functional Read request for %#x\n", address);
 
+    ScopedQueuesLock queues_lock(m_event_queues);
+
     unsigned int num_ro = 0;
     unsigned int num_rw = 0;
     unsigned int num_busy = 0;
@@ -508,9 +616,13 @@ RubySystem::functionalRead(PacketPtr pkt)
     AbstractController *ctrl_backing_store = nullptr;
 
     // In this loop we count the number of controllers that have the given
-    // address in read only, read write and busy states.
-    for (auto& cntrl : netCntrls[request_net_id]) {
-        access_perm = cntrl-> getAccessPermission(line_address);
+    // address in read only, read write and busy states. Controllers left
+    // out by the functional access index do not hold the line.
+    const auto &candidates =
+        getFunctionalCandidates(line_address, request_net_id);
+    num_invalid = netCntrls[request_net_id].size() - candidates.size();
+    for (auto& cntrl : candidates) {
+        access_perm = cntrl->getAccessPermission(line_address);
         if (access_perm == AccessPermission_Read_Only){
             num_ro++;
             if (ctrl_ro == nullptr) ctrl_ro = cntrl;
@@ -605,6 +717,8 @@ RubySystem::functionalRead(PacketPtr pkt)
 
     DPRINTF(RubySystem, "Functional Read request for %#x\n", address);
 
+    ScopedQueuesLock queues_lock(m_event_queues);
+
     std::vector<AbstractController*> ctrl_ro;
     std::vector<AbstractController*> ctrl_busy;
     std::vector<AbstractController*> ctrl_others;
@@ -612,7 +726,8 @@ RubySystem::functionalRead(PacketPtr pkt)
     AbstractController *ctrl_bs = nullptr;
 
     // Build lists of controllers that have line
-    for (auto ctrl : m_abs_cntrl_vec) {
+    const auto &candidates = getFunctionalCandidates(line_address, -1);
+    for (auto ctrl : candidates) {
         switch(ctrl->getAccessPermission(line_address)) {
             case AccessPermission_Read_Only:
                 ctrl_ro.push_back(ctrl);
@@ -667,6 +782,20 @@ RubySystem::functionalRead(PacketPtr pkt)
     if (!ctrl_busy.empty() || !bytes.isFull()) {
         DPRINTF(RubySystem, "Reading from remaining controllers, "
                             "buffers and networks\n");
+        // Controllers left out by the functional access index may still
+        // have the line in their buffers
+        if (candidates.size() != m_abs_cntrl_vec.size()) {
+            ctrl_others.clear();
+            for (auto ctrl : m_abs_cntrl_vec) {
+                if (ctrl != ctrl_rw && ctrl != ctrl_bs &&
+                    std::find(ctrl_ro.begin(), ctrl_ro.end(), ctrl) ==
+                        ctrl_ro.end() &&
+                    std::find(ctrl_busy.begin(), ctrl_busy.end(), ctrl) ==
+                        ctrl_busy.end()) {
+                    ctrl_others.push_back(ctrl);
+                }
+            }
+        }
         if (ctrl_rw != nullptr)
             ctrl_rw->functionalReadBuffers(pkt, bytes);
         for (auto ctrl : ctrl_ro)
@@ -707,6 +836,8 @@ RubySystem::functionalWrite(PacketPtr pkt)
 
     DPRINTF(RubySystem, "Functional Write request for %#x\n", addr);
 
+    ScopedQueuesLock queues_lock(m_event_queues);
+
     [[maybe_unused]] uint32_t num_functional_writes = 0;
 
     // Only send functional requests within the same network.
@@ -714,15 +845,18 @@ RubySystem::functionalWrite(PacketPtr pkt)
     int request_net_id = requestorToNetwork[pkt->requestorId()];
     assert(netCntrls.count(request_net_id));
 
-    for (auto& cntrl : netCntrls[request_net_id]) {
-        num_functional_writes += cntrl->functionalWriteBuffers(pkt);
-
+    for (auto& cntrl : getFunctionalCandidates(line_addr, request_net_id)) {
         access_perm = cntrl->getAccessPermission(line_addr);
         if (access_perm != AccessPermission_Invalid &&
             access_perm != AccessPermission_NotPresent) {
             num_functional_writes +=
                 cntrl->functionalWrite(line_addr, pkt);
         }
+    }
+
+    // Any controller may have the line in its buffers
+    for (auto& cntrl : netCntrls[request_net_id]) {
+        num_functional_writes += cntrl->functionalWriteBuffers(pkt);
 
         // Also updates requests pending in any sequencer associated
         // with the controller
@@ -35,13 +35,17 @@
 #ifndef __MEM_RUBY_SYSTEM_RUBYSYSTEM_HH__
 #define __MEM_RUBY_SYSTEM_RUBYSYSTEM_HH__
 
+#include <atomic>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "base/callback.hh"
 #include "base/output.hh"
 #include "mem/packet.hh"
 #include "mem/ruby/profiler/Profiler.hh"
 #include "mem/ruby/slicc_interface/AbstractController.hh"
+#include "mem/ruby/structures/FunctionalAccessIndex.hh"
 #include "mem/ruby/system/CacheRecorder.hh"
 #include "params/RubySystem.hh"
 #include "sim/clocked_object.hh"
@@ -72,8 +76,16 @@ class RubySystem : public ClockedObject
     static uint32_t getBlockSizeBytes() { return m_block_size_bytes; }
     static uint32_t getBlockSizeBits() { return m_block_size_bits; }
     static uint32_t getMemorySizeBits() { return m_memory_size_bits; }
-    static bool getWarmupEnabled() { return m_warmup_enabled; }
-    static bool getCooldownEnabled() { return m_cooldown_enabled; }
+    static bool
+    getWarmupEnabled()
+    {
+        return m_warmup_enabled.load(std::memory_order_relaxed);
+    }
+    static bool
+    getCooldownEnabled()
+    {
+        return m_cooldown_enabled.load(std::memory_order_relaxed);
+    }
 
     memory::SimpleMemory *getPhysMem() { return m_phys_mem; }
     Cycles getStartCycle() { return m_start_cycle; }
@@ -108,6 +120,23 @@ class RubySystem : public ClockedObject
     void registerMachineID(const MachineID& mach_id, Network* network);
     void registerRequestorIDs();
 
+    /**
+     * Index of the lines held by the cache controllers, or nullptr if
+     * functional accesses have to query every controller.
+     */
+    FunctionalAccessIndex *
+    getFunctionalAccessIndex()
+    {
+        return m_functional_index.get();
+    }
+
+    /**
+     * Declare that the access permissions of a controller are fully
+     * determined by the structures reporting to the functional access
+     * index. Returns the id the controller is known by in the index.
+     */
+    int registerFunctionallyIndexed(AbstractController *cntrl);
+
     bool eventQueueEmpty() { return eventq->empty(); }
     void enqueueRubyEvent(Tick tick)
     {
@@ -121,17 +150,46 @@ class RubySystem : public ClockedObject
     RubySystem(const RubySystem& obj);
     RubySystem& operator=(const RubySystem& obj);
 
-    void makeCacheRecorder(uint8_t *uncompressed_trace,
+    void makeCacheRecorder(const std::string &cache_trace_file,
                            uint64_t cache_trace_size,
                            uint64_t block_size_bytes);
 
-    static void readCompressedTrace(std::string filename,
-                                    uint8_t *&raw_data,
-                                    uint64_t &uncompressed_trace_size);
-    static void writeCompressedTrace(uint8_t *raw_data, std::string file,
-                                     uint64_t uncompressed_trace_size);
-
     void processRubyEvent();
+
+    /**
+     * Returns the controllers of a network (of every network if net_id is
+     * negative) whose permission for a line may be other than Invalid or
+     * NotPresent, in the order they were registered. Without a functional
+     * access index this is every controller of the network.
+     */
+    const std::vector<AbstractController *> &
+    getFunctionalCandidates(Addr line_addr, int net_id);
+
+    /** Rebuild the list of controllers the index cannot speak for. */
+    void updateUnindexedControllers();
+
+    /** Find the event queues the Ruby objects are simulated on. */
+    void collectEventQueues();
+
+    /**
+     * Holds the locks of all the event queues simulating Ruby objects, so
+     * that a functional access sees the controllers, sequencers and
+     * networks in a consistent state when Ruby is split across threads.
+     * The queue of the calling thread is released first and the locks are
+     * always taken in the same order, so two threads doing this at once
+     * cannot deadlock. Does nothing outside of parallel simulation.
+     */
+    class ScopedQueuesLock
+    {
+      public:
+        ScopedQueuesLock(const std::vector<EventQueue *> &queues);
+        ~ScopedQueuesLock();
+
+      private:
+        const std::vector<EventQueue *> &m_queues;
+        EventQueue *m_own_queue;
+    };
+
   private:
     // configuration parameters
     static bool m_randomization;
@@ -139,9 +197,11 @@ class RubySystem : public ClockedObject
     static uint32_t m_block_size_bits;
     static uint32_t m_memory_size_bits;
 
-    static bool m_warmup_enabled;
+    // Read by every simulation thread, only written while simulating on
+    // a single thread
+    static std::atomic<bool> m_warmup_enabled;
     static unsigned m_systems_to_warmup;
-    static bool m_cooldown_enabled;
+    static std::atomic<bool> m_cooldown_enabled;
     memory::SimpleMemory *m_phys_mem;
     const bool m_access_backing_store;
 
@@ -154,6 +214,24 @@ class RubySystem : public ClockedObject
     std::unordered_map<RequestorID, unsigned> requestorToNetwork;
     std::unordered_map<unsigned, std::vector<AbstractController*>> netCntrls;
 
+    // Functional access index, if enabled, and whether every lookup is
+    // checked against a scan of all the controllers
+    std::unique_ptr<FunctionalAccessIndex> m_functional_index;
+    const bool m_check_functional_index;
+
+    // Per controller id: whether the index tracks it, and its network
+    std::vector<bool> m_functionally_indexed;
+    std::vector<int> m_cntrl_network;
+    // Ids of the controllers that must always be queried
+    std::vector<int> m_unindexed_cntrls;
+    bool m_unindexed_cntrls_dirty;
+
+    // Event queues of the controllers, sequencers and networks, sorted
+    std::vector<EventQueue *> m_event_queues;
+    // Scratch space for getFunctionalCandidates
+    std::vector<int> m_functional_ids;
+    std::vector<AbstractController *> m_functional_candidates;
+
   public:
     Profiler* m_profiler;
     CacheRecorder* m_cache_recorder;
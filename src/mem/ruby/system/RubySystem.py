@@ -39,7 +39,8 @@ class RubySystem(ClockedObject):
          buffers are enforced to have randomization; otherwise, a message \
          buffer set its own flag to enable/disable randomization)");
     block_size_bytes = Param.UInt32(64,
-        "default cache block size; must be a power of two");
+        "default cache block size; must be a power of two and no "
+        "larger than the MAX_BLOCK_SIZE_BYTES build option (64 by default)");
     memory_size_bits = Param.UInt32(64,
         "number of bits that a memory address requires");
 
@@ -49,6 +50,13 @@ class RubySystem(ClockedObject):
     access_backing_store = Param.Bool(False, "Use phys_mem as the functional \
         store and only use ruby for timing.")
 
+    functional_access_index = Param.Bool(False, "Track the lines held by \
+        each cache controller so that functional accesses only query the \
+        controllers holding the line.")
+    check_functional_access_index = Param.Bool(False, "Check every \
+        functional access index lookup against a query of all the \
+        controllers (slow, for debugging).")
+
     # Profiler related configuration variables
     hot_lines = Param.Bool(False, "")
     all_instructions = Param.Bool(False, "")
@@ -71,6 +71,12 @@ def main(args=None):
                       help="print traceback on error")
     parser.add_option("-q", "--quiet",
                       help="don't print messages")
+    parser.add_option("--dispatch", choices=['switch', 'table'],
+                      default='switch',
+                      help="dispatch transitions with a switch statement "
+                      "or a transition table")
+    parser.add_option("--profile-transitions", action='store_true',
+                      help="measure the host time spent in each transition")
     opts,files = parser.parse_args(args=args)
 
     if len(files) != 1:
@@ -91,7 +97,8 @@ def main(args=None):
     protocol_base = os.path.join(os.path.dirname(__file__),
                                  '..', 'ruby', 'protocol')
     slicc = SLICC(slicc_file, protocol_base, verbose=True, debug=opts.debug,
-                  traceback=opts.tb)
+                  traceback=opts.tb, dispatch=opts.dispatch,
+                  profile_transitions=bool(opts.profile_transitions))
 
 
     if opts.print_files:
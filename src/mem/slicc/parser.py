@@ -49,10 +49,15 @@ import slicc.util as util
 from slicc.symbols import SymbolTable
 
 class SLICC(Grammar):
-    def __init__(self, filename, base_dir, verbose=False, traceback=False, **kwargs):
+    def __init__(self, filename, base_dir, verbose=False, traceback=False,
+                 dispatch='switch', profile_transitions=False, **kwargs):
         self.protocol = None
         self.traceback = traceback
         self.verbose = verbose
+        # How the controllers dispatch transitions: 'switch' or 'table'
+        self.dispatch = dispatch
+        # Whether the controllers measure the host time of each transition
+        self.profile_transitions = profile_transitions
         self.symtab = SymbolTable(self)
         self.base_dir = base_dir
 
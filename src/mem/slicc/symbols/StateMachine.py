@@ -341,6 +341,15 @@ class $c_ident : public AbstractController
     uint64_t getEventCount(${ident}_Event event);
     bool isPossible(${ident}_State state, ${ident}_Event event);
     uint64_t getTransitionCount(${ident}_State state, ${ident}_Event event);
+''')
+
+        if self.symtab.slicc.profile_transitions:
+            code('''
+    double getTransitionHostSeconds(${ident}_State state,
+                                    ${ident}_Event event);
+''')
+
+        code('''
 
 private:
 ''')
@@ -399,6 +408,57 @@ bool m_possible[${ident}_State_NUM][${ident}_Event_NUM];
 static std::vector<statistics::Vector *> eventVec;
 static std::vector<std::vector<statistics::Vector *> > transVec;
 static int m_num_controllers;
+''')
+
+        if self.symtab.slicc.profile_transitions:
+            code('''
+// Host time spent in the transitions, in nanoseconds
+uint64_t m_transition_host_ns[${ident}_State_NUM][${ident}_Event_NUM];
+static std::vector<std::vector<statistics::Vector *> > transHostTimeVec;
+''')
+
+        if self.symtab.slicc.dispatch == 'table':
+            if self.TBEType != None and self.EntryType != None:
+                action_params = '%s*&, %s*&, Addr' % \
+                    (self.TBEType.c_ident, self.EntryType.c_ident)
+            elif self.TBEType != None:
+                action_params = '%s*&, Addr' % self.TBEType.c_ident
+            elif self.EntryType != None:
+                action_params = '%s*&, Addr' % self.EntryType.c_ident
+            else:
+                action_params = 'Addr'
+            code('''
+// Transition table, indexed by state and event
+typedef void ($c_ident::*ActionFn)($action_params);
+
+enum NextStateKind
+{
+    NextState_Same,
+    NextState_Fixed,
+    NextState_Computed
+};
+
+struct TransitionEntry
+{
+    bool valid;
+    bool stall;
+    NextStateKind nextStateKind;
+    ${ident}_State nextState;
+    // Resource checks and request types of the transition, -1 if none
+    int prologue;
+    // Actions of the transition in s_transition_actions
+    int firstAction;
+    int numActions;
+};
+
+static const TransitionEntry
+    s_transition_table[${ident}_State_NUM * ${ident}_Event_NUM];
+static const ActionFn s_transition_actions[];
+
+TransitionResult transitionPrologue(int prologue, Addr addr);
+''')
+
+        code('''
 
 // Internal functions
 ''')
@@ -553,6 +613,15 @@ namespace ruby
 int $c_ident::m_num_controllers = 0;
 std::vector<statistics::Vector *>  $c_ident::eventVec;
 std::vector<std::vector<statistics::Vector *> >  $c_ident::transVec;
+''')
+
+        if self.symtab.slicc.profile_transitions:
+            code('''
+std::vector<std::vector<statistics::Vector *> >
+    $c_ident::transHostTimeVec;
+''')
+
+        code('''
 
 // for adding information to the protocol debug trace
 std::stringstream ${ident}_transitionComment;
@@ -602,6 +671,12 @@ for (int state = 0; state < ${ident}_State_NUM; state++) {
     for (int event = 0; event < ${ident}_Event_NUM; event++) {
         m_possible[state][event] = false;
         m_counters[state][event] = 0;
+''')
+        if self.symtab.slicc.profile_transitions:
+            code('''
+        m_transition_host_ns[state][event] = 0;
+''')
+        code('''
     }
 }
 for (int event = 0; event < ${ident}_Event_NUM; event++) {
@@ -688,6 +763,31 @@ $c_ident::init()
                         comment = "Type %s default" % vtype.ident
                         code('*$vid = ${{vtype["default"]}}; // $comment')
 
+        # Let the caches and TBE tables keep the functional access index
+        # up to date. Machines that also keep state in structures the index
+        # does not track are always queried on functional accesses.
+        untracked = ("DirectoryMemory", "PerfectCacheMemory",
+                     "PersistentTable")
+        caches = [ "m_%s_ptr" % param.ident
+                   for param in self.config_parameters
+                   if param.type_ast.type.ident == "CacheMemory" ]
+        tbe_tables = [ "m_%s_ptr" % var.ident for var in self.objects
+                       if var.type.ident.endswith("TBETable") ]
+        indexable = caches and \
+            not any(param.type_ast.type.ident in untracked
+                    for param in self.config_parameters) and \
+            not any(var.type.ident in untracked for var in self.objects)
+        if indexable:
+            code()
+            code('if (FunctionalAccessIndex *index = '
+                 'registerFunctionalAccessIndex()) {')
+            code.indent()
+            for vid in caches + tbe_tables:
+                code('$vid->setFunctionalAccessIndex(index, '
+                     'm_functional_access_id);')
+            code.dedent()
+            code('}')
+
         # Set the prefetchers
         code()
         for prefetcher in self.prefetchers:
@@ -864,6 +964,32 @@ $c_ident::regStats()
                 transVec[state].push_back(t);
             }
         }
+''')
+
+        if self.symtab.slicc.profile_transitions:
+            code('''
+
+        for (${ident}_State state = ${ident}_State_FIRST;
+             state < ${ident}_State_NUM; ++state) {
+
+            transHostTimeVec.push_back(std::vector<statistics::Vector *>());
+
+            for (${ident}_Event event = ${ident}_Event_FIRST;
+                 event < ${ident}_Event_NUM; ++event) {
+                std::string stat_name = "${c_ident}." +
+                    ${ident}_State_to_string(state) +
+                    "." + ${ident}_Event_to_string(event) + ".hostSeconds";
+                statistics::Vector *t = new statistics::Vector(
+                    profilerStatsPtr, stat_name.c_str());
+                t->init(m_num_controllers);
+                t->flags(statistics::total | statistics::oneline |
+                    statistics::nozero);
+                transHostTimeVec[state].push_back(t);
+            }
+        }
+''')
+
+        code('''
     }
 
     for (${ident}_Event event = ${ident}_Event_FIRST;
@@ -946,6 +1072,16 @@ $c_ident::collateStats()
                 assert(it != rs->m_abstract_controls[MachineType_${ident}].end());
                 (*transVec[state][event])[i] =
                     (($c_ident *)(*it).second)->getTransitionCount(state, event);
+''')
+
+        if self.symtab.slicc.profile_transitions:
+            code('''
+                (*transHostTimeVec[state][event])[i] =
+                    (($c_ident *)(*it).second)->getTransitionHostSeconds(
+                        state, event);
+''')
+
+        code('''
             }
         }
     }
@@ -983,6 +1119,20 @@ $c_ident::getTransitionCount(${ident}_State state,
 {
     return m_counters[state][event];
 }
+''')
+
+        if self.symtab.slicc.profile_transitions:
+            code('''
+
+double
+$c_ident::getTransitionHostSeconds(${ident}_State state,
+                                   ${ident}_Event event)
+{
+    return m_transition_host_ns[state][event] / 1e9;
+}
+''')
+
+        code('''
 
 int
 $c_ident::getNumControllers()
@@ -1019,6 +1169,14 @@ void $c_ident::resetStats()
     for (int state = 0; state < ${ident}_State_NUM; state++) {
         for (int event = 0; event < ${ident}_Event_NUM; event++) {
             m_counters[state][event] = 0;
+''')
+
+        if self.symtab.slicc.profile_transitions:
+            code('''
+            m_transition_host_ns[state][event] = 0;
+''')
+
+        code('''
         }
     }
 
@@ -1373,6 +1531,12 @@ ${ident}_Controller::wakeup()
 // ${ident}: ${{self.short}}
 
 #include <cassert>
+''')
+
+        if self.symtab.slicc.profile_transitions:
+            code('#include <chrono>')
+
+        code('''
 
 #include "base/logging.hh"
 #include "base/trace.hh"
@@ -1427,6 +1591,12 @@ ${ident}_State next_state = state;
 DPRINTF(RubyGenerated, "%s, Time: %lld, state: %s, event: %s, addr: %#x\\n",
         *this, curCycle(), ${ident}_State_to_string(state),
         ${ident}_Event_to_string(event), addr);
+''')
+
+        if self.symtab.slicc.profile_transitions:
+            code('auto host_start = std::chrono::steady_clock::now();')
+
+        code('''
 
 TransitionResult result =
 ''')
@@ -1439,6 +1609,15 @@ TransitionResult result =
         else:
             code('doTransitionWorker(event, state, next_state, addr);')
 
+        if self.symtab.slicc.profile_transitions:
+            code('''
+if (result == TransitionResult_Valid) {
+    m_transition_host_ns[state][event] +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - host_start).count();
+}
+''')
+
         port_to_buf_map, in_msg_bufs, msg_bufs = self.getBufferMaps(ident)
 
         code('''
@@ -1513,6 +1692,26 @@ ${ident}_Controller::doTransitionWorker(${ident}_Event event,
 {
     m_curTransitionEvent = event;
     m_curTransitionNextState = next_state;
+''')
+
+        if self.symtab.slicc.dispatch == 'table':
+            self.printCTransitionTable(code)
+        else:
+            self.printCTransitionSwitch(code)
+
+        code('''
+
+} // namespace ruby
+} // namespace gem5
+''')
+        code.write(path, "%s_Transitions.cc" % self.ident)
+
+    def printCTransitionSwitch(self, code):
+        '''Output the body of doTransitionWorker as a switch statement'''
+
+        ident = self.ident
+
+        code('''
     switch(HASH_FUN(state, event)) {
 ''')
 
@@ -1622,11 +1821,189 @@ if (!checkResourceAvailable(%s_RequestType_%s, addr)) {
 
     return TransitionResult_Valid;
 }
+''')
 
-} // namespace ruby
-} // namespace gem5
+    def printCTransitionTable(self, code):
+        '''Output the body of doTransitionWorker as a lookup in a dense
+        (state, event) table of action lists'''
+
+        ident = self.ident
+        c_ident = "%s_Controller" % self.ident
+
+        if self.TBEType != None and self.EntryType != None:
+            action_args = 'm_tbe_ptr, m_cache_entry_ptr, addr'
+        elif self.TBEType != None:
+            action_args = 'm_tbe_ptr, addr'
+        elif self.EntryType != None:
+            action_args = 'm_cache_entry_ptr, addr'
+        else:
+            action_args = 'addr'
+
+        # The resource checks and request types of the transitions are
+        # emitted once per unique code sequence, and so are the action
+        # lists.
+        prologues = OrderedDict()
+        action_lists = OrderedDict()
+        num_actions = 0
+        entries = {}
+        computed_next_state = False
+
+        for trans in self.transitions:
+            prologue = self.symtab.codeFormatter()
+
+            case_sorter = []
+            for key,val in trans.resources.items():
+                case_sorter.append('''
+if (!%s.areNSlotsAvailable(%s, clockEdge()))
+    return TransitionResult_ResourceStall;
+''' % (key.code, val))
+            for request_type in trans.request_types:
+                case_sorter.append('''
+if (!checkResourceAvailable(%s_RequestType_%s, addr)) {
+    return TransitionResult_ResourceStall;
+}
+''' % (self.ident, request_type.ident))
+            for c in sorted(case_sorter):
+                prologue("$c")
+
+            for request_type in trans.request_types:
+                prologue('recordRequestType(${ident}_RequestType_'
+                         '${{request_type.ident}}, addr);')
+
+            prologue = str(prologue)
+            if not prologue:
+                prologue_id = -1
+            else:
+                if prologue not in prologues:
+                    prologues[prologue] = len(prologues)
+                prologue_id = prologues[prologue]
+
+            stall = False
+            for action in trans.actions:
+                if action.ident == "z_stall":
+                    stall = True
+                    break
+
+            actions = ()
+            if not stall:
+                actions = tuple(action.ident for action in trans.actions)
+            if actions not in action_lists:
+                action_lists[actions] = num_actions
+                num_actions += len(actions)
+
+            if trans.state == trans.nextState:
+                kind = 'NextState_Same'
+                next_state = '%s_State_NUM' % ident
+            elif trans.nextState.isWildcard():
+                kind = 'NextState_Computed'
+                next_state = '%s_State_NUM' % ident
+                computed_next_state = True
+            else:
+                kind = 'NextState_Fixed'
+                next_state = '%s_State_%s' % (ident, trans.nextState.ident)
+
+            entries[(trans.state.ident, trans.event.ident)] = \
+                (stall, kind, next_state, prologue_id,
+                 action_lists[actions], len(actions))
+
+        code('''
+
+    const TransitionEntry &trans =
+        s_transition_table[HASH_FUN(state, event)];
+    if (!trans.valid) {
+        panic("Invalid transition\\n"
+              "%s time: %d addr: %#x event: %s state: %s\\n",
+              name(), curCycle(), addr, event, state);
+    }
+
+    if (trans.nextStateKind == NextState_Fixed) {
+        next_state = trans.nextState;
+        m_curTransitionNextState = next_state;
+''')
+        if computed_next_state:
+            # The next state of a * transition is determined by the
+            # machine-specific getNextState function before any action
+            # executes.
+            code('''
+    } else if (trans.nextStateKind == NextState_Computed) {
+        next_state = getNextState(addr);
+        m_curTransitionNextState = next_state;
+''')
+        code('''
+    }
+
+    if (trans.prologue >= 0) {
+        TransitionResult result = transitionPrologue(trans.prologue, addr);
+        if (result != TransitionResult_Valid)
+            return result;
+    }
+
+    if (trans.stall)
+        return TransitionResult_ProtocolStall;
+
+    const ActionFn *action = &s_transition_actions[trans.firstAction];
+    for (int i = 0; i < trans.numActions; i++, action++) {
+        (this->*(*action))($action_args);
+    }
+
+    return TransitionResult_Valid;
+}
+
+TransitionResult
+$c_ident::transitionPrologue(int prologue, Addr addr)
+{
+    switch (prologue) {
+''')
+
+        for prologue,prologue_id in prologues.items():
+            code('  case $prologue_id:')
+            code('    $prologue')
+            code('    break;')
+
+        code('''
+      default:
+        panic("Invalid transition prologue %d\\n", prologue);
+    }
+
+    return TransitionResult_Valid;
+}
+
+const $c_ident::ActionFn $c_ident::s_transition_actions[] = {
+''')
+
+        code.indent()
+        for actions in action_lists:
+            for action in actions:
+                code('&$c_ident::$action,')
+        if num_actions == 0:
+            code('nullptr,')
+        code.dedent()
+
+        code('''
+};
+
+const $c_ident::TransitionEntry
+$c_ident::s_transition_table[${ident}_State_NUM * ${ident}_Event_NUM] = {
+''')
+
+        code.indent()
+        for state in self.states.values():
+            for event in self.events.values():
+                entry = entries.get((state.ident, event.ident))
+                if entry is None:
+                    code('{ false, false, NextState_Same, ${ident}_State_NUM, '
+                         '-1, 0, 0 },')
+                    continue
+                stall, kind, next_state, prologue_id, first, count = entry
+                stall = 'true' if stall else 'false'
+                code('// ${{state.ident}}, ${{event.ident}}')
+                code('{ true, $stall, $kind, $next_state, $prologue_id, '
+                     '$first, $count },')
+        code.dedent()
+
+        code('''
+};
 ''')
-        code.write(path, "%s_Transitions.cc" % self.ident)
 
 
     # **************************
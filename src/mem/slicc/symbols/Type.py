@@ -297,8 +297,11 @@ $klass ${{self.c_ident}}$parent
 MsgPtr
 clone() const
 {
-     return std::shared_ptr<Message>(new ${{self.c_ident}}(*this));
+     return MsgPtr(new ${{self.c_ident}}(*this));
 }
+
+// Recycle the storage of messages of this type
+GEM5_POOLED_NEW(${{self.c_ident}})
 ''')
         else:
             code('''
@@ -46,6 +46,9 @@ class Process(SimObject):
                             table in an architecture-specific format')
     kvmInSE = Param.Bool('false', 'initialize the process for KvmCPU in SE')
     maxStackSize = Param.MemorySize('64MiB', 'maximum size of the stack')
+    transparentHugePages = Param.Bool(False, 'back anonymous memory with '
+        'large pages wherever a whole aligned large page fits in a mapping')
+    hugePageSize = Param.MemorySize('2MiB', 'size of a large page')
 
     uid = Param.Int(100, 'user id')
     euid = Param.Int(100, 'effective user id')
@@ -32,6 +32,7 @@
 #include "sim/mem_pool.hh"
 
 #include "base/addr_range.hh"
+#include "base/intmath.hh"
 #include "base/logging.hh"
 
 namespace gem5
@@ -123,6 +124,14 @@ MemPool::allocate(Addr npages)
     return return_addr;
 }
 
+Addr
+MemPool::allocateAligned(Addr npages)
+{
+    // The pages skipped to get to the alignment are left unused.
+    freePageNum = roundUp(freePageNum, npages);
+    return allocate(npages);
+}
+
 void
 MemPool::serialize(CheckpointOut &cp) const
 {
@@ -154,6 +163,12 @@ MemPools::allocPhysPages(int npages, int pool_id)
     return pools[pool_id].allocate(npages);
 }
 
+Addr
+MemPools::allocAlignedPhysPages(int npages, int pool_id)
+{
+    return pools[pool_id].allocateAligned(npages);
+}
+
 Addr
 MemPools::memSize(int pool_id) const
 {
@@ -79,6 +79,9 @@ class MemPool : public Serializable
 
     Addr allocate(Addr npages);
 
+    /** Allocate npages pages starting on a multiple of npages pages. */
+    Addr allocateAligned(Addr npages);
+
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
 };
@@ -99,6 +102,11 @@ class MemPools : public Serializable
     /// @return Starting address of first page
     Addr allocPhysPages(int npages, int pool_id=0);
 
+    /// Allocate npages contiguous unused physical pages, aligned to their
+    /// total size. npages must be a power of 2.
+    /// @return Starting address of first page
+    Addr allocAlignedPhysPages(int npages, int pool_id=0);
+
     /** Amount of physical memory that exists in a pool. */
     Addr memSize(int pool_id=0) const;
 
@@ -392,6 +392,23 @@ MemState::fixupFault(Addr vaddr)
      */
     for (const auto &vma : _vmaList) {
         if (vma.contains(vaddr)) {
+            /**
+             * Like transparent huge pages, back anonymous memory with a
+             * large page when one fits entirely in the area and none of
+             * it has been touched yet.
+             */
+            auto *p_table = _ownerProcess->pTable;
+            const Addr large_bytes = p_table->largePageSize();
+            if (large_bytes && !vma.hasHostBuf()) {
+                Addr lpage_start = roundDown(vaddr, large_bytes);
+                if (vma.contains(lpage_start) &&
+                        vma.contains(lpage_start + large_bytes - 1) &&
+                        p_table->isUnmapped(lpage_start, large_bytes)) {
+                    _ownerProcess->allocateLargePage(lpage_start);
+                    return true;
+                }
+            }
+
             Addr vpage_start = roundDown(vaddr, _pageBytes);
             _ownerProcess->allocateMem(vpage_start, _pageBytes);
 
@@ -137,6 +137,9 @@ Process::Process(const ProcessParams &params, EmulationPageTable *pTable,
     fatal_if(!seWorkload, "Couldn't find appropriate workload object.");
     fatal_if(_pid >= System::maxPID, "_pid is too large: %d", _pid);
 
+    if (params.transparentHugePages)
+        pTable->setLargePageSize(params.hugePageSize);
+
     auto ret_pair = system->PIDs.emplace(_pid);
     fatal_if(!ret_pair.second, "_pid %d is already used", _pid);
 
@@ -343,6 +346,17 @@ Process::allocateMem(Addr vaddr, int64_t size, bool clobber)
                           EmulationPageTable::MappingFlags(0));
 }
 
+void
+Process::allocateLargePage(Addr vaddr)
+{
+    const Addr large_size = pTable->largePageSize();
+    assert(large_size && vaddr % large_size == 0);
+
+    const int npages = large_size / pTable->pageSize();
+    const Addr paddr = seWorkload->allocAlignedPhysPages(npages);
+    pTable->map(vaddr, paddr, large_size, EmulationPageTable::LargePage);
+}
+
 void
 Process::replicatePage(Addr vaddr, Addr new_paddr, ThreadContext *old_tc,
                        ThreadContext *new_tc, bool allocate_page)
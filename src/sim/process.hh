@@ -121,6 +121,10 @@ class Process : public SimObject
     // requested, and may configure more if necessary.
     void allocateMem(Addr vaddr, int64_t size, bool clobber=false);
 
+    // Allocate a physically aligned large page and map it at "vaddr", which
+    // has to be aligned to the large page size of the page table.
+    void allocateLargePage(Addr vaddr);
+
     /// Attempt to fix up a fault at vaddr by allocating a page on the stack.
     /// @return Whether the fault has been fixed.
     bool fixupFault(Addr vaddr);
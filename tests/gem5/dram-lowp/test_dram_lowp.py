@@ -24,6 +24,8 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+import re
+
 from testlib import *
 
 verifiers = (
@@ -49,3 +51,25 @@ gem5_verify_config(
     valid_isas=(constants.null_tag,),
     valid_hosts=constants.supported_hosts,
 )
+
+gem5_verify_config(
+    name='test-bulk_idle_refresh',
+    fixtures=(),
+    verifiers=(verifier.MatchRegex(re.compile(
+        r'Rank power and energy stats match with bulk idle refresh')),),
+    config=joinpath(config.base_dir, 'configs', 'dram', 'idle_refresh.py'),
+    config_args=[],
+    valid_isas=(constants.null_tag,),
+    valid_hosts=constants.supported_hosts,
+)
+
+gem5_verify_config(
+    name='test-mem_prefetch',
+    fixtures=(),
+    verifiers=(verifier.MatchRegex(re.compile(
+        r'Memory-side prefetch stats are consistent')),),
+    config=joinpath(config.base_dir, 'configs', 'dram', 'mem_prefetch.py'),
+    config_args=[],
+    valid_isas=(constants.null_tag,),
+    valid_hosts=constants.supported_hosts,
+)
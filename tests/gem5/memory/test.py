@@ -67,6 +67,16 @@ gem5_verify_config(
     valid_isas=(constants.null_tag,),
 )
 
+# the window is sized so that every page is read often enough per epoch
+for page_size, window in (('4KiB', '32KiB'), ('64B', '1KiB')):
+    gem5_verify_config(
+        name='tiering-' + page_size,
+        verifiers=(), # No need for verfiers this will return non-zero on fail
+        config=joinpath(getcwd(), 'tiering-run.py'),
+        config_args = ['--tier-page-size', page_size, '--window', window],
+        valid_isas=(constants.null_tag,),
+    )
+
 null_tests = [
     ('garnet_synth_traffic', None, ['--sim-cycles', '5000000']),
     ('memcheck', None, ['--maxtick', '2000000000', '--prefetchers']),
@@ -0,0 +1,111 @@
+# Copyright (c) 2025
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Page tiering test for the HeteroMemCtrl. Reads are concentrated on a
+# small window of NVM pages, which the threshold policy should promote
+# to DRAM, after which the same reads should mostly be timed by the
+# DRAM. The script exits with an error if the tiering stats do not
+# show this.
+
+import argparse
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser(description='Page tiering tester')
+parser.add_argument('--tier-page-size', default='4KiB')
+parser.add_argument('--window', default='32KiB',
+                    help='Size of the window of NVM pages that is read')
+
+args = parser.parse_args()
+
+system = System(membus = IOXBar(width = 32),
+                clk_domain = SrcClockDomain(clock = '2.0GHz',
+                                            voltage_domain =
+                                            VoltageDomain(voltage = '1V')))
+
+system.mem_ranges = [AddrRange('128MB'),
+                     AddrRange(Addr('128MB'), size = '1024MB')]
+system.mmap_using_noreserve = True
+
+system.mem_ctrl = HeteroMemCtrl(
+    dram = DDR4_2400_16x4(range = system.mem_ranges[0], null = True),
+    nvm = NVM_2400_1x64(range = system.mem_ranges[1], null = True),
+    tiering_policy = 'threshold',
+    tier_page_size = args.tier_page_size,
+    tiering_epoch = '10us',
+    migration_threshold = 4,
+    max_migrations_per_epoch = 64)
+system.mem_ctrl.port = system.membus.mem_side_ports
+
+system.tgen = PyTrafficGen()
+system.tgen.port = system.membus.cpu_side_ports
+
+system.system_port = system.membus.cpu_side_ports
+
+root = Root(full_system = False, system = system)
+root.system.mem_mode = 'timing'
+
+m5.instantiate()
+
+nvm_start = int(system.mem_ranges[1].start)
+window = int(Addr(args.window))
+phase_time = 200000000
+period = 20000
+
+def traffic(tgen):
+    # first warm the window up, the pages get promoted on the way, then
+    # read the same window again, now mostly from DRAM
+    for _ in range(2):
+        yield tgen.createLinear(phase_time, nvm_start,
+                                nvm_start + window - 1, 64, period, period,
+                                100, 0)
+    yield tgen.createExit(0)
+
+def stat(name):
+    return system.mem_ctrl.resolveStat('tiering.' + name).value
+
+system.tgen.start(traffic(system.tgen))
+m5.simulate(phase_time)
+
+promotions = stat('promotions')
+if promotions == 0:
+    m5.fatal("No NVM page was promoted")
+if stat('demotions') != promotions:
+    m5.fatal("Every promotion should demote a DRAM page")
+if stat('migrationBytes') != 2 * promotions * \
+   int(Addr(args.tier_page_size)):
+    m5.fatal("Migrated bytes do not match the number of swaps")
+
+m5.stats.reset()
+m5.simulate()
+
+fast = stat('fastTierReqs')
+slow = stat('slowTierReqs')
+print("Promoted %d pages, %d requests timed by DRAM, %d by NVM" %
+      (promotions, fast, slow))
+if fast <= slow:
+    m5.fatal("Reads to the promoted pages are not timed by DRAM")